@@ -0,0 +1,39 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_BENCHMARKS_ALLOCATION_COUNTER_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_BENCHMARKS_ALLOCATION_COUNTER_HPP
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+namespace Information_Model::testing {
+
+/**
+ * @brief Counts the heap allocations made by the benchmark runner, through a
+ * replaced global operator new
+ *
+ */
+struct AllocationCounter {
+  /**
+   * @brief Starts counting from the current allocation totals
+   *
+   */
+  AllocationCounter();
+
+  size_t allocations() const;
+
+  size_t bytes() const;
+
+  /**
+   * @brief Reports the allocations and allocated bytes per benchmark iteration
+   * as counters of the given benchmark state
+   *
+   * @param state
+   */
+  void report(benchmark::State& state) const;
+
+private:
+  size_t allocations_;
+  size_t bytes_;
+};
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_BENCHMARKS_ALLOCATION_COUNTER_HPP
@@ -0,0 +1,226 @@
+#include "AllocationCounter.hpp"
+#include "MockBuilder.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <fstream>
+#include <unistd.h>
+#endif
+
+namespace Information_Model::testing {
+using namespace std;
+
+constexpr size_t REFERENCE_GROUP_SIZE = 1000;
+
+// Resident set size in bytes, 0 if it can not be determined
+size_t residentSetSize() {
+#ifdef __linux__
+  ifstream statm("/proc/self/statm");
+  size_t total_pages = 0;
+  size_t resident_pages = 0;
+  if (statm >> total_pages >> resident_pages) {
+    return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  }
+#endif
+  return 0;
+}
+
+// Builds a device with groups of 1000 readables each
+unique_ptr<Device> buildReferenceDevice(bool use_arena, size_t size) {
+  MockBuilder builder;
+  if (use_arena) {
+    builder.enableArena(64 * MockBuilder::DEFAULT_ARENA_SIZE);
+  }
+  builder.setDeviceInfo("reference_device", BuildInfo{"Reference"});
+  for (size_t group_count = 0;
+       group_count < size / REFERENCE_GROUP_SIZE;
+       ++group_count) {
+    auto group_id = builder.addGroup(BuildInfo{"Group"});
+    for (size_t count = 0; count < REFERENCE_GROUP_SIZE; ++count) {
+      builder.addReadable(group_id, BuildInfo{"Readable"}, DataType::Boolean);
+    }
+  }
+  return builder.result();
+}
+
+void buildDevice(benchmark::State& state) {
+  auto use_arena = state.range(0) != 0;
+  auto size = static_cast<size_t>(state.range(1));
+  AllocationCounter counter;
+  size_t rss_growth = 0;
+  for (auto _ : state) {
+    auto rss_before = residentSetSize();
+    auto device = buildReferenceDevice(use_arena, size);
+    // freed pages may be reused, so the resident set size can also shrink
+    rss_growth += max(residentSetSize(), rss_before) - rss_before;
+    state.PauseTiming();
+    device.reset();
+    state.ResumeTiming();
+  }
+  counter.report(state);
+  state.counters["rss_growth"] = benchmark::Counter(
+      static_cast<double>(rss_growth), benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(size));
+  state.SetLabel(use_arena ? "arena" : "heap");
+}
+BENCHMARK(buildDevice)
+    ->ArgsProduct({{0, 1}, {1000, 5000}})
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+
+// gmock unregisters each destroyed mock by scanning the registry of all live
+// mocks, so teardown time grows quadratically with the device size
+void teardownDevice(benchmark::State& state) {
+  auto use_arena = state.range(0) != 0;
+  auto size = static_cast<size_t>(state.range(1));
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto device = buildReferenceDevice(use_arena, size);
+    state.ResumeTiming();
+    device.reset();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(size));
+  state.SetLabel(use_arena ? "arena" : "heap");
+}
+BENCHMARK(teardownDevice)
+    ->ArgsProduct({{0, 1}, {1000, 5000}})
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+
+constexpr size_t BULK_SIZE = 5000;
+
+void addReadablesOneByOne(benchmark::State& state) {
+  AllocationCounter counter;
+  for (auto _ : state) {
+    MockBuilder builder;
+    builder.setDeviceInfo("bulk_device", BuildInfo{"Bulk"});
+    auto group_id = builder.addGroup(BuildInfo{"Group"});
+    for (size_t count = 0; count < BULK_SIZE; ++count) {
+      builder.addReadable(group_id, BuildInfo{"Readable"}, DataType::Boolean);
+    }
+    state.PauseTiming();
+    builder.result().reset();
+    state.ResumeTiming();
+  }
+  counter.report(state);
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(BULK_SIZE));
+}
+BENCHMARK(addReadablesOneByOne)->Iterations(3)->Unit(benchmark::kMillisecond);
+
+void addReadablesInBulk(benchmark::State& state) {
+  vector<MockBuilder::ElementDescriptor> descriptors(BULK_SIZE,
+      {ElementType::Readable, BuildInfo{"Readable"}, DataType::Boolean});
+  AllocationCounter counter;
+  for (auto _ : state) {
+    MockBuilder builder;
+    builder.setDeviceInfo("bulk_device", BuildInfo{"Bulk"});
+    auto group_id = builder.addGroup(BuildInfo{"Group"});
+    builder.addElements(group_id, descriptors);
+    state.PauseTiming();
+    builder.result().reset();
+    state.ResumeTiming();
+  }
+  counter.report(state);
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(BULK_SIZE));
+}
+BENCHMARK(addReadablesInBulk)->Iterations(3)->Unit(benchmark::kMillisecond);
+
+void addReadablesLazily(benchmark::State& state) {
+  auto size = static_cast<size_t>(state.range(0));
+  vector<MockBuilder::ElementDescriptor> descriptors(
+      size, {ElementType::Readable, BuildInfo{"Readable"}, DataType::Boolean});
+  AllocationCounter counter;
+  for (auto _ : state) {
+    MockBuilder builder;
+    builder.enableLazyElements();
+    builder.setDeviceInfo("lazy_device", BuildInfo{"Lazy"});
+    auto group_id = builder.addGroup(BuildInfo{"Group"});
+    builder.addElements(group_id, descriptors);
+    state.PauseTiming();
+    builder.result().reset();
+    state.ResumeTiming();
+  }
+  counter.report(state);
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(size));
+}
+BENCHMARK(addReadablesLazily)
+    ->Arg(BULK_SIZE)
+    ->Arg(1000000)
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+
+constexpr size_t PROTOTYPE_GROUPS = 10;
+
+// Builds PROTOTYPE_GROUPS groups of REFERENCE_GROUP_SIZE / PROTOTYPE_GROUPS
+// readables each, one element at a time
+void buildPrototypeDevice(MockBuilder& builder, const string& id) {
+  builder.setDeviceInfo(id, BuildInfo{"Prototype"});
+  for (size_t group = 0; group < PROTOTYPE_GROUPS; ++group) {
+    auto group_id = builder.addGroup(BuildInfo{"Group"});
+    for (size_t i = 0; i < REFERENCE_GROUP_SIZE / PROTOTYPE_GROUPS; ++i) {
+      builder.addReadable(group_id, BuildInfo{"Readable"}, DataVariant(true));
+    }
+  }
+}
+
+void rebuildDevice(benchmark::State& state) {
+  for (auto _ : state) {
+    MockBuilder builder;
+    buildPrototypeDevice(builder, "rebuilt_device");
+    auto device = builder.result();
+    state.PauseTiming();
+    device.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(rebuildDevice)->Iterations(3)->Unit(benchmark::kMillisecond);
+
+void clonePrototypeDevice(benchmark::State& state) {
+  MockBuilder builder;
+  builder.enablePrototypeRecording();
+  buildPrototypeDevice(builder, "prototype_device");
+  auto prototype = builder.resultPrototype();
+  for (auto _ : state) {
+    auto device = prototype->clone("cloned_device");
+    state.PauseTiming();
+    device.reset();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(clonePrototypeDevice)->Iterations(3)->Unit(benchmark::kMillisecond);
+
+// Only measures result(), which validates that no group is empty
+void resultWithManyGroups(benchmark::State& state) {
+  auto groups = static_cast<size_t>(state.range(0));
+  vector<MockBuilder::ElementDescriptor> descriptors(
+      1, {ElementType::Readable, BuildInfo{"Readable"}, DataType::Boolean});
+  for (auto _ : state) {
+    state.PauseTiming();
+    MockBuilder builder;
+    builder.enableLazyElements();
+    builder.setDeviceInfo("grouped_device", BuildInfo{"Grouped"});
+    for (size_t group = 0; group < groups; ++group) {
+      builder.addElements(builder.addGroup(BuildInfo{"Group"}), descriptors);
+    }
+    state.ResumeTiming();
+    auto device = builder.result();
+    state.PauseTiming();
+    device.reset();
+    state.ResumeTiming();
+  }
+}
+BENCHMARK(resultWithManyGroups)
+    ->Arg(20000)
+    ->Iterations(3)
+    ->Unit(benchmark::kMicrosecond);
+} // namespace Information_Model::testing
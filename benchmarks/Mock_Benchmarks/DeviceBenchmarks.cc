@@ -0,0 +1,62 @@
+#include "DeviceMock.hpp"
+#include "ElementMock.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+struct SensorDevice {
+  explicit SensorDevice(size_t observable_count) {
+    values.reserve(observable_count);
+    for (size_t i = 0; i < observable_count; ++i) {
+      auto observable = make_shared<NiceMock<ObservableMock>>(DataType::Double);
+      observable->enableSubscribeFaking([](bool) {});
+      observers.push_back(observable->subscribe(
+          [](const shared_ptr<DataVariant>& value) {
+            benchmark::DoNotOptimize(value.get());
+          },
+          [](const exception_ptr&) {}));
+      auto id = device->generateID();
+      device->addElement(make_shared<NiceMock<ElementMock>>(observable, id));
+      observables.push_back(observable);
+      values.emplace_back(id, DataVariant(static_cast<double>(i)));
+    }
+  }
+
+  DeviceMockPtr device = make_shared<NiceMock<DeviceMock>>("sensor_device");
+  vector<ObservableMockPtr> observables;
+  vector<ObserverPtr> observers;
+  vector<pair<string, DataVariant>> values;
+};
+
+// Reference point, notifies each observable of a sample in turn
+void notifyEachObservable(benchmark::State& state) {
+  SensorDevice sensors(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    for (size_t i = 0; i < sensors.observables.size(); ++i) {
+      sensors.observables[i]->notify(sensors.values[i].second);
+    }
+  }
+  state.counters["ticks"] =
+      benchmark::Counter(static_cast<double>(state.iterations()),
+          benchmark::Counter::kIsRate);
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(notifyEachObservable)->RangeMultiplier(4)->Range(1024, 16384);
+
+void tickDevice(benchmark::State& state) {
+  SensorDevice sensors(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    sensors.device->tick(sensors.values);
+  }
+  state.counters["ticks"] =
+      benchmark::Counter(static_cast<double>(state.iterations()),
+          benchmark::Counter::kIsRate);
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(tickDevice)->RangeMultiplier(4)->Range(1024, 16384);
+} // namespace Information_Model::testing
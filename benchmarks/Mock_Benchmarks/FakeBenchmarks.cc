@@ -0,0 +1,58 @@
+#include "ElementFake.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+// Shared between all benchmark threads, so concurrent reads hit the same
+// instance, as they would when a whole fleet reads the same device
+template <class ReadableType> struct SharedReadable {
+  static shared_ptr<ReadableType> instance() {
+    static auto readable =
+        make_shared<ReadableType>(DataVariant(intmax_t{42}));
+    return readable;
+  }
+};
+
+void readMock(benchmark::State& state) {
+  auto tested = SharedReadable<NiceMock<ReadableMock>>::instance();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tested->read());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(readMock)->ThreadRange(1, 16)->UseRealTime();
+
+void readFake(benchmark::State& state) {
+  auto tested = SharedReadable<ReadableFake>::instance();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tested->read());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(readFake)->ThreadRange(1, 16)->UseRealTime();
+
+void readElementMockName(benchmark::State& state) {
+  auto tested = make_shared<NiceMock<ElementMock>>(
+      SharedReadable<ReadableFake>::instance(),
+      "base_id:0",
+      FullMetaInfo{"element_name", "element_desc"});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tested->name());
+  }
+}
+BENCHMARK(readElementMockName);
+
+void readElementFakeName(benchmark::State& state) {
+  auto tested = make_shared<ElementFake>(
+      SharedReadable<ReadableFake>::instance(),
+      "base_id:0",
+      FullMetaInfo{"element_name", "element_desc"});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tested->name());
+  }
+}
+BENCHMARK(readElementFakeName);
+} // namespace Information_Model::testing
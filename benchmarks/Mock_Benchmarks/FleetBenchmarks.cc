@@ -0,0 +1,54 @@
+#include "FleetGenerator.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace Information_Model::testing {
+using namespace std;
+
+FleetShape benchmarkFleet() {
+  FleetShape shape;
+  shape.device_count = 20;
+  shape.elements_per_group = 50;
+  shape.group_fan_out = 3;
+  shape.depth = 1;
+  shape.element_mix = ElementMix{4, 2, 3, 1};
+  shape.data_type_mix = {
+      {DataType::Boolean, 1}, {DataType::Integer, 1}, {DataType::Double, 2}};
+  return shape;
+}
+
+void reportThroughput(benchmark::State& state, const FleetGenerator& generator) {
+  state.counters["generator_elements_per_second"] =
+      generator.report().elementsPerSecond();
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(generator.report().elements));
+}
+
+void generateFleetSerially(benchmark::State& state) {
+  FleetGenerator generator(benchmarkFleet());
+  for (auto _ : state) {
+    auto devices = generator.generate();
+    state.PauseTiming();
+    devices.clear();
+    state.ResumeTiming();
+  }
+  reportThroughput(state, generator);
+}
+BENCHMARK(generateFleetSerially)->Iterations(3)->Unit(benchmark::kMillisecond);
+
+void generateFleetInParallel(benchmark::State& state) {
+  FleetGenerator generator(benchmarkFleet());
+  WorkerPool pool;
+  for (auto _ : state) {
+    auto devices = generator.generate(pool);
+    state.PauseTiming();
+    devices.clear();
+    state.ResumeTiming();
+  }
+  reportThroughput(state, generator);
+  state.SetLabel(to_string(pool.size() + 1) + " threads");
+}
+BENCHMARK(generateFleetInParallel)
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+} // namespace Information_Model::testing
@@ -0,0 +1,182 @@
+#include "AllocationCounter.hpp"
+#include "DeviceMock.hpp"
+#include "ElementMock.hpp"
+#include "WorkerPool.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+constexpr size_t ELEMENTS_PER_GROUP = 16;
+
+// Builds a device with a chain of nested groups, each holding a few readables
+struct NestedDevice {
+  explicit NestedDevice(size_t depth) {
+    auto readable = make_shared<NiceMock<ReadableMock>>(DataType::Boolean);
+    function<string()> generate_id = [this]() {
+      return device->generateID();
+    };
+    function<void(const ElementPtr&)> add = [this](const ElementPtr& element) {
+      device->addElement(element);
+    };
+    for (size_t level = 0; level < depth; ++level) {
+      for (size_t i = 0; i < ELEMENTS_PER_GROUP; ++i) {
+        auto id = generate_id();
+        add(make_shared<NiceMock<ElementMock>>(readable, id));
+        ids.push_back(id);
+      }
+      auto group_id = generate_id();
+      auto group = make_shared<NiceMock<GroupMock>>(group_id);
+      add(make_shared<NiceMock<ElementMock>>(group, group_id));
+      generate_id = [group]() { return group->generateID(); };
+      add = [group](const ElementPtr& element) { group->addElement(element); };
+    }
+    deepest_id = ids.back();
+  }
+
+  DeviceMockPtr device = make_shared<NiceMock<DeviceMock>>("nested_device");
+  vector<string> ids;
+  string deepest_id;
+};
+
+void lookupDeepestElement(benchmark::State& state) {
+  NestedDevice nested(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(nested.device->element(nested.deepest_id));
+  }
+  state.counters["depth"] = static_cast<double>(state.range(0));
+}
+BENCHMARK(lookupDeepestElement)->DenseRange(1, 10);
+
+void lookupEachElement(benchmark::State& state) {
+  NestedDevice nested(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    for (const auto& id : nested.ids) {
+      benchmark::DoNotOptimize(nested.device->element(id));
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(nested.ids.size()));
+  state.counters["depth"] = static_cast<double>(state.range(0));
+}
+BENCHMARK(lookupEachElement)->DenseRange(1, 10);
+
+constexpr size_t LARGE_GROUP_SIZE = 10000;
+
+GroupMockPtr makeLargeGroup() {
+  auto group = make_shared<NiceMock<GroupMock>>("large_group:");
+  auto readable = make_shared<NiceMock<ReadableMock>>(DataType::Boolean);
+  for (size_t i = 0; i < LARGE_GROUP_SIZE; ++i) {
+    group->addElement(
+        make_shared<NiceMock<ElementMock>>(readable, group->generateID()));
+  }
+  return group;
+}
+
+// Copies the cached snapshot, as required by the Group interface
+void groupAsMap(benchmark::State& state) {
+  auto group = makeLargeGroup();
+  AllocationCounter counter;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(group->asMap());
+  }
+  counter.report(state);
+}
+BENCHMARK(groupAsMap);
+
+void groupMapSnapshot(benchmark::State& state) {
+  auto group = makeLargeGroup();
+  AllocationCounter counter;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(group->mapSnapshot());
+  }
+  counter.report(state);
+}
+BENCHMARK(groupMapSnapshot);
+
+void groupAsVector(benchmark::State& state) {
+  auto group = makeLargeGroup();
+  AllocationCounter counter;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(group->asVector());
+  }
+  counter.report(state);
+}
+BENCHMARK(groupAsVector);
+
+void groupVectorSnapshot(benchmark::State& state) {
+  auto group = makeLargeGroup();
+  AllocationCounter counter;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(group->vectorSnapshot());
+  }
+  counter.report(state);
+}
+BENCHMARK(groupVectorSnapshot);
+
+constexpr size_t WIDE_GROUP_COUNT = 100;
+
+// Builds a device with 100 groups of 1000 readables each, shared by the visit
+// benchmarks, since building it takes a while
+const DeviceMock& wideDevice() {
+  static const auto device = []() {
+    auto wide = make_shared<NiceMock<DeviceMock>>("wide_device");
+    auto readable = make_shared<NiceMock<ReadableMock>>(DataType::Boolean);
+    for (size_t i = 0; i < WIDE_GROUP_COUNT; ++i) {
+      auto group_id = wide->generateID();
+      auto group = make_shared<NiceMock<GroupMock>>(group_id);
+      wide->addElement(make_shared<NiceMock<ElementMock>>(group, group_id));
+      for (size_t j = 0; j < LARGE_GROUP_SIZE / 10; ++j) {
+        group->addElement(
+            make_shared<NiceMock<ElementMock>>(readable, group->generateID()));
+      }
+    }
+    return wide;
+  }();
+  return *device;
+}
+
+// Stands in for an expensive per element validation check
+void validate(const ElementPtr& element) {
+  auto checksum = reinterpret_cast<uintptr_t>(element.get());
+  for (size_t i = 0; i < 1000; ++i) {
+    checksum = checksum * 31 + i;
+  }
+  benchmark::DoNotOptimize(checksum);
+}
+
+void visitSerially(benchmark::State& state) {
+  const auto& device = wideDevice();
+  function<void(const ElementPtr&)> visit_nested =
+      [&visit_nested](const ElementPtr& element) {
+        validate(element);
+        if (element->type() == ElementType::Group) {
+          get<GroupPtr>(element->function())->visit(visit_nested);
+        }
+      };
+  for (auto _ : state) {
+    device.visit(visit_nested);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(WIDE_GROUP_COUNT * (LARGE_GROUP_SIZE / 10 + 1)));
+}
+BENCHMARK(visitSerially)->Unit(benchmark::kMillisecond);
+
+void visitInParallel(benchmark::State& state) {
+  const auto& device = wideDevice();
+  WorkerPool pool;
+  auto order = static_cast<VisitOrder>(state.range(0));
+  for (auto _ : state) {
+    device.parallelVisit(pool, &validate, order);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(WIDE_GROUP_COUNT * (LARGE_GROUP_SIZE / 10 + 1)));
+  state.SetLabel(order == VisitOrder::Ordered ? "ordered" : "unordered");
+}
+BENCHMARK(visitInParallel)
+    ->Arg(static_cast<int64_t>(VisitOrder::Unordered))
+    ->Arg(static_cast<int64_t>(VisitOrder::Ordered))
+    ->Unit(benchmark::kMillisecond);
+} // namespace Information_Model::testing
@@ -0,0 +1,128 @@
+#include "ObservableMock.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+constexpr size_t OBSERVER_COUNT = 4;
+
+struct ObservedMock {
+  ObservedMock() {
+    tested->enableSubscribeFaking([](bool) {});
+    for (size_t i = 0; i < OBSERVER_COUNT; ++i) {
+      observers.push_back(tested->subscribe(
+          [](const shared_ptr<DataVariant>& value) {
+            benchmark::DoNotOptimize(value.get());
+          },
+          [](const exception_ptr&) {}));
+    }
+  }
+
+  ObservableMockPtr tested =
+      make_shared<NiceMock<ObservableMock>>(DataType::Opaque);
+  vector<ObserverPtr> observers;
+};
+
+DataVariant makePayload(size_t size) {
+  return vector<uint8_t>(size, 0xAB); // NOLINT(readability-magic-numbers)
+}
+
+// Reference point, allocates and deep copies a new payload for each notify
+void notifyFreshCopy(benchmark::State& state) {
+  auto payload = makePayload(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto value_ptr = make_shared<DataVariant>(payload);
+    benchmark::DoNotOptimize(value_ptr.get());
+  }
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(notifyFreshCopy)->RangeMultiplier(8)->Range(8, 1 << 20);
+
+void notifyPooledCopy(benchmark::State& state) {
+  ObservedMock observed;
+  auto payload = makePayload(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    observed.tested->notify(payload);
+  }
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(notifyPooledCopy)->RangeMultiplier(8)->Range(8, 1 << 20);
+
+void notifyPooledMove(benchmark::State& state) {
+  ObservedMock observed;
+  auto size = static_cast<size_t>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto payload = makePayload(size);
+    state.ResumeTiming();
+    observed.tested->notify(move(payload));
+  }
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(notifyPooledMove)->RangeMultiplier(8)->Range(8, 1 << 20);
+
+// Scales the fan-out of a single notification to many observers, that each
+// do a small amount of work, from 1 to 64 threads
+void notifyParallel(benchmark::State& state) {
+  constexpr size_t PARALLEL_OBSERVER_COUNT = 4096;
+  constexpr size_t WORK_PER_OBSERVER = 256;
+
+  auto threads = static_cast<size_t>(state.range(0));
+  auto tested = make_shared<NiceMock<ObservableMock>>(DataType::Opaque);
+  tested->enableSubscribeFaking([](bool) {});
+  tested->enableParallelDispatch(make_shared<WorkerPool>(threads - 1));
+  vector<ObserverPtr> observers;
+  for (size_t i = 0; i < PARALLEL_OBSERVER_COUNT; ++i) {
+    observers.push_back(tested->subscribe(
+        [](const shared_ptr<DataVariant>& value) {
+          const auto& bytes = get<vector<uint8_t>>(*value);
+          size_t checksum = 0;
+          for (size_t j = 0; j < WORK_PER_OBSERVER; ++j) {
+            checksum += bytes[j % bytes.size()] * j;
+          }
+          benchmark::DoNotOptimize(checksum);
+        },
+        [](const exception_ptr&) {}));
+  }
+
+  auto payload = makePayload(WORK_PER_OBSERVER);
+  for (auto _ : state) {
+    tested->notify(payload);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(PARALLEL_OBSERVER_COUNT));
+  state.counters["threads"] = static_cast<double>(threads);
+}
+BENCHMARK(notifyParallel)->RangeMultiplier(2)->Range(1, 64)->UseRealTime();
+
+// Notifies a slowly drifting value to observers with an absolute deadband,
+// so only about every range(0)-th notification is dispatched
+void notifyDeadbandFiltered(benchmark::State& state) {
+  auto tested = make_shared<NiceMock<ObservableMock>>(DataType::Double);
+  NotificationFilter filter;
+  filter.absolute_deadband = static_cast<double>(state.range(0));
+  size_t dispatched = 0;
+  vector<ObserverPtr> observers;
+  for (size_t i = 0; i < OBSERVER_COUNT; ++i) {
+    observers.push_back(tested->subscribe(
+        [&dispatched](const shared_ptr<DataVariant>&) { ++dispatched; },
+        [](const exception_ptr&) {},
+        filter));
+  }
+
+  double value = 0;
+  for (auto _ : state) {
+    tested->notify(DataVariant(value));
+    value += 1;
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  state.counters["dispatched"] = benchmark::Counter(
+      static_cast<double>(dispatched), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(notifyDeadbandFiltered)->RangeMultiplier(10)->Range(1, 1000);
+} // namespace Information_Model::testing
@@ -0,0 +1,74 @@
+#include "DeviceSchema.hpp"
+#include "MockBuilder.hpp"
+
+#include <benchmark/benchmark.h>
+
+namespace Information_Model::testing {
+using namespace std;
+
+constexpr auto FIXTURE_SCHEMA = schema::device("Fixture",
+    "Fixed fixture layout",
+    schema::readable<DataType::Double>("Temperature", "", 21.5),
+    schema::writable<DataType::String>("Label", "", "fixture"),
+    schema::group("Settings",
+        "",
+        schema::writable<DataType::Integer>("Interval", "", 1000),
+        schema::writable<DataType::Boolean>("Enabled", "", true),
+        schema::group("Limits",
+            "",
+            schema::readable<DataType::Double>("Lower", "", -40.0),
+            schema::readable<DataType::Double>("Upper", "", 85.0))),
+    schema::observable<DataType::Double>("Humidity"),
+    schema::callable<DataType::String>("Reset"));
+
+// Builds the same layout as FIXTURE_SCHEMA
+unique_ptr<Device> buildFixtureDevice() {
+  MockBuilder builder;
+  builder.setDeviceInfo(
+      "fixture", BuildInfo{"Fixture", "Fixed fixture layout"});
+  builder.addReadable(BuildInfo{"Temperature"}, DataVariant(21.5));
+  builder.addWritable(BuildInfo{"Label"}, DataVariant(string("fixture")));
+  auto settings = builder.addGroup(BuildInfo{"Settings"});
+  builder.addWritable(
+      settings, BuildInfo{"Interval"}, DataVariant(intmax_t{1000}));
+  builder.addWritable(settings, BuildInfo{"Enabled"}, DataVariant(true));
+  auto limits = builder.addGroup(settings, BuildInfo{"Limits"});
+  builder.addReadable(limits, BuildInfo{"Lower"}, DataVariant(-40.0));
+  builder.addReadable(limits, BuildInfo{"Upper"}, DataVariant(85.0));
+  builder.addObservable(
+      BuildInfo{"Humidity"}, DataType::Double, [](bool) {});
+  builder.addCallable(BuildInfo{"Reset"}, DataType::String);
+  return builder.result();
+}
+
+void buildFixtureWithBuilder(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(buildFixtureDevice());
+  }
+}
+BENCHMARK(buildFixtureWithBuilder);
+
+void buildFixtureFromSchema(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FIXTURE_SCHEMA.build("fixture"));
+  }
+}
+BENCHMARK(buildFixtureFromSchema);
+
+void lookupFixtureElementById(benchmark::State& state) {
+  auto device = buildFixtureDevice();
+  string id = "fixture:2.2.1";
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(device->element(id));
+  }
+}
+BENCHMARK(lookupFixtureElementById);
+
+void lookupFixtureElementByPath(benchmark::State& state) {
+  auto built = FIXTURE_SCHEMA.build("fixture");
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(built.element<2, 2, 1>());
+  }
+}
+BENCHMARK(lookupFixtureElementByPath);
+} // namespace Information_Model::testing
@@ -0,0 +1,50 @@
+#include "DeviceSnapshot.hpp"
+#include "MockBuilder.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+
+namespace Information_Model::testing {
+using namespace std;
+
+constexpr size_t SNAPSHOT_GROUP_SIZE = 1000;
+
+// Writes a device with groups of 1000 readables each into a new snapshot
+string writeSnapshot(size_t size) {
+  auto path = (filesystem::temp_directory_path() /
+      ("benchmark_" + to_string(size) + ".snapshot"))
+                  .string();
+  MockBuilder builder;
+  builder.enableLazyElements();
+  builder.setDeviceInfo("snapshot_device", BuildInfo{"Snapshot"});
+  vector<MockBuilder::ElementDescriptor> descriptors(SNAPSHOT_GROUP_SIZE,
+      {ElementType::Readable, BuildInfo{"Readable"}, DataType::Double,
+          DataVariant(21.5)});
+  for (size_t group = 0; group < size / SNAPSHOT_GROUP_SIZE; ++group) {
+    builder.addElements(builder.addGroup(BuildInfo{"Group"}), descriptors);
+  }
+  DeviceSnapshot::write(*builder.result(), path);
+  return path;
+}
+
+void loadSnapshot(benchmark::State& state) {
+  auto size = static_cast<size_t>(state.range(0));
+  auto path = writeSnapshot(size);
+  for (auto _ : state) {
+    DeviceSnapshot snapshot(path);
+    auto device = snapshot.load();
+    state.PauseTiming();
+    device.reset();
+    state.ResumeTiming();
+  }
+  filesystem::remove(path);
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(size));
+}
+BENCHMARK(loadSnapshot)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+} // namespace Information_Model::testing
@@ -0,0 +1,67 @@
+#include "DeviceSpecLoader.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+
+namespace Information_Model::testing {
+using namespace std;
+
+constexpr size_t SPEC_GROUP_SIZE = 1000;
+
+// Describes each element separately, in groups of 1000 readables each
+string makeSpec(size_t size) {
+  string spec = R"({"id": "spec_device", "name": "Spec", "elements": [)";
+  for (size_t group = 0; group < size / SPEC_GROUP_SIZE; ++group) {
+    spec += group == 0 ? "" : ",";
+    spec += R"({"type": "Group", "name": "Group", "elements": [)";
+    for (size_t element = 0; element < SPEC_GROUP_SIZE; ++element) {
+      spec += element == 0 ? "" : ",";
+      spec += R"({"type": "Readable", "name": "Readable", )"
+              R"("data_type": "Double", "value": 21.5})";
+    }
+    spec += "]}";
+  }
+  spec += "]}";
+  return spec;
+}
+
+void loadSpec(benchmark::State& state) {
+  auto lazy = state.range(0) != 0;
+  auto size = static_cast<size_t>(state.range(1));
+  auto spec = makeSpec(size);
+  chrono::nanoseconds parse_duration{0};
+  chrono::nanoseconds build_duration{0};
+  for (auto _ : state) {
+    auto builder = make_shared<MockBuilder>();
+    if (lazy) {
+      builder->enableLazyElements();
+    }
+    DeviceSpecLoader loader(builder);
+    istringstream stream(spec);
+    auto device = loader.load(stream);
+    parse_duration += loader.report().parse_duration;
+    build_duration += loader.report().build_duration;
+    state.PauseTiming();
+    device.reset();
+    state.ResumeTiming();
+  }
+  state.counters["parse_ms"] =
+      benchmark::Counter(static_cast<double>(parse_duration.count()) / 1e6,
+          benchmark::Counter::kAvgIterations);
+  state.counters["build_ms"] =
+      benchmark::Counter(static_cast<double>(build_duration.count()) / 1e6,
+          benchmark::Counter::kAvgIterations);
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+      static_cast<int64_t>(spec.size()));
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(size));
+  state.SetLabel(lazy ? "lazy" : "eager");
+}
+BENCHMARK(loadSpec)
+    ->Args({0, 5000})
+    ->Args({1, 5000})
+    ->Args({1, 100000})
+    ->Iterations(3)
+    ->Unit(benchmark::kMillisecond);
+} // namespace Information_Model::testing
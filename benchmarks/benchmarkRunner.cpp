@@ -0,0 +1,19 @@
+#include <benchmark/benchmark.h>
+#include <iostream>
+
+using namespace std;
+
+int main(int argc, char** argv) {
+  cout << "Setting up the Google Benchmark Framework" << endl;
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+
+  cout << "Running benchmarks" << endl;
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  cout << "Benchmarks finished" << endl;
+
+  return 0;
+}
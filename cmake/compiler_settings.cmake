@@ -26,6 +26,12 @@ if ("${CMAKE_CXX_COMPILER_ID}" STREQUAL "Clang" OR "${CMAKE_CXX_COMPILER_ID}" ST
        add_compile_options(-fstack-protector-strong)
     endif ()
 
+    if(${THREAD_SANITIZER})
+       # Detect data races at run-time. Slows down the tests considerably.
+       add_compile_options(-fsanitize=thread -g)
+       add_link_options(-fsanitize=thread)
+    endif ()
+
     # Force retention of null pointer checks
     add_compile_options(-fno-delete-null-pointer-checks)
     # Do not assume strict aliasing
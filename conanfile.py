@@ -79,7 +79,7 @@ class PackageConan(ConanFile):
 
     def build_requirements(self):
         # @+ START USER BUILD REQUIREMENTS
-        pass
+        self.test_requires("benchmark/[~1.9]")
         # @- END USER BUILD REQUIREMENTS
 
     def configure(self):
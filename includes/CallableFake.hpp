@@ -0,0 +1,98 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_CALLABLE_FAKE_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_CALLABLE_FAKE_HPP
+#include "CallableMock.hpp"
+#include "FakeExecutor.hpp"
+
+namespace Information_Model::testing {
+
+/**
+ * @brief Plain Callable implementation without any gmock machinery
+ *
+ * Behaves like a NiceMock<CallableMock> with the same constructor arguments,
+ * see @ref ReadableFake for the differences
+ *
+ */
+struct CallableFake : public Callable {
+  using ExecuteCallback = CallableMock::ExecuteCallback;
+  using AsyncExecuteCallback = CallableMock::AsyncExecuteCallback;
+  using CancelCallback = CallableMock::CancelCallback;
+
+  CallableFake() = default;
+
+  explicit CallableFake(const ExecutorPtr& executor);
+
+  explicit CallableFake(DataType result_type,
+      const ParameterTypes& supported_params = {},
+      const Executor::Response& default_response = std::make_exception_ptr(
+          std::logic_error("Default response exception")));
+
+  explicit CallableFake(const ExecuteCallback& execute_cb,
+      const ParameterTypes& supported_params = {});
+
+  CallableFake(DataType result_type, const ExecuteCallback& execute_cb,
+      const AsyncExecuteCallback& async_execute_cb,
+      const CancelCallback& cancel_cb,
+      const ParameterTypes& supported_params = {});
+
+  ~CallableFake() override = default;
+
+  void execute(const Parameters& parameters) const final;
+
+  DataVariant call(uintmax_t timeout) const final;
+
+  DataVariant call(const Parameters& parameters, uintmax_t timeout) const final;
+
+  ResultFuture asyncCall(const Parameters& parameters) const final;
+
+  void cancelAsyncCall(uintmax_t call_id) const final;
+
+  DataType resultType() const final;
+
+  ParameterTypes parameterTypes() const final;
+
+  /**
+   * @brief Same as @ref CallableMock::getExecutor()
+   *
+   * @return ExecutorPtr
+   */
+  ExecutorPtr getExecutor() const;
+
+  /**
+   * @brief Same as @ref CallableMock::changeExecutor()
+   *
+   * @param executor
+   */
+  void changeExecutor(const ExecutorPtr& executor);
+
+  /**
+   * @brief Same as @ref CallableMock::useDefaultExecutor()
+   *
+   */
+  void useDefaultExecutor();
+
+  /**
+   * @brief Same as @ref CallableMock::useDefaultCallbacks()
+   *
+   */
+  void useDefaultCallbacks();
+
+private:
+  // throws ExecutorNotAvailable if neither an executor nor callbacks are used
+  void checkAvailable() const;
+
+  // throws ResultReturningNotSupported for callbacks without a result type
+  void checkReturning() const;
+
+  DataType result_type_ = DataType::None;
+  ExecuteCallback execute_cb_;
+  AsyncExecuteCallback async_execute_cb_;
+  CancelCallback cancel_cb_;
+  ParameterTypes supported_params_;
+  Executor::Response default_response_;
+  ExecutorPtr executor_;
+  bool use_callbacks_ = false;
+};
+
+using CallableFakePtr = std::shared_ptr<CallableFake>;
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_CALLABLE_FAKE_HPP
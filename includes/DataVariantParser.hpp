@@ -0,0 +1,29 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_DATA_VARIANT_PARSER_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_DATA_VARIANT_PARSER_HPP
+
+#include <Information_Model/DataVariant.hpp>
+
+#include <string_view>
+
+namespace Information_Model::testing {
+
+/**
+ * @brief Parses the textual representation of a given data type value
+ *
+ * Values are expected as:
+ *  - Boolean as true, false, 1 or 0
+ *  - Integer, Unsigned_Integer and Double as decimal numbers
+ *  - Timestamp as YYYY-MM-DDTHH:MM:SS.ffffff
+ *  - Opaque as hex encoded bytes
+ *  - String as is
+ *
+ * @throws std::invalid_argument - if the text is not a valid value of the
+ * given data type, or if the data type has no values
+ *
+ * @param text
+ * @param type
+ * @return DataVariant
+ */
+DataVariant parseDataVariant(std::string_view text, DataType type);
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_DATA_VARIANT_PARSER_HPP
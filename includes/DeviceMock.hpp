@@ -3,9 +3,17 @@
 #define __STAG_INFORMATION_MODEL_MOCKS_DEVICE_MOCK_HPP
 #include "GroupMock.hpp"
 #include "MetaInfoMock.hpp"
+#include "ObservableFake.hpp"
+#include "ObservableMock.hpp"
 
 #include <Information_Model/Device.hpp>
 #include <gmock/gmock.h>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace Information_Model::testing {
 
@@ -45,8 +53,149 @@ struct DeviceMock : virtual public Device, public MetaInfoMock {
    */
   void addElement(const ElementPtr& element);
 
+  /**
+   * @brief Generates the given number of consecutive root element IDs, same as
+   * @ref GroupMock::generateIDs()
+   *
+   * @param count
+   * @return std::vector<std::string>
+   */
+  std::vector<std::string> generateIDs(size_t count);
+
+  /**
+   * @brief Adds multiple root elements at once, same as
+   * @ref GroupMock::addElements()
+   *
+   * @throws std::invalid_argument - same as @ref GroupMock::addElements()
+   * @throws std::logic_error - same as @ref GroupMock::addElements()
+   *
+   * @param ids
+   * @param elements
+   */
+  void addElements(const std::vector<std::string>& ids,
+      const std::vector<ElementPtr>& elements);
+
+  /**
+   * @brief Creates and adds multiple root elements at once, same as
+   * @ref GroupMock::addElements(size_t, const GroupMock::ElementFactory&)
+   *
+   * @throws std::invalid_argument - same as @ref GroupMock::addElements()
+   * @throws std::logic_error - same as @ref GroupMock::addElements()
+   *
+   * @param count
+   * @param factory
+   * @return size_t
+   */
+  size_t addElements(size_t count, const GroupMock::ElementFactory& factory);
+
+  /**
+   * @brief Adds multiple root elements, that are created on first access,
+   * same as @ref GroupMock::addLazyElements()
+   *
+   * @throws std::invalid_argument - same as @ref GroupMock::addLazyElements()
+   * @throws std::logic_error - same as @ref GroupMock::addLazyElements()
+   *
+   * @param count
+   * @param factory
+   * @return size_t
+   */
+  size_t addLazyElements(
+      size_t count, const GroupMock::ElementFactory& factory);
+
+  /**
+   * @brief Enables or disables notification latency tracking for every
+   * ObservableMock and ObservableFake, that is part of this Device, including
+   * the ones within nested groups
+   *
+   * Same as @ref ObservableMock::enableLatencyTracking()
+   *
+   * @param enable
+   */
+  void enableLatencyTracking(bool enable);
+
+  /**
+   * @brief Exports the tracked notification latencies of every ObservableMock
+   * and ObservableFake, that is part of this Device, keyed by the element ID
+   *
+   * Same as @ref ObservableMock::latencies()
+   *
+   * @return std::unordered_map<std::string, std::vector<ObserverLatency>>
+   */
+  std::unordered_map<std::string, std::vector<ObserverLatency>>
+  notificationLatencies() const;
+
+  /**
+   * @brief Publishes a set of values, that were sampled at the same instant,
+   * to the ObservableMock or ObservableFake elements with the given IDs in one
+   * synchronized step
+   *
+   * Resolved elements are cached, so repeated ticks do not
+   * search the element tree again. Every ID is resolved before any value is
+   * published, so a tick with an invalid ID publishes nothing
+   *
+   * Same as @ref notifyTogether() otherwise
+   *
+   * @throws ElementNotFound - if an element with a given ID does not exist
+   * @throws std::invalid_argument - if a given element is not an
+   * ObservableMock or ObservableFake
+   *
+   * @param values - element ID and value pairs
+   */
+  void tick(const std::vector<std::pair<std::string, DataVariant>>& values);
+
+  /**
+   * @brief Same as @ref tick(const std::vector<std::pair<std::string,
+   * DataVariant>>&), but moves the given values into the notification payloads
+   * instead of copying them
+   *
+   * @param values - element ID and value pairs
+   */
+  void tick(std::vector<std::pair<std::string, DataVariant>>&& values);
+
+  /**
+   * @brief Visits every element of this device in parallel, same as
+   * @ref GroupMock::parallelVisit()
+   *
+   * @param pool
+   * @param visitor
+   * @param order
+   */
+  void parallelVisit(WorkerPool& pool,
+      const Group::Visitor& visitor,
+      VisitOrder order = VisitOrder::Unordered) const;
+
+  /**
+   * @brief Visits every element of this device in parallel and hands each
+   * element its ID path, same as @ref GroupMock::parallelVisit()
+   *
+   * @param pool
+   * @param visitor
+   * @param order
+   */
+  void parallelVisit(WorkerPool& pool,
+      const GroupMock::PathVisitor& visitor,
+      VisitOrder order = VisitOrder::Unordered) const;
+
 private:
+  friend struct TraceReplayer;
+
+  // observers of ObservableMock and ObservableFake instances, nullptr for
+  // other Observable implementations
+  static ObserverRegistryPtr observers(const ObservablePtr& observable);
+
+  static void visitObservers(const GroupPtr& group,
+      const std::function<void(const std::string&, ObserverRegistry&)>&
+          visitor);
+
+  const ObserverRegistryPtr& tickTarget(const std::string& ref_id);
+
+  // requires tick_mx_ to be held
+  void publishTickBatch();
+
   GroupMockPtr group_;
+  std::mutex tick_mx_;
+  std::unordered_map<std::string, ObserverRegistryPtr> tick_targets_;
+  std::vector<std::pair<ObserverRegistryPtr, DataVariant>> tick_batch_;
 };
 using DeviceMockPtr = std::shared_ptr<DeviceMock>;
 } // namespace Information_Model::testing
@@ -0,0 +1,108 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_DEVICE_PROTOTYPE_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_DEVICE_PROTOTYPE_HPP
+#include "MockArena.hpp"
+
+#include <Information_Model/Device.hpp>
+#include <Information_Model/DeviceBuilder.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Information_Model::testing {
+
+/**
+ * @brief Immutable topology of a device built by the MockBuilder, that can be
+ * cloned into independent Device mocks with different base IDs
+ *
+ * A prototype holds the meta information of each element and a factory for
+ * its functional mock. Cloning skips all of the builder validation and ID
+ * bookkeeping, it only creates the group mocks right away. Every other
+ * element of a clone is created on first access, as described by
+ * @ref GroupMock::addLazyElements(), so a clone only allocates the mock state
+ * of the elements a test actually uses
+ *
+ * @attention Callbacks and executors given to the MockBuilder are shared by
+ * the prototype and all of its clones. NotifyCallbacks returned by
+ * MockBuilder::addObservable() only notify the observables of the built
+ * device, use ObservableMock::notify() for clones instead
+ *
+ */
+struct DevicePrototype {
+  /**
+   * @brief Creates a new functional mock within the given arena
+   *
+   */
+  using FunctionFactory = std::function<ElementFunction(const MockArenaPtr&)>;
+
+  /**
+   * @brief Creates an independent Device mock with the prototype topology.
+   * Element IDs of the clone only differ from the prototype element IDs by
+   * their base ID
+   *
+   * @param base_id
+   * @return std::unique_ptr<Device>
+   */
+  std::unique_ptr<Device> clone(const std::string& base_id) const;
+
+  /**
+   * @brief Returns the base ID of the device, the prototype was recorded from
+   *
+   * @return const std::string&
+   */
+  const std::string& id() const;
+
+  /**
+   * @brief Returns the number of elements of each clone, including groups
+   *
+   * @return size_t
+   */
+  size_t size() const;
+
+private:
+  friend struct MockBuilder;
+
+  static constexpr size_t NO_GROUP = std::numeric_limits<size_t>::max();
+
+  struct Entry {
+    BuildInfo info;
+    // empty for group elements
+    FunctionFactory factory;
+    // index of the prototype group for group elements
+    size_t group = NO_GROUP;
+  };
+
+  using Entries = std::vector<Entry>;
+
+  DevicePrototype(const std::string& base_id,
+      const BuildInfo& info,
+      std::optional<size_t> arena_size,
+      bool fakes);
+
+  /**
+   * @brief Appends a new element to the given group
+   *
+   * @return size_t - index of the added group, if a group was added
+   */
+  size_t add(size_t group, const BuildInfo& info, FunctionFactory factory);
+
+  template <class Target>
+  void cloneGroup(
+      Target& target, size_t group, const MockArenaPtr& arena) const;
+
+  std::string id_;
+  BuildInfo info_;
+  std::optional<size_t> arena_size_;
+  // clones wrap their functions into ElementFake instances
+  bool fakes_;
+  // root group first, clones share the entries with their lazy elements
+  std::vector<std::shared_ptr<Entries>> groups_;
+};
+
+using DevicePrototypePtr = std::shared_ptr<const DevicePrototype>;
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_DEVICE_PROTOTYPE_HPP
@@ -0,0 +1,605 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_DEVICE_SCHEMA_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_DEVICE_SCHEMA_HPP
+#include "CallableMock.hpp"
+#include "DeviceMock.hpp"
+#include "ElementMock.hpp"
+#include "GroupMock.hpp"
+#include "IdPath.hpp"
+#include "ObservableMock.hpp"
+#include "ReadableMock.hpp"
+#include "WritableMock.hpp"
+
+#include <gmock/gmock.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Information_Model::testing {
+
+/**
+ * @brief Compile-time device layout DSL
+ *
+ * Fixed device layouts are described with constexpr element specs, for
+ * example:
+ *
+ * @code
+ * constexpr auto sensor = schema::device("Sensor", "Example sensor",
+ *     schema::readable<DataType::Double>("Temperature", "", 21.5),
+ *     schema::group("Settings", "",
+ *         schema::writable<DataType::String>("Label", "", "kitchen")));
+ *
+ * auto built = sensor.build("sensor");
+ * auto label = built.function<1, 0>(); // WritableMockPtr of "sensor:1.0"
+ * @endcode
+ *
+ * Element positions, IDs and mock types are resolved from the schema type, so
+ * element lookups by a statically known path are plain array accesses. Default
+ * values, that do not match the element data type, empty groups and out of
+ * range paths fail to compile
+ *
+ */
+namespace schema {
+
+/**
+ * @brief Name and description of a schema element
+ *
+ */
+struct Info {
+  std::string_view name;
+  std::string_view description;
+};
+
+/**
+ * @brief Marks data types, that can not have compile-time default values
+ *
+ */
+struct NoValue {};
+
+template <DataType Type> struct ValueOf { using type = NoValue; };
+template <> struct ValueOf<DataType::Boolean> { using type = bool; };
+template <> struct ValueOf<DataType::Integer> { using type = intmax_t; };
+template <> struct ValueOf<DataType::Unsigned_Integer> {
+  using type = uintmax_t;
+};
+template <> struct ValueOf<DataType::Double> { using type = double; };
+template <> struct ValueOf<DataType::String> { using type = std::string_view; };
+
+/**
+ * @brief Checks if a value of a given type can be a default value of a given
+ * data type. Integral values are accepted for both integer data types, but
+ * booleans, floating point numbers and strings are never converted
+ *
+ * @tparam Type
+ * @tparam Value
+ * @return true
+ * @return false
+ */
+template <DataType Type, class Value> constexpr bool isValueOf() {
+  using Decayed = std::decay_t<Value>;
+  constexpr bool is_integer =
+      std::is_integral_v<Decayed> && !std::is_same_v<Decayed, bool> &&
+      !std::is_same_v<Decayed, char>;
+  if constexpr (Type == DataType::Boolean) {
+    return std::is_same_v<Decayed, bool>;
+  } else if constexpr (Type == DataType::Integer ||
+      Type == DataType::Unsigned_Integer) {
+    return is_integer;
+  } else if constexpr (Type == DataType::Double) {
+    return std::is_floating_point_v<Decayed>;
+  } else if constexpr (Type == DataType::String) {
+    return std::is_convertible_v<Value, std::string_view>;
+  } else {
+    return false;
+  }
+}
+
+template <class Value> DataVariant toVariant(Value value) {
+  if constexpr (std::is_same_v<Value, std::string_view>) {
+    return DataVariant(std::string(value));
+  } else {
+    return DataVariant(value);
+  }
+}
+
+template <ElementType Kind> struct MockOf;
+template <> struct MockOf<ElementType::Readable> { using type = ReadableMock; };
+template <> struct MockOf<ElementType::Writable> { using type = WritableMock; };
+template <> struct MockOf<ElementType::Observable> {
+  using type = ObservableMock;
+};
+template <> struct MockOf<ElementType::Callable> { using type = CallableMock; };
+template <> struct MockOf<ElementType::Group> { using type = GroupMock; };
+
+/**
+ * @brief Describes a Readable, Writable, Observable or Callable element
+ *
+ * @tparam Kind - element type
+ * @tparam Type - data type, or result type for Callable elements
+ */
+template <ElementType Kind, DataType Type> struct FunctionSpec {
+  static_assert(Type != DataType::None && Type != DataType::Unknown,
+      "Data Type can not be None or Unknown");
+
+  static constexpr ElementType element_type = Kind;
+  static constexpr DataType data_type = Type;
+  using Mock = typename MockOf<Kind>::type;
+  using Value = typename ValueOf<Type>::type;
+
+  Info info;
+  std::optional<Value> default_value = std::nullopt;
+
+  std::shared_ptr<Mock> makeFunction(const std::string&) const {
+    if constexpr (Kind == ElementType::Callable) {
+      return std::make_shared<::testing::NiceMock<Mock>>(
+          Type, ParameterTypes{});
+    } else {
+      if constexpr (!std::is_same_v<Value, NoValue>) {
+        if (default_value.has_value()) {
+          return std::make_shared<::testing::NiceMock<Mock>>(
+              toVariant(*default_value));
+        }
+      }
+      return std::make_shared<::testing::NiceMock<Mock>>(Type);
+    }
+  }
+};
+
+template <class... Children> struct GroupSpec;
+
+template <class Spec> struct IsSpec : std::false_type {};
+template <ElementType Kind, DataType Type>
+struct IsSpec<FunctionSpec<Kind, Type>> : std::true_type {};
+template <class... Children>
+struct IsSpec<GroupSpec<Children...>> : std::true_type {};
+
+/**
+ * @brief Number of elements a spec builds, including itself and all of its
+ * nested elements
+ *
+ */
+template <class Spec> struct Count : std::integral_constant<size_t, 1> {};
+template <class... Children>
+struct Count<GroupSpec<Children...>>
+    : std::integral_constant<size_t, (Count<Children>::value + ... + 1)> {};
+
+/**
+ * @brief Position of the element built by the child at a given position,
+ * relative to the first element built by the first child. Elements are
+ * numbered depth first, each group comes right before its nested elements
+ *
+ */
+template <size_t Position, class... Children> constexpr size_t offsetOf() {
+  constexpr size_t counts[] = {Count<Children>::value..., 0};
+  size_t offset = 0;
+  for (size_t child = 0; child < Position; ++child) {
+    offset += counts[child];
+  }
+  return offset;
+}
+
+/**
+ * @brief Describes a group and its nested elements
+ *
+ */
+template <class... Children> struct GroupSpec {
+  static_assert(sizeof...(Children) > 0, "Groups can not be empty");
+  static_assert((IsSpec<Children>::value && ...),
+      "Group elements must be built with schema functions");
+
+  static constexpr ElementType element_type = ElementType::Group;
+  using Mock = GroupMock;
+
+  Info info;
+  std::tuple<Children...> children;
+
+  std::shared_ptr<Mock> makeFunction(const std::string& id) const {
+    return std::make_shared<::testing::NiceMock<Mock>>(id);
+  }
+};
+
+/**
+ * @brief Resolves a statically known element path into the spec of the
+ * element and its depth first position
+ *
+ */
+template <class Group, size_t... Path> struct Locate;
+
+template <class... Children, size_t Head>
+struct Locate<std::tuple<Children...>, Head> {
+  static_assert(Head < sizeof...(Children), "Element path is out of range");
+
+  using Spec = std::tuple_element_t<Head, std::tuple<Children...>>;
+  static constexpr size_t position = offsetOf<Head, Children...>();
+};
+
+template <class... Children, size_t Head, size_t Next, size_t... Tail>
+struct Locate<std::tuple<Children...>, Head, Next, Tail...> {
+  static_assert(Head < sizeof...(Children), "Element path is out of range");
+
+  using Parent = std::tuple_element_t<Head, std::tuple<Children...>>;
+  static_assert(Parent::element_type == ElementType::Group,
+      "Element path goes through an element, that is not a group");
+
+  using Nested = Locate<decltype(Parent::children), Next, Tail...>;
+  using Spec = typename Nested::Spec;
+  static constexpr size_t position =
+      offsetOf<Head, Children...>() + 1 + Nested::position;
+};
+
+constexpr size_t digitCount(size_t number) {
+  size_t digits = 1;
+  while (number >= 10) {
+    number /= 10;
+    ++digits;
+  }
+  return digits;
+}
+
+template <size_t... Path>
+constexpr size_t localIdLength =
+    (digitCount(Path) + ... + 0) + sizeof...(Path) - 1;
+
+template <size_t... Path>
+constexpr std::array<char, localIdLength<Path...>> localIdChars() {
+  std::array<char, localIdLength<Path...>> result{};
+  size_t end = 0;
+  for (size_t index : {Path...}) {
+    if (end != 0) {
+      result[end++] = IdPath::SEGMENT_SEPARATOR;
+    }
+    end += digitCount(index);
+    auto digit = end;
+    do {
+      result[--digit] = static_cast<char>('0' + index % 10);
+      index /= 10;
+    } while (index != 0);
+  }
+  return result;
+}
+
+/**
+ * @brief Local ID of a statically known element path, for example 1.0 for the
+ * first element of the second root element
+ *
+ */
+template <size_t... Path> struct LocalId {
+  static_assert(sizeof...(Path) > 0, "Element path can not be empty");
+
+  static constexpr std::array<char, localIdLength<Path...>> value =
+      localIdChars<Path...>();
+
+  static constexpr std::string_view str() {
+    return std::string_view(value.data(), value.size());
+  }
+};
+
+template <class Spec> struct FunctionsOf {
+  using type = std::tuple<std::shared_ptr<typename Spec::Mock>>;
+};
+template <class... Children> struct FunctionsOf<GroupSpec<Children...>> {
+  using type = decltype(std::tuple_cat(
+      std::declval<std::tuple<GroupMockPtr>>(),
+      std::declval<typename FunctionsOf<Children>::type>()...));
+};
+
+template <class Schema> struct BuiltDevice;
+
+/**
+ * @brief Describes a whole device
+ *
+ */
+template <class... Children> struct DeviceSpec {
+  static_assert(sizeof...(Children) > 0, "Devices can not be empty");
+  static_assert((IsSpec<Children>::value && ...),
+      "Device elements must be built with schema functions");
+
+  /**
+   * @brief Number of elements, including groups and nested elements
+   *
+   */
+  static constexpr size_t size = (Count<Children>::value + ... + 0);
+
+  /**
+   * @brief Mock pointers of every element function, in depth first order
+   *
+   */
+  using Functions = decltype(std::tuple_cat(
+      std::declval<typename FunctionsOf<Children>::type>()...));
+
+  /**
+   * @brief Spec of the element at a given path
+   *
+   */
+  template <size_t... Path>
+  using SpecAt = typename Locate<std::tuple<Children...>, Path...>::Spec;
+
+  /**
+   * @brief Depth first position of the element at a given path, that built
+   * devices store the element at
+   *
+   */
+  template <size_t... Path> static constexpr size_t position() {
+    return Locate<std::tuple<Children...>, Path...>::position;
+  }
+
+  /**
+   * @brief Local element ID of a given path, without the base ID
+   *
+   */
+  template <size_t... Path> static constexpr std::string_view localId() {
+    return LocalId<Path...>::str();
+  }
+
+  /**
+   * @brief Builds a new Device mock with the described layout
+   *
+   * Element IDs are generated by the device and its groups, same as for
+   * devices built with the MockBuilder. None of the builder validation or ID
+   * bookkeeping is repeated at runtime
+   *
+   * @param base_id
+   * @return BuiltDevice<DeviceSpec>
+   */
+  BuiltDevice<DeviceSpec> build(const std::string& base_id) const {
+    return BuiltDevice<DeviceSpec>(*this, base_id);
+  }
+
+  Info info;
+  std::tuple<Children...> children;
+};
+
+/**
+ * @brief Device mock built from a DeviceSpec, that gives constant time access
+ * to each of its elements by their statically known path
+ *
+ * @tparam Schema
+ */
+template <class Schema> struct BuiltDevice {
+  /**
+   * @brief Returns the built device
+   *
+   * @return const DeviceMockPtr&
+   */
+  const DeviceMockPtr& device() const { return device_; }
+
+  /**
+   * @brief Returns the element at a given path, for example element<1, 0>()
+   * for the element with the local ID 1.0
+   *
+   * @return const ElementPtr&
+   */
+  template <size_t... Path> const ElementPtr& element() const {
+    return elements_[Schema::template position<Path...>()];
+  }
+
+  /**
+   * @brief Returns the functional mock of the element at a given path, with
+   * the mock type of its spec, for example WritableMockPtr for writable specs
+   *
+   */
+  template <size_t... Path> const auto& function() const {
+    return std::get<Schema::template position<Path...>()>(functions_);
+  }
+
+  /**
+   * @brief Returns the full ID of the element at a given path
+   *
+   * @return std::string
+   */
+  template <size_t... Path> std::string id() const {
+    return base_id_ + IdPath::DEVICE_SEPARATOR +
+        std::string(Schema::template localId<Path...>());
+  }
+
+private:
+  friend Schema;
+
+  BuiltDevice(const Schema& schema, const std::string& base_id)
+      : base_id_(base_id) {
+    device_ = std::make_shared<::testing::NiceMock<DeviceMock>>(base_id,
+        FullMetaInfo{std::string(schema.info.name),
+            std::string(schema.info.description)});
+    addChildren<0>(*device_, schema.children);
+  }
+
+  template <size_t Offset, class Target, class... Children>
+  void addChildren(Target& target, const std::tuple<Children...>& children) {
+    addChildren<Offset>(
+        target, children, std::index_sequence_for<Children...>{});
+  }
+
+  // parents are added before their nested elements, same as in MockBuilder.
+  // Consecutive non-group children are added in bulk, groups are added one by
+  // one, so they share the element index of the device
+  template <size_t Offset, class Target, class... Children, size_t... Positions>
+  void addChildren(Target& target, const std::tuple<Children...>& children,
+      std::index_sequence<Positions...>) {
+    auto ids = target.generateIDs(sizeof...(Children));
+    std::vector<std::string> bulk_ids;
+    std::vector<ElementPtr> bulk;
+    (addChild<Offset + offsetOf<Positions, Children...>()>(target,
+         std::get<Positions>(children),
+         ids[Positions],
+         bulk_ids,
+         bulk),
+        ...);
+    flushChildren(target, bulk_ids, bulk);
+    (addNested<Offset + offsetOf<Positions, Children...>()>(
+         std::get<Positions>(children)),
+        ...);
+  }
+
+  template <class Target>
+  static void flushChildren(Target& target, std::vector<std::string>& ids,
+      std::vector<ElementPtr>& elements) {
+    if (!elements.empty()) {
+      target.addElements(ids, elements);
+      ids.clear();
+      elements.clear();
+    }
+  }
+
+  template <size_t Position, class Target, class Spec>
+  void addChild(Target& target, const Spec& spec, const std::string& id,
+      std::vector<std::string>& bulk_ids, std::vector<ElementPtr>& bulk) {
+    auto function = spec.makeFunction(id);
+    std::get<Position>(functions_) = function;
+    ElementFunction element_function = function;
+    elements_[Position] = std::make_shared<::testing::NiceMock<ElementMock>>(
+        element_function,
+        id,
+        FullMetaInfo{
+            std::string(spec.info.name), std::string(spec.info.description)});
+    if constexpr (Spec::element_type == ElementType::Group) {
+      // keeps the insertion order of the preceding children
+      flushChildren(target, bulk_ids, bulk);
+      target.addElement(elements_[Position]);
+    } else {
+      bulk_ids.push_back(id);
+      bulk.push_back(elements_[Position]);
+    }
+  }
+
+  template <size_t Position, class Spec> void addNested(const Spec& spec) {
+    if constexpr (Spec::element_type == ElementType::Group) {
+      addChildren<Position + 1>(*std::get<Position>(functions_), spec.children);
+    }
+  }
+
+  std::string base_id_;
+  DeviceMockPtr device_;
+  std::array<ElementPtr, Schema::size> elements_;
+  typename Schema::Functions functions_;
+};
+
+template <ElementType Kind, DataType Type>
+constexpr FunctionSpec<Kind, Type> makeSpec(
+    std::string_view name, std::string_view description) {
+  return FunctionSpec<Kind, Type>{Info{name, description}};
+}
+
+template <ElementType Kind, DataType Type, class Value>
+constexpr FunctionSpec<Kind, Type> makeSpec(
+    std::string_view name, std::string_view description, Value value) {
+  using Stored = typename ValueOf<Type>::type;
+  static_assert(!std::is_same_v<Stored, NoValue>,
+      "Data Type does not support compile-time default values");
+  static_assert(isValueOf<Type, Value>(),
+      "Default value does not match the element Data Type");
+  if constexpr (Type == DataType::Unsigned_Integer && std::is_signed_v<Value>) {
+    if (value < 0) {
+      throw std::invalid_argument(
+          "Unsigned_Integer default value can not be negative");
+    }
+  }
+  return FunctionSpec<Kind, Type>{
+      Info{name, description}, std::optional<Stored>(Stored(value))};
+}
+
+/**
+ * @brief Describes a Readable element with the default value of its data type
+ *
+ */
+template <DataType Type>
+constexpr auto readable(
+    std::string_view name, std::string_view description = "") {
+  return makeSpec<ElementType::Readable, Type>(name, description);
+}
+
+/**
+ * @brief Describes a Readable element, that always returns the given value
+ *
+ */
+template <DataType Type, class Value>
+constexpr auto readable(
+    std::string_view name, std::string_view description, Value value) {
+  return makeSpec<ElementType::Readable, Type>(name, description, value);
+}
+
+/**
+ * @brief Describes a write-only Writable element
+ *
+ */
+template <DataType Type>
+constexpr auto writable(
+    std::string_view name, std::string_view description = "") {
+  return makeSpec<ElementType::Writable, Type>(name, description);
+}
+
+/**
+ * @brief Describes a read-and-writable element, that always returns the given
+ * value
+ *
+ */
+template <DataType Type, class Value>
+constexpr auto writable(
+    std::string_view name, std::string_view description, Value value) {
+  return makeSpec<ElementType::Writable, Type>(name, description, value);
+}
+
+/**
+ * @brief Describes an Observable element with the default value of its data
+ * type
+ *
+ */
+template <DataType Type>
+constexpr auto observable(
+    std::string_view name, std::string_view description = "") {
+  return makeSpec<ElementType::Observable, Type>(name, description);
+}
+
+/**
+ * @brief Describes an Observable element, that always returns the given value
+ * on read() calls
+ *
+ */
+template <DataType Type, class Value>
+constexpr auto observable(
+    std::string_view name, std::string_view description, Value value) {
+  return makeSpec<ElementType::Observable, Type>(name, description, value);
+}
+
+/**
+ * @brief Describes a Callable element, that uses the internal executor
+ *
+ */
+template <DataType ResultType>
+constexpr auto callable(
+    std::string_view name, std::string_view description = "") {
+  return makeSpec<ElementType::Callable, ResultType>(name, description);
+}
+
+/**
+ * @brief Describes a group with the given nested elements
+ *
+ */
+template <class... Children>
+constexpr GroupSpec<Children...> group(
+    std::string_view name, std::string_view description, Children... children) {
+  return GroupSpec<Children...>{
+      Info{name, description}, std::tuple<Children...>(children...)};
+}
+
+/**
+ * @brief Describes a device with the given root elements
+ *
+ */
+template <class... Children>
+constexpr DeviceSpec<Children...> device(
+    std::string_view name, std::string_view description, Children... children) {
+  return DeviceSpec<Children...>{
+      Info{name, description}, std::tuple<Children...>(children...)};
+}
+} // namespace schema
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_DEVICE_SCHEMA_HPP
@@ -0,0 +1,118 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_DEVICE_SNAPSHOT_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_DEVICE_SNAPSHOT_HPP
+
+#include <Information_Model/Device.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace Information_Model::testing {
+
+struct MalformedSnapshot : public std::runtime_error {
+  MalformedSnapshot(const std::string& snapshot_path,
+      size_t position,
+      const std::string& reason)
+      : std::runtime_error("Malformed snapshot " + snapshot_path +
+            " at byte " + std::to_string(position) + ": " + reason) {}
+};
+
+/**
+ * @brief Memory-mapped binary snapshot of a device topology, that loads
+ * Device mocks without going through the MockBuilder
+ *
+ * Snapshots hold the meta information of the device and each of its
+ * elements, element types, data types and the values elements returned when
+ * the snapshot was written. Callable elements keep their result and parameter
+ * types. Callbacks and executors can not be stored, loaded elements behave as
+ * if they were built from a data type or a default value
+ *
+ * The snapshot is indexed once, when it is opened. Loaded devices create
+ * their groups right away and every other element on first access, as
+ * described by @ref GroupMock::addLazyElements(), by decoding it straight from
+ * the mapped snapshot. Loaded devices keep the mapping alive
+ *
+ * Snapshots start with the STAGSNP1 magic bytes, followed by the device ID,
+ * name and description, the total number of elements as uint32 and the root
+ * group. Groups hold their element count as uint32, followed by their
+ * elements. Each element holds its uint8 ElementType, name and description,
+ * followed by:
+ *  - the group content for Group elements
+ *  - the uint8 DataType and the uint8 value kind (0 - none, 1 - value,
+ *    2 - write only) followed by the value for Readable, Writable and
+ *    Observable elements
+ *  - the uint8 result DataType and the uint32 parameter count, followed by
+ *    the uint64 index, uint8 DataType and uint8 mandatory flag of each
+ *    parameter for Callable elements
+ *
+ * Strings are prefixed with their uint32 length. Values are encoded the same
+ * way as in binary traces, see @ref BinaryTraceWriter. Element IDs are not
+ * stored, they are given by each element position. All numbers are stored in
+ * host byte order
+ *
+ */
+struct DeviceSnapshot {
+  /**
+   * @brief Writes the topology of a given device into a new snapshot file
+   *
+   * Elements, that were not created yet, are created in the process
+   *
+   * @throws std::invalid_argument - if the snapshot file can not be created,
+   * or if element IDs are not consecutive numbers within their group, as
+   * assigned by the MockBuilder
+   *
+   * @param device
+   * @param snapshot_path
+   */
+  static void write(const Device& device, const std::string& snapshot_path);
+
+  /**
+   * @brief Maps a given snapshot file and indexes its elements
+   *
+   * @throws std::invalid_argument - if the snapshot file can not be opened
+   * @throws MalformedSnapshot - if the snapshot file is malformed
+   *
+   * @param snapshot_path
+   */
+  explicit DeviceSnapshot(const std::string& snapshot_path);
+
+  ~DeviceSnapshot();
+
+  /**
+   * @brief Creates a new Device mock with the snapshot device ID
+   *
+   * @return std::unique_ptr<Device>
+   */
+  std::unique_ptr<Device> load() const;
+
+  /**
+   * @brief Creates a new Device mock with a given base ID. Element IDs only
+   * differ from the snapshot element IDs by their base ID
+   *
+   * @param base_id
+   * @return std::unique_ptr<Device>
+   */
+  std::unique_ptr<Device> load(const std::string& base_id) const;
+
+  /**
+   * @brief Returns the ID of the device, the snapshot was written from
+   *
+   * @return const std::string&
+   */
+  const std::string& id() const;
+
+  /**
+   * @brief Returns the number of elements of each loaded device, including
+   * groups
+   *
+   * @return size_t
+   */
+  size_t size() const;
+
+private:
+  struct Pimpl;
+  // shared with the lazy elements of loaded devices
+  std::shared_ptr<const Pimpl> pimpl_;
+};
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_DEVICE_SNAPSHOT_HPP
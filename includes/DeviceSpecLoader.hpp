@@ -0,0 +1,144 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_DEVICE_SPEC_LOADER_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_DEVICE_SPEC_LOADER_HPP
+#include "MockBuilder.hpp"
+
+#include <Information_Model/Device.hpp>
+
+#include <chrono>
+#include <istream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace Information_Model::testing {
+
+struct MalformedSpec : public std::runtime_error {
+  MalformedSpec(
+      const std::string& source, size_t position, const std::string& reason)
+      : std::runtime_error("Malformed device spec " + source + " at byte " +
+            std::to_string(position) + ": " + reason) {}
+};
+
+/**
+ * @brief Summary of a single DeviceSpecLoader::load() run
+ *
+ */
+struct SpecLoadReport {
+  /**
+   * @brief Number of built elements, including groups
+   *
+   */
+  size_t elements = 0;
+  /**
+   * @brief Time spent reading and parsing the spec
+   *
+   */
+  std::chrono::nanoseconds parse_duration = std::chrono::nanoseconds::zero();
+  /**
+   * @brief Time spent within MockBuilder calls
+   *
+   */
+  std::chrono::nanoseconds build_duration = std::chrono::nanoseconds::zero();
+};
+
+/**
+ * @brief Builds Device mocks from JSON device specs
+ *
+ * Specs are parsed in a single streaming pass with a fixed size read buffer,
+ * consecutive elements of the same group are handed over to
+ * MockBuilder::addElements() in batches. A spec describes a single device:
+ *
+ * @code{.json}
+ * {
+ *   "id": "gateway",
+ *   "name": "Gateway",
+ *   "description": "Field bus gateway",
+ *   "latency_profiles": {"fieldbus": 250},
+ *   "elements": [
+ *     {"type": "Readable", "name": "Temperature", "data_type": "Double",
+ *      "value": 21.5, "latency": "fieldbus"},
+ *     {"type": "Group", "name": "Points", "elements": [
+ *       {"type": "Observable", "name": "Point", "data_type": "Integer",
+ *        "count": 1000, "latency_us": 10}
+ *     ]}
+ *   ]
+ * }
+ * @endcode
+ *
+ * Element objects have the following members:
+ *  - type - Group, Readable, Writable, Observable or Callable, required
+ *  - name and description - meta information, optional
+ *  - data_type - data type name as returned by toString(DataType), result
+ *    type of Callable elements, Boolean by default
+ *  - value - default value, as a JSON string, number or boolean in the
+ *    format described by parseDataVariant(), not supported for Callable
+ *    elements
+ *  - latency - name of a latency profile, latency_us - latency in
+ *    microseconds, see MockBuilder::ElementDescriptor::latency
+ *  - count - number of identical elements to add, 1 by default
+ *  - elements - array of nested elements, Group elements only
+ *
+ * Since the spec is built while it is being parsed, the elements member must
+ * be the last member of the device object and of each group, and latency
+ * profiles must be declared before they are used. Unknown members are
+ * ignored
+ *
+ */
+struct DeviceSpecLoader {
+  /**
+   * @brief Uses the given builder for every loaded spec, so it can be
+   * configured with MockBuilder::enableArena() or
+   * MockBuilder::enableLazyElements() beforehand
+   *
+   * @throws std::invalid_argument - if given builder is empty
+   *
+   * @param builder
+   */
+  explicit DeviceSpecLoader(
+      const MockBuilderPtr& builder = std::make_shared<MockBuilder>());
+
+  /**
+   * @brief Builds the device described by a given spec stream
+   *
+   * If loading fails, the partially built device is abandoned, so the same
+   * loader can load further specs
+   *
+   * @throws MalformedSpec - if the spec is not valid JSON or does not follow
+   * the spec format
+   * @throws std::invalid_argument - if the builder rejects a described element
+   * @throws GroupEmpty - if the described device has no elements
+   *
+   * @param spec
+   * @param source - name of the spec used in error messages
+   * @return std::unique_ptr<Device>
+   */
+  std::unique_ptr<Device> load(
+      std::istream& spec, const std::string& source = "stream");
+
+  /**
+   * @brief Builds the device described by a given spec file
+   *
+   * @throws std::invalid_argument - if the spec file can not be opened
+   * @throws MalformedSpec - if the spec is not valid JSON or does not follow
+   * the spec format
+   * @throws GroupEmpty - if the described device has no elements
+   *
+   * @param spec_path
+   * @return std::unique_ptr<Device>
+   */
+  std::unique_ptr<Device> loadFile(const std::string& spec_path);
+
+  /**
+   * @brief Returns the report of the last successful load() or loadFile()
+   * call
+   *
+   * @return const SpecLoadReport&
+   */
+  const SpecLoadReport& report() const;
+
+private:
+  MockBuilderPtr builder_;
+  SpecLoadReport report_;
+};
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_DEVICE_SPEC_LOADER_HPP
@@ -0,0 +1,45 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_ELEMENT_FAKE_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_ELEMENT_FAKE_HPP
+#include "CallableFake.hpp"
+#include "ElementMock.hpp"
+#include "ObservableFake.hpp"
+#include "ReadableFake.hpp"
+#include "WritableFake.hpp"
+
+#include <Information_Model/Element.hpp>
+
+namespace Information_Model::testing {
+
+/**
+ * @brief Plain Element implementation without any gmock machinery
+ *
+ * Behaves like a NiceMock<ElementMock> with the same constructor arguments,
+ * see @ref ReadableFake for the differences
+ *
+ */
+struct ElementFake : public virtual Element {
+  ElementFake(const ElementFunction& function, const std::string& id,
+      const std::optional<FullMetaInfo>& meta = std::nullopt);
+
+  ~ElementFake() override = default;
+
+  std::string id() const final;
+
+  std::string name() const final;
+
+  std::string description() const final;
+
+  ElementType type() const final;
+
+  ElementFunction function() const final;
+
+private:
+  std::string id_;
+  FullMetaInfo meta_;
+  ElementType type_;
+  ElementFunction function_;
+};
+
+using ElementFakePtr = std::shared_ptr<ElementFake>;
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_ELEMENT_FAKE_HPP
@@ -12,6 +12,16 @@
 
 namespace Information_Model::testing {
 
+/**
+ * @brief Resolves the ElementType of a given ElementFunction
+ *
+ * @throws std::logic_error - if the given function holds no known element type
+ *
+ * @param function
+ * @return ElementType
+ */
+ElementType getElementType(const ElementFunction& function);
+
 struct ElementMock : public virtual Element, public MetaInfoMock {
   ElementMock(const ElementFunction& function, const std::string& id,
       const std::optional<FullMetaInfo>& meta = std::nullopt);
@@ -88,6 +88,7 @@ private:
 
   virtual void cancel(uintmax_t call_id) = 0;
 
+  friend struct CallableFake;
   friend struct CallableMock;
 };
 
@@ -0,0 +1,179 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_FLEET_GENERATOR_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_FLEET_GENERATOR_HPP
+#include "MockBuilder.hpp"
+#include "WorkerPool.hpp"
+
+#include <Information_Model/Device.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Information_Model::testing {
+
+/**
+ * @brief Relative weights of the generated element types. A weight of 0
+ * excludes the element type
+ *
+ */
+struct ElementMix {
+  size_t readable = 1;
+  size_t writable = 0;
+  size_t observable = 0;
+  size_t callable = 0;
+};
+
+/**
+ * @brief Shape parameters of a generated device fleet
+ *
+ * Each device has a root group, every group holds elements_per_group
+ * elements, followed by group_fan_out nested groups as long as the nesting
+ * depth is below depth. A device therefore holds
+ * (1 + G) * elements_per_group elements and G groups, where G is the sum of
+ * group_fan_out^level for every level in range [1, depth]
+ *
+ */
+struct FleetShape {
+  size_t device_count = 1;
+  size_t elements_per_group = 10;
+  size_t group_fan_out = 0;
+  size_t depth = 0;
+  ElementMix element_mix;
+  /**
+   * @brief Relative weights of the generated data types, used as result types
+   * of Callable elements
+   *
+   */
+  std::vector<std::pair<DataType, size_t>> data_type_mix = {
+      {DataType::Boolean, 1}};
+  /**
+   * @brief Fleets generated with the same shape and seed are identical,
+   * regardless of how many threads build them
+   *
+   */
+  uint64_t seed = 0;
+  /**
+   * @brief Devices are identified by the prefix followed by their index
+   *
+   */
+  std::string id_prefix = "device_";
+};
+
+/**
+ * @brief Summary of a single FleetGenerator::generate() run
+ *
+ */
+struct FleetReport {
+  size_t devices = 0;
+  /**
+   * @brief Number of built elements across all devices, including groups
+   *
+   */
+  size_t elements = 0;
+  /**
+   * @brief Wall clock time the generation took
+   *
+   */
+  std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
+
+  /**
+   * @brief Returns the build throughput, 0 if nothing was built
+   *
+   * @return double
+   */
+  double elementsPerSecond() const;
+};
+
+/**
+ * @brief Generates fleets of Device mocks with a given shape through
+ * MockBuilder::addElements()
+ *
+ * Element and data types are drawn from the weighted mixes with a random
+ * generator, that is seeded for each device from the shape seed and the
+ * device index. Devices are built independently of each other, so they can be
+ * built in parallel without affecting the result
+ *
+ */
+struct FleetGenerator {
+  /**
+   * @brief Configures each MockBuilder before it builds a device, for example
+   * with MockBuilder::enableArena() or MockBuilder::enableLazyElements()
+   *
+   */
+  using BuilderConfigurator = std::function<void(MockBuilder&)>;
+
+  /**
+   * @throws std::invalid_argument - if the element mix or data type mix have
+   * no weights, the data type mix contains DataType::Unknown, or the shape
+   * has no elements per group
+   *
+   * @param shape
+   * @param configurator - called concurrently if the fleet is generated with
+   * a WorkerPool
+   */
+  explicit FleetGenerator(
+      const FleetShape& shape, const BuilderConfigurator& configurator = nullptr);
+
+  /**
+   * @brief Builds every device of the fleet on the calling thread
+   *
+   * @return std::vector<DevicePtr> - devices in index order
+   */
+  std::vector<DevicePtr> generate();
+
+  /**
+   * @brief Builds the devices of the fleet across the given pool
+   *
+   * @param pool
+   * @return std::vector<DevicePtr> - devices in index order
+   */
+  std::vector<DevicePtr> generate(WorkerPool& pool);
+
+  /**
+   * @brief Builds a single device of the fleet
+   *
+   * @throws std::out_of_range - if the index is not below the device count
+   *
+   * @param index
+   * @return DevicePtr
+   */
+  DevicePtr generateDevice(size_t index) const;
+
+  /**
+   * @brief Returns the number of elements of each device, including groups
+   *
+   * @return size_t
+   */
+  size_t elementsPerDevice() const;
+
+  /**
+   * @brief Returns the report of the last generate() call
+   *
+   * @return const FleetReport&
+   */
+  const FleetReport& report() const;
+
+private:
+  using Generator = std::mt19937_64;
+
+  void addGroupContent(MockBuilder& builder,
+      Generator& generator,
+      const std::string& group_id,
+      size_t remaining_depth) const;
+
+  std::vector<DevicePtr> generate(
+      const std::function<void(size_t, const WorkerPool::Task&)>& run);
+
+  FleetShape shape_;
+  BuilderConfigurator configurator_;
+  std::vector<std::pair<ElementType, size_t>> element_weights_;
+  size_t element_weight_total_ = 0;
+  size_t data_type_weight_total_ = 0;
+  FleetReport report_;
+};
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_FLEET_GENERATOR_HPP
@@ -1,12 +1,59 @@
 
 #ifndef __STAG_INFORMATION_MODEL_MOCKS_GROUP_MOCK_HPP
 #define __STAG_INFORMATION_MODEL_MOCKS_GROUP_MOCK_HPP
+#include "IdPath.hpp"
+#include "WorkerPool.hpp"
+
 #include <Information_Model/Group.hpp>
 #include <gmock/gmock.h>
 
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 namespace Information_Model::testing {
 
+/**
+ * @brief Visitor call order of GroupMock::parallelVisit()
+ *
+ */
+enum class VisitOrder {
+  /**
+   * @brief Visitor is called concurrently from multiple threads, in no
+   * particular order
+   *
+   */
+  Unordered,
+  /**
+   * @brief Visitor is called one element at a time in depth-first order, each
+   * group element before its children, siblings in insertion order.
+   * Only the traversal of nested groups is spread across the pool
+   *
+   */
+  Ordered
+};
+
 struct GroupMock : public Group {
+  using PathVisitor = std::function<void(const ElementPtr&, const IdPath&)>;
+  /**
+   * @brief Creates a lazily added element, given its offset within the lazy
+   * range and its ID
+   *
+   */
+  using ElementFactory =
+      std::function<ElementPtr(size_t offset, const std::string& id)>;
+  using ElementMap = std::unordered_map<std::string, ElementPtr>;
+  using ElementMapSnapshot = std::shared_ptr<const ElementMap>;
+  using ElementVectorSnapshot = std::shared_ptr<const std::vector<ElementPtr>>;
+
   explicit GroupMock(const std::string& id);
 
   ~GroupMock() override = default;
@@ -20,6 +67,7 @@ struct GroupMock : public Group {
 
   /**
    * @brief Generates a new ID string based on the mocked group ID
+   * The returned string is the only allocation made, see IdPath::childId()
    * This method is intended to be used in tandem with addElement() method when
    * creating new Element instances.
    *
@@ -36,22 +84,232 @@ struct GroupMock : public Group {
    * @brief Checks if a given element instance is part of this Device and adds
    * it to the device, if that is the case
    *
+   * Elements are stored in a contiguous vector in insertion order, so visit()
+   * and asVector() always return them in the order they were added. Elements
+   * are also added to an ID index, that is shared by all nested groups, so
+   * element() lookups take a single hash probe regardless of nesting depth
+   *
    * @throws std::invalid_argument - if
    * - given element is null
    * - given element id is the same as this group id
    * - given element id is not part of this group
    * - given element id points to a parent element that is not a group
+   * - given element local id is not a number
    * @throws std::logic_error - if given element is already in this group
    *
    * @param element
    */
   void addElement(const ElementPtr& element);
 
+  /**
+   * @brief Generates the given number of consecutive IDs, same as calling
+   * generateID() the given number of times
+   *
+   * @param count
+   * @return std::vector<std::string>
+   */
+  std::vector<std::string> generateIDs(size_t count);
+
+  /**
+   * @brief Adds multiple direct child elements at once
+   *
+   * Unlike addElement(), the element IDs are taken from the given IDs instead
+   * of being read back through the mocked id() call of each element, capacity
+   * for all of the elements is reserved up front and cached snapshots are
+   * invalidated once. Either all of the elements are added or none of them
+   *
+   * @attention Given elements must not be groups, add nested groups with
+   * addElement() instead
+   *
+   * @throws std::invalid_argument - if
+   * - given ID and element counts differ
+   * - any given element is null
+   * - any given element is a group
+   * - any given ID is not a direct child ID of this group
+   * - any given local ID is not a number
+   * @throws std::logic_error - if any given ID is already in this group
+   *
+   * @param ids - element IDs, as generated by generateIDs()
+   * @param elements - elements with the same ID at the same position
+   */
+  void addElements(const std::vector<std::string>& ids,
+      const std::vector<ElementPtr>& elements);
+
+  /**
+   * @brief Creates the given number of elements with the given factory and
+   * adds them with consecutive IDs, same as addElements()
+   *
+   * The IDs are only taken once all of the elements are created and added, so
+   * a throwing factory leaves this group as it was
+   *
+   * @attention The factory must not create groups
+   *
+   * @throws std::invalid_argument - if given factory is empty, or same as
+   * addElements()
+   * @throws std::logic_error - same as addElements()
+   *
+   * @param count
+   * @param factory
+   * @return size_t - local ID number of the first element
+   */
+  size_t addElements(size_t count, const ElementFactory& factory);
+
+  /**
+   * @brief Reserves the given number of consecutive IDs for elements, that are
+   * only created by the given factory once they are first accessed
+   *
+   * A lazy element is created once it is looked up through element(), or once
+   * all of the lazy elements of this group are created by visit(), asMap(),
+   * asVector() or parallelVisit(). Until then it takes up a few dozen bytes.
+   * size() counts lazy elements right away
+   *
+   * @attention The factory must not create groups and must be safe to call
+   * from any thread, that accesses this group
+   *
+   * @throws std::invalid_argument - if given factory is empty
+   * @throws std::logic_error - if any of the reserved IDs is already in this
+   * group
+   *
+   * @param count
+   * @param factory
+   * @return size_t - local ID number of the first lazy element
+   */
+  size_t addLazyElements(size_t count, const ElementFactory& factory);
+
+  /**
+   * @brief Returns an immutable snapshot of the local ID to element map, that
+   * is returned by asMap()
+   *
+   * The snapshot is cached until the next addElement() call, so repeated calls
+   * return the same snapshot in O(1) without copying it. Snapshots that were
+   * handed out stay valid and unchanged after addElement() calls
+   *
+   * @return ElementMapSnapshot
+   */
+  ElementMapSnapshot mapSnapshot() const;
+
+  /**
+   * @brief Returns an immutable snapshot of the element vector, that is
+   * returned by asVector()
+   *
+   * Same caching rules as @ref mapSnapshot()
+   *
+   * @return ElementVectorSnapshot
+   */
+  ElementVectorSnapshot vectorSnapshot() const;
+
+  /**
+   * @brief Visits every element nested within this group, including the
+   * elements of nested groups, by fanning out each nested group to the given
+   * pool
+   *
+   * Unlike visit(), which only visits the direct children of this group, this
+   * method flattens the whole subtree. Elements must not be added while the
+   * visit is ongoing
+   *
+   * @throws any exception thrown by the given visitor. If multiple visitor
+   * calls throw, only the first exception is rethrown
+   *
+   * @param pool
+   * @param visitor
+   * @param order
+   */
+  void parallelVisit(WorkerPool& pool,
+      const Group::Visitor& visitor,
+      VisitOrder order = VisitOrder::Unordered) const;
+
+  /**
+   * @brief Same as @ref parallelVisit(WorkerPool&, const Group::Visitor&,
+   * VisitOrder) const, but also hands each element its ID path. The viewed ID
+   * stays valid for as long as this group exists
+   *
+   * @param pool
+   * @param visitor
+   * @param order
+   */
+  void parallelVisit(WorkerPool& pool,
+      const PathVisitor& visitor,
+      VisitOrder order = VisitOrder::Unordered) const;
+
 private:
+  // maps full element ids to elements of the whole device tree, keyed by
+  // views, so lookups with borrowed ids do not allocate
+  struct ElementIndex {
+    // owns the viewed ids, deque keeps them in place while growing
+    std::deque<std::string> ids;
+    // elements are owned by their groups, nested groups own the index
+    std::unordered_map<std::string_view, std::weak_ptr<Element>> elements;
+    // lazy elements are added to elements on first access, while other
+    // threads may look up elements of the same device, also guards ids and
+    // groups
+    mutable std::shared_mutex elements_mx;
+    // nested groups by their full ids, resolves the parents of lazy elements
+    std::unordered_map<std::string_view, std::weak_ptr<GroupMock>> groups;
+    // indices of groups built before being attached, that own some of the ids
+    std::vector<std::shared_ptr<ElementIndex>> merged;
+  };
+
+  struct LazyRange {
+    size_t first_index;
+    size_t first_position;
+    size_t count;
+    ElementFactory factory;
+  };
+
   ElementPtr getElement(const std::string& ref_id);
 
-  std::unordered_map<std::string, ElementPtr> elements_;
-  std::unordered_map<std::string, GroupPtr> subgroups_;
+  // looks up an element nested below this group without allocating, returns
+  // nullptr if it does not exist
+  ElementPtr findElement(std::string_view ref_id);
+
+  ElementPtr findLazy(std::string_view ref_id);
+
+  ElementPtr materialize(size_t index) const;
+
+  void materializeAll() const;
+
+  const ElementPtr& materializeLocked(
+      const LazyRange& range, size_t offset) const;
+
+  void shareIndex(const std::shared_ptr<ElementIndex>& index);
+
+  void adoptIndex(const std::shared_ptr<ElementIndex>& index);
+
+  void invalidateSnapshots();
+
+  bool isIndexUsed(size_t index) const;
+
+  void markIndex(size_t index);
+
+  void unmarkIndex(size_t index);
+
+  void forEach(const Group::Visitor& visitor) const;
+
+  void fanOut(WorkerPool& pool, const PathVisitor& visitor) const;
+
+  using FlattenedElements = std::vector<std::pair<ElementPtr, std::string_view>>;
+
+  void flatten(WorkerPool& pool, FlattenedElements& flattened) const;
+
+  // contiguous and in insertion order, so visit() and asVector() are stable,
+  // lazy elements hold nullptr until they are materialized on first access
+  mutable std::vector<ElementPtr> elements_;
+  // full ids of elements_, viewing into the ids owned by the element index
+  mutable std::vector<std::string_view> ids_;
+  // nested groups of elements_, other positions hold nullptr
+  std::vector<std::shared_ptr<GroupMock>> subgroups_;
+  // indexed by local id number, marks the numbers that are already taken
+  std::vector<bool> used_indices_;
+  // taken numbers far beyond the generated ones, so caller given ids can not
+  // grow used_indices_ without bound
+  std::unordered_set<size_t> sparse_indices_;
+  std::vector<LazyRange> lazy_ranges_;
+  mutable std::mutex lazy_mx_;
+  // shared by all nested groups, so any element is found with a single probe
+  std::shared_ptr<ElementIndex> shared_index_;
+  mutable std::mutex snapshot_mx_;
+  mutable ElementMapSnapshot map_snapshot_;
+  mutable ElementVectorSnapshot vector_snapshot_;
   size_t next_id_ = 0;
   std::string id_;
 };
@@ -0,0 +1,117 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_ID_PATH_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_ID_PATH_HPP
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Information_Model::testing {
+
+/**
+ * @brief Non owning view of an element ID path
+ *
+ * Element IDs consist of the device ID, followed by a colon and the dot
+ * separated local IDs of each nested element, for example device:0.3.1. Root
+ * group IDs end with the colon, for example device:
+ *
+ * All of the queries only slice the viewed ID and never allocate, the viewed
+ * string must outlive the IdPath instance
+ *
+ */
+struct IdPath {
+  static constexpr char DEVICE_SEPARATOR = ':';
+  static constexpr char SEGMENT_SEPARATOR = '.';
+
+  constexpr explicit IdPath(std::string_view id) noexcept : id_(id) {}
+
+  /**
+   * @brief Returns the viewed ID
+   *
+   * @return std::string_view
+   */
+  constexpr std::string_view str() const noexcept { return id_; }
+
+  /**
+   * @brief Checks if this is a root group ID, that ends with a colon
+   *
+   * @return true
+   * @return false
+   */
+  constexpr bool isRoot() const noexcept {
+    return !id_.empty() && id_.back() == DEVICE_SEPARATOR;
+  }
+
+  /**
+   * @brief Returns the ID, that elements refer to this path with. Same as str()
+   * except for root group IDs, which are returned without the trailing colon
+   *
+   * @return std::string_view
+   */
+  constexpr std::string_view name() const noexcept {
+    return isRoot() ? id_.substr(0, id_.size() - 1) : id_;
+  }
+
+  /**
+   * @brief Returns the ID of the parent element, or the device ID for root
+   * elements. Returns an empty view for root group IDs
+   *
+   * @return std::string_view
+   */
+  std::string_view parent() const noexcept;
+
+  /**
+   * @brief Checks if a given ID refers to an element nested anywhere below
+   * this path
+   *
+   * @param ref_id
+   * @return true
+   * @return false
+   */
+  bool contains(std::string_view ref_id) const noexcept;
+
+  /**
+   * @brief Returns the ID of the direct child of this path, that contains or is
+   * the given ID. Returns an empty view if the given ID is not contained
+   *
+   * @param ref_id
+   * @return std::string_view
+   */
+  std::string_view child(std::string_view ref_id) const noexcept;
+
+  /**
+   * @brief Returns the local ID of the direct child of this path, that
+   * contains or is the given ID. Returns an empty view if the given ID is not
+   * contained
+   *
+   * @param ref_id
+   * @return std::string_view
+   */
+  std::string_view localId(std::string_view ref_id) const noexcept;
+
+  /**
+   * @brief Returns the numeric value of the last ID segment, if it is a number
+   *
+   * @return std::optional<size_t>
+   */
+  std::optional<size_t> index() const noexcept;
+
+  /**
+   * @brief Formats the ID of the child with a given local index. The returned
+   * string is the only allocation made
+   *
+   * @param index
+   * @return std::string
+   */
+  std::string childId(size_t index) const;
+
+private:
+  // number of characters before the first local ID segment below this path
+  constexpr size_t prefixLength() const noexcept {
+    return isRoot() ? id_.size() : id_.size() + 1;
+  }
+
+  std::string_view id_;
+};
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_ID_PATH_HPP
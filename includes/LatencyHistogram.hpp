@@ -0,0 +1,92 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_LATENCY_HISTOGRAM_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_LATENCY_HISTOGRAM_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Information_Model::testing {
+
+/**
+ * @brief High dynamic range histogram of latency values
+ *
+ * Values are recorded in nanoseconds into log-linear buckets. Values below
+ * 128ns are recorded exactly, larger values are recorded with a relative
+ * error below 1.6%. Memory usage grows with the largest recorded value, a
+ * histogram that only recorded latencies below 1ms uses about 8kB
+ *
+ * @attention This class is not thread safe, callers must synchronize
+ * concurrent access
+ *
+ */
+struct LatencyHistogram {
+  /**
+   * @brief Records a given latency value. Negative values are recorded as 0
+   *
+   * @param latency
+   */
+  void record(std::chrono::nanoseconds latency);
+
+  /**
+   * @brief Adds all of the values recorded by a given histogram to this one
+   *
+   * @param other
+   */
+  void merge(const LatencyHistogram& other);
+
+  /**
+   * @brief Removes all recorded values
+   *
+   */
+  void reset();
+
+  /**
+   * @brief Returns the number of recorded values
+   *
+   * @return size_t
+   */
+  size_t count() const;
+
+  /**
+   * @brief Returns the smallest recorded value or 0 if nothing was recorded
+   *
+   * @return std::chrono::nanoseconds
+   */
+  std::chrono::nanoseconds min() const;
+
+  /**
+   * @brief Returns the largest recorded value or 0 if nothing was recorded
+   *
+   * @return std::chrono::nanoseconds
+   */
+  std::chrono::nanoseconds max() const;
+
+  /**
+   * @brief Returns the mean of the recorded values or 0 if nothing was
+   * recorded
+   *
+   * @return std::chrono::nanoseconds
+   */
+  std::chrono::nanoseconds mean() const;
+
+  /**
+   * @brief Returns the value, that the given percentage of recorded values
+   * are less than or equal to, within the histogram precision
+   *
+   * @throws std::invalid_argument - if given percentile is not within [0,100]
+   *
+   * @param percentile
+   * @return std::chrono::nanoseconds
+   */
+  std::chrono::nanoseconds percentile(double percentile) const;
+
+private:
+  std::vector<uint64_t> counts_;
+  size_t count_ = 0;
+  uint64_t min_ = 0;
+  uint64_t max_ = 0;
+  long double sum_ = 0;
+};
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_LATENCY_HISTOGRAM_HPP
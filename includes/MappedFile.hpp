@@ -0,0 +1,67 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_MAPPED_FILE_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace Information_Model::testing {
+
+/**
+ * @brief Read only memory mapping of a whole file
+ *
+ */
+struct MappedFile {
+  /**
+   * @brief Expected order of accesses, used as a paging hint
+   *
+   */
+  enum class Access { Sequential, Random };
+
+  /**
+   * @throws std::invalid_argument - if the file can not be opened, its size
+   * can not be queried or it can not be mapped
+   *
+   * @param path
+   * @param file_kind - file description used in error messages, e.g. trace
+   * @param access
+   */
+  MappedFile(const std::string& path,
+      const std::string& file_kind,
+      Access access = Access::Sequential);
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  std::string_view content() const;
+
+  /**
+   * @brief Hands the pages before the given position back to the operating
+   * system, so reading files larger than the memory does not thrash
+   *
+   */
+  void release(size_t position);
+
+  /**
+   * @brief Resets the released page tracking, released pages are transparently
+   * read again from the file, once they are accessed
+   *
+   */
+  void rewind();
+
+private:
+  void unmap();
+
+#ifdef _WIN32
+  // HANDLE values, kept opaque so windows.h is not included
+  void* file_ = nullptr;
+  void* mapping_ = nullptr;
+#endif
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  size_t released_ = 0;
+};
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_MAPPED_FILE_HPP
@@ -0,0 +1,113 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_MOCK_ARENA_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_MOCK_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <utility>
+
+namespace Information_Model::testing {
+
+/**
+ * @brief Monotonic memory arena, that holds all of the mocks of a single device
+ *
+ * Memory is only ever handed out, never reused, and is released in one shot
+ * once the arena is destroyed. Every object allocated through an
+ * ArenaAllocator keeps the arena alive, so the arena is destroyed together
+ * with the last of its objects
+ *
+ * Allocations are serialized, since lazy elements and their groups are
+ * materialized from any thread, that looks them up or visits them
+ *
+ */
+struct MockArena {
+  /**
+   * @brief Reserves the given number of bytes up front, further blocks are
+   * allocated as needed
+   *
+   * @param initial_size
+   */
+  explicit MockArena(size_t initial_size) : resource_(initial_size) {}
+
+  MockArena(const MockArena&) = delete;
+  MockArena& operator=(const MockArena&) = delete;
+
+  void* allocate(size_t bytes, size_t alignment) {
+    std::scoped_lock guard(mx_);
+    return resource_.allocate(bytes, alignment);
+  }
+
+  void deallocate(void* pointer, size_t bytes, size_t alignment) {
+    std::scoped_lock guard(mx_);
+    resource_.deallocate(pointer, bytes, alignment);
+  }
+
+private:
+  std::mutex mx_;
+  std::pmr::monotonic_buffer_resource resource_;
+};
+
+using MockArenaPtr = std::shared_ptr<MockArena>;
+
+/**
+ * @brief Allocator, that places objects into a shared MockArena and keeps the
+ * arena alive for as long as any of its copies exist
+ *
+ * Intended to be used with std::allocate_shared(), which stores a copy of the
+ * allocator next to the allocated object
+ *
+ * @tparam T
+ */
+template <class T> struct ArenaAllocator {
+  using value_type = T;
+
+  explicit ArenaAllocator(const MockArenaPtr& arena) : arena_(arena) {}
+
+  template <class U>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena()) {}
+
+  T* allocate(size_t count) {
+    return static_cast<T*>(arena_->allocate(count * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* pointer, size_t count) {
+    arena_->deallocate(pointer, count * sizeof(T), alignof(T));
+  }
+
+  const MockArenaPtr& arena() const { return arena_; }
+
+  template <class U> bool operator==(const ArenaAllocator<U>& other) const {
+    return arena_ == other.arena();
+  }
+
+  template <class U> bool operator!=(const ArenaAllocator<U>& other) const {
+    return arena_ != other.arena();
+  }
+
+private:
+  MockArenaPtr arena_;
+};
+
+/**
+ * @brief Creates a shared object within the given arena, or on the heap if no
+ * arena is given
+ *
+ * @tparam T
+ * @tparam Args
+ * @param arena
+ * @param args - constructor arguments
+ * @return std::shared_ptr<T>
+ */
+template <class T, class... Args>
+std::shared_ptr<T> makeShared(const MockArenaPtr& arena, Args&&... args) {
+  if (arena) {
+    return std::allocate_shared<T>(
+        ArenaAllocator<T>(arena), std::forward<Args>(args)...);
+  } else {
+    return std::make_shared<T>(std::forward<Args>(args)...);
+  }
+}
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_MOCK_ARENA_HPP
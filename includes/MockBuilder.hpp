@@ -1,13 +1,109 @@
 #ifndef __STAG_INFORMATION_MODEL_MOCKS_MOCK_BUILDER_HPP
 #define __STAG_INFORMATION_MODEL_MOCKS_MOCK_BUILDER_HPP
 #include "DeviceMock.hpp"
+#include "DevicePrototype.hpp"
 #include "FakeExecutor.hpp"
+#include "MockArena.hpp"
 
 #include <Information_Model/DeviceBuilder.hpp>
 
+#include <chrono>
+#include <optional>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 namespace Information_Model::testing {
 
 struct MockBuilder : public DeviceBuilder {
+  static constexpr size_t DEFAULT_ARENA_SIZE = 1024 * 1024;
+
+  /**
+   * @brief Describes a single element, that is added by addElements()
+   *
+   */
+  struct ElementDescriptor {
+    /**
+     * @brief Readable, Writable, Observable or Callable
+     *
+     */
+    ElementType type = ElementType::Readable;
+    BuildInfo info;
+    /**
+     * @brief Data type of Readable, Writable and Observable elements, result
+     * type of Callable elements
+     *
+     */
+    DataType data_type = DataType::Boolean;
+    /**
+     * @brief Value returned on read() calls, overrides data_type if set. Not
+     * supported for Callable elements
+     *
+     */
+    std::optional<DataVariant> default_value = std::nullopt;
+    /**
+     * @brief Time each read() call, and each write() call of Writable
+     * elements, blocks for before returning. Not supported for Callable
+     * elements
+     *
+     */
+    std::chrono::nanoseconds latency = std::chrono::nanoseconds::zero();
+  };
+
+  /**
+   * @brief Places the element, group and functional mocks of every device
+   * built from now on into a MockArena, instead of allocating each of them on
+   * the heap separately
+   *
+   * The arena of a device is released in one shot, once the last reference to
+   * the device or any of its mocks is dropped. Memory allocated by the mocks
+   * themselves (for example ID strings and gmock bookkeeping) is still
+   * allocated on the heap
+   *
+   * @throws DeviceBuildInProgress - if called while a device is being built
+   *
+   * @param initial_size - number of bytes reserved up front
+   */
+  void enableArena(size_t initial_size = DEFAULT_ARENA_SIZE);
+
+  /**
+   * @brief Makes addElements() describe the elements of every device built
+   * from now on, instead of building their mocks right away
+   *
+   * Element and functional mocks are only created once an element is first
+   * accessed, as described by @ref GroupMock::addLazyElements(). Consecutive
+   * equal descriptors are stored once, so untouched elements of large uniform
+   * batches take up a few dozen bytes each
+   *
+   * @throws DeviceBuildInProgress - if called while a device is being built
+   *
+   */
+  void enableLazyElements();
+
+  /**
+   * @brief Makes every device built from now on use ElementFake and the
+   * matching ReadableFake, WritableFake, ObservableFake or CallableFake
+   * instances instead of mocks
+   *
+   * Fakes answer calls through plain virtual overrides, so they stay cheap
+   * under multi-threaded load, but their calls can not be expected. Groups and
+   * the device itself are still built as mocks. NotifyCallbacks returned by
+   * addObservable() notify the built ObservableFake instances
+   *
+   * @throws DeviceBuildInProgress - if called while a device is being built
+   *
+   */
+  void enableFakes();
+
+  /**
+   * @brief Makes every device built from now on also record a DevicePrototype,
+   * that is returned by resultPrototype() instead of the built device
+   *
+   * @throws DeviceBuildInProgress - if called while a device is being built
+   *
+   */
+  void enablePrototypeRecording();
+
   void setDeviceInfo(
       const std::string& unique_id, const BuildInfo& element_info) final;
 
@@ -200,24 +296,95 @@ struct MockBuilder : public DeviceBuilder {
   std::string addCallable(const std::string& parent_id,
       const BuildInfo& element_info, const ExecutorPtr& executor);
 
+  /**
+   * @brief Adds multiple default mock elements to a given parent at once
+   *
+   * Device info and the parent group are checked once, IDs for all of the
+   * elements are generated in one go and the elements are inserted with
+   * @ref GroupMock::addElements(), so the cost of building large devices is
+   * bound by allocations rather than per element bookkeeping
+   *
+   * If lazy elements are enabled, the mocks are created on first access, see
+   * @ref enableLazyElements()
+   *
+   * Observable elements are created without an IsObservingCallback, their
+   * NotifyCallback is not returned, use ObservableMock::notify() instead
+   *
+   * @throws DeviceInfoNotSet - if setDeviceInfo() was not called
+   * @throws std::invalid_argument - if the parent group does not exist, a
+   * descriptor describes a Group, or a Callable descriptor has a default value
+   * or latency. Nothing is added in that case
+   *
+   * @param parent_id - parent group ID, empty for root elements
+   * @param descriptors
+   * @return std::vector<std::string> - IDs of the added elements, in
+   * descriptor order
+   */
+  std::vector<std::string> addElements(const std::string& parent_id,
+      const std::vector<ElementDescriptor>& descriptors);
+
   std::unique_ptr<Device> result() final;
 
+  /**
+   * @brief Discards the device that is currently being built, so the next
+   * setDeviceInfo() call starts a new build
+   *
+   * Does nothing if no device is being built
+   *
+   */
+  void abandonBuild();
+
+  /**
+   * @brief Finishes the current build and returns its prototype instead of the
+   * built device. The prototype can be cloned into any number of devices
+   *
+   * @throws DeviceInfoNotSet - if setDeviceInfo() was not called
+   * @throws GroupEmpty - if any of the built groups is empty
+   * @throws std::logic_error - if prototype recording is not enabled
+   *
+   * @return DevicePrototypePtr
+   */
+  DevicePrototypePtr resultPrototype();
+
 private:
+  std::vector<std::string> insertElements(const std::string& parent_id,
+      const GroupMockPtr& parent,
+      const std::vector<ElementDescriptor>& descriptors);
+
   GroupMockPtr getParentGroup(const std::string& parent_id);
 
   std::string assignID(const std::string& parent_id);
 
-  std::string makeElementMock(const std::string& parent_id,
-      const ElementFunction& function, const BuildInfo& element_info);
+  std::pair<std::string, ElementFunction> makeElementMock(
+      const std::string& parent_id,
+      const BuildInfo& element_info,
+      const DevicePrototype::FunctionFactory& factory);
+
+  size_t prototypeGroup(const std::string& parent_id) const;
+
+  void recordElements(const std::string& parent_id,
+      const std::vector<ElementDescriptor>& descriptors);
 
   void addElementMock(const ElementFunction& function, const std::string& id,
       const BuildInfo& element_info);
 
+  void fillGroup(const std::string& parent_id);
+
   void checkBase() const;
   void checkGroups() const;
 
   std::unique_ptr<DeviceMock> result_;
   std::unordered_map<std::string, GroupMockPtr> subgroups_;
+  // IDs of groups without elements, the root group is tracked as ""
+  std::unordered_set<std::string> empty_groups_;
+  std::optional<size_t> arena_size_;
+  MockArenaPtr arena_;
+  bool lazy_elements_ = false;
+  bool fakes_ = false;
+  bool record_prototype_ = false;
+  std::shared_ptr<DevicePrototype> prototype_;
+  // maps built group IDs to their prototype group index
+  std::unordered_map<std::string, size_t> prototype_groups_;
 };
 
 using MockBuilderPtr = std::shared_ptr<MockBuilder>;
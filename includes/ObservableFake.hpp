@@ -0,0 +1,131 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_OBSERVABLE_FAKE_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_OBSERVABLE_FAKE_HPP
+#include "ObservableMock.hpp"
+#include "ReadableFake.hpp"
+
+#include <Information_Model/Observable.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace Information_Model::testing {
+
+/**
+ * @brief Plain Observable implementation without any gmock machinery
+ *
+ * Behaves like a NiceMock<ObservableMock> with the same constructor
+ * arguments, see @ref ReadableFake for the differences. Observers are tracked
+ * and notified the same way as by ObservableMock, including filters, parallel
+ * dispatch and latency tracking
+ *
+ * Unlike ObservableMock, subscribe() returns a dummy Observer, that is never
+ * notified, until enableSubscribeFaking() is called with a valid callback.
+ * ObservableFake instances can be published with DeviceMock::tick() and
+ * replayed with TraceReplayer, but not with notifyTogether()
+ *
+ */
+struct ObservableFake : public Observable {
+  using ReadCallback = ObservableMock::ReadCallback;
+  using IsObservingCallback = ObservableMock::IsObservingCallback;
+
+  ObservableFake();
+
+  explicit ObservableFake(DataType type);
+
+  explicit ObservableFake(const DataVariant& value);
+
+  ObservableFake(DataType type, const ReadCallback& read_cb);
+
+  ~ObservableFake() override = default;
+
+  /**
+   * @brief Same as @ref ObservableMock::enableSubscribeFaking()
+   *
+   * @param callback
+   */
+  void enableSubscribeFaking(const IsObservingCallback& callback);
+
+  /**
+   * @brief Same as @ref ObservableMock::enableParallelDispatch()
+   *
+   * @param pool
+   */
+  void enableParallelDispatch(const WorkerPoolPtr& pool);
+
+  /**
+   * @brief Same as @ref ObservableMock::subscribe(const
+   * Observable::ObserveCallback&, const Observable::ExceptionHandler&, const
+   * NotificationFilter&)
+   *
+   */
+  ObserverPtr subscribe(const Observable::ObserveCallback& callback,
+      const Observable::ExceptionHandler& handler,
+      const NotificationFilter& filter);
+
+  /**
+   * @brief Same as @ref ObservableMock::enableLatencyTracking()
+   *
+   * @param enable
+   */
+  void enableLatencyTracking(bool enable);
+
+  /**
+   * @brief Same as @ref ObservableMock::latencies()
+   *
+   * @return std::vector<ObserverLatency>
+   */
+  std::vector<ObserverLatency> latencies() const;
+
+  /**
+   * @brief Same as @ref ObservableMock::updateType()
+   *
+   * @param type
+   */
+  void updateType(DataType type);
+
+  /**
+   * @brief Same as @ref ObservableMock::updateValue()
+   *
+   * @param value
+   */
+  void updateValue(const DataVariant& value);
+
+  /**
+   * @brief Same as @ref ObservableMock::updateReadCallback()
+   *
+   * @param read_cb
+   */
+  void updateReadCallback(const ReadCallback& read_cb);
+
+  /**
+   * @brief Same as @ref ObservableMock::notify(const DataVariant&)
+   *
+   * @param value
+   */
+  void notify(const DataVariant& value);
+
+  /**
+   * @brief Same as @ref ObservableMock::notify(DataVariant&&)
+   *
+   * @param value
+   */
+  void notify(DataVariant&& value);
+
+  DataType dataType() const final;
+
+  DataVariant read() const final;
+
+  ObserverPtr subscribe(const Observable::ObserveCallback& callback,
+      const Observable::ExceptionHandler& handler) final;
+
+private:
+  friend struct DeviceMock;
+
+  ReadableFake readable_;
+  ObserverRegistryPtr registry_;
+  bool faking_ = false;
+};
+
+using ObservableFakePtr = std::shared_ptr<ObservableFake>;
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_OBSERVABLE_FAKE_HPP
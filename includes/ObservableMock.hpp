@@ -1,26 +1,24 @@
 #ifndef __STAG_INFORMATION_MODEL_MOCKS_OBSERVABLE_MOCK_HPP
 #define __STAG_INFORMATION_MODEL_MOCKS_OBSERVABLE_MOCK_HPP
+#include "ObserverRegistry.hpp"
 #include "ReadableMock.hpp"
+#include "WorkerPool.hpp"
 
 #include <Information_Model/Observable.hpp>
 #include <gmock/gmock.h>
 
-#include <mutex>
+#include <memory>
+#include <optional>
+#include <utility>
 #include <vector>
 
 namespace Information_Model::testing {
 
-struct ObserverPimpl : virtual public Observer {
-  ~ObserverPimpl() override = default;
-
-  virtual void dispatch(const std::shared_ptr<DataVariant>& value) = 0;
-};
-
 struct ObservableMock : public Observable {
   using ReadCallback = ReadableMock::ReadCallback;
   using IsObservingCallback = std::function<void(bool)>;
 
-  ObservableMock() = default;
+  ObservableMock();
 
   explicit ObservableMock(DataType type);
 
@@ -39,10 +37,74 @@ struct ObservableMock : public Observable {
    * attached notifier (Dummy Observers will not be notified when notify() is
    * called)
    *
+   * The callback is called with true when the first Observer subscribes and
+   * with false as soon as the last ObserverPtr instance is destroyed
+   *
    * @param callback
    */
   void enableSubscribeFaking(const IsObservingCallback& callback);
 
+  /**
+   * @brief Enables or disables parallel notification dispatching
+   *
+   * If the given pool is not null, notify() partitions the registered
+   * Observers across the pool workers instead of calling them one after
+   * another on the caller thread. notify() still blocks until every Observer
+   * has been called, so each Observer receives notifications in the same order
+   * as they were dispatched. If the given pool is null, Observers are called
+   * on the caller thread
+   *
+   * @param pool
+   */
+  void enableParallelDispatch(const WorkerPoolPtr& pool);
+
+  /**
+   * @brief Subscribes a new Observer, that only receives the notifications
+   * which pass the given filter
+   *
+   * Unlike the mocked subscribe() method, this method does not count as a
+   * mock call and always attaches a notifiable Observer, even if
+   * enableSubscribeFaking() was never called. The IsObservingCallback, if one
+   * was set, is called the same way as for the mocked subscribe() method
+   *
+   * @throws std::invalid_argument - if callback or handler are empty, if a
+   * deadband or min_interval value is negative or if a deadband is set for a
+   * non numeric data type
+   *
+   * @param callback
+   * @param handler
+   * @param filter
+   * @return ObserverPtr
+   */
+  ObserverPtr subscribe(const Observable::ObserveCallback& callback,
+      const Observable::ExceptionHandler& handler,
+      const NotificationFilter& filter);
+
+  /**
+   * @brief Enables or disables notification latency tracking
+   *
+   * Enabling latency tracking discards any previously tracked latencies and
+   * starts timestamping each notify() call. For each Observer, the time until
+   * the notification is handed to the Observer and the time the Observer
+   * callback takes to return are recorded. Disabling latency tracking keeps
+   * the tracked latencies available via latencies()
+   *
+   * @param enable
+   */
+  void enableLatencyTracking(bool enable);
+
+  /**
+   * @brief Returns the tracked notification latencies for each Observer that
+   * was subscribed while latency tracking was enabled, in subscription order
+   *
+   * Latencies of up to 256 released Observers are returned separately, those
+   * of any further released Observers are merged into the entry of the oldest
+   * released one
+   *
+   * @return std::vector<ObserverLatency>
+   */
+  std::vector<ObserverLatency> latencies() const;
+
   /**
    * @brief Change the modeled data type
    *
@@ -74,13 +136,30 @@ struct ObservableMock : public Observable {
 
   /**
    * @brief Dispatch a new notification value to all registered Observers
-   * (Does nothing if enableSubscribeFaking() was never called or the last
-   * enableSubscribeFaking() call passed a nullptr parameter value)
+   *
+   * Observers are registered by the mocked subscribe() method, if
+   * enableSubscribeFaking() was called with a non nullptr parameter value, and
+   * by the filtered subscribe() overload regardless of it. Does nothing if
+   * there are no such Observers
    *
    * @param value
    */
   void notify(const DataVariant& value);
 
+  /**
+   * @brief Dispatch a new notification value to all registered Observers by
+   * moving it into a pooled payload buffer
+   *
+   * Payload buffers are handed back and recycled once all Observers have
+   * released them, so large Opaque or String notifications are delivered
+   * without being copied. Buffers above 64kB are freed instead of recycled
+   *
+   * Same as @ref notify(const DataVariant&) otherwise
+   *
+   * @param value
+   */
+  void notify(DataVariant&& value);
+
   MOCK_METHOD(DataType, dataType, (), (const final));
   MOCK_METHOD(DataVariant, read, (), (const final));
   MOCK_METHOD(ObserverPtr, subscribe,
@@ -88,17 +167,48 @@ struct ObservableMock : public Observable {
       (final));
 
 private:
+  friend struct DeviceMock;
+  friend struct ObservableFake;
+  friend void notifyTogether(
+      const std::vector<std::pair<std::shared_ptr<ObservableMock>,
+          DataVariant>>& notifications);
+
   void setReadableCalls() const;
 
+  // the data type is only read if the filter has a deadband
+  static void checkFilter(
+      const NotificationFilter& filter, const Readable& readable);
+
   ObserverPtr attachObserver(const Observable::ObserveCallback& callback,
-      const Observable::ExceptionHandler& handler);
+      const Observable::ExceptionHandler& handler,
+      const std::optional<NotificationFilter>& filter);
 
   ReadableMockPtr readable_;
-  std::mutex mx_;
-  IsObservingCallback is_observing_;
-  std::vector<std::weak_ptr<ObserverPimpl>> observers_;
+  std::shared_ptr<ObserverRegistry> registry_;
 };
 
 using ObservableMockPtr = std::shared_ptr<ObservableMock>;
+
+/**
+ * @brief Dispatches notifications to multiple ObservableMock instances as a
+ * single synchronized step
+ *
+ * The notification lock of each involved ObservableMock is acquired exactly
+ * once, before any value is dispatched, so no other notification can
+ * interleave with the given ones. Notifications are dispatched in the given
+ * order, multiple notifications for the same ObservableMock are allowed
+ *
+ * @attention Observers must not notify any of the involved ObservableMock
+ * instances from within their callbacks, doing so deadlocks
+ *
+ * @throws std::invalid_argument - if a given ObservableMockPtr is empty
+ * @throws any exception thrown by an Observer exception handler. Notifications
+ * after the failed one are not dispatched
+ *
+ * @param notifications
+ */
+void notifyTogether(
+    const std::vector<std::pair<ObservableMockPtr, DataVariant>>&
+        notifications);
 } // namespace Information_Model::testing
 #endif //__STAG_INFORMATION_MODEL_MOCKS_OBSERVABLE_MOCK_HPP
\ No newline at end of file
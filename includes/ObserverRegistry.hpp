@@ -0,0 +1,253 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_OBSERVER_REGISTRY_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_OBSERVER_REGISTRY_HPP
+#include "LatencyHistogram.hpp"
+#include "WorkerPool.hpp"
+
+#include <Information_Model/Observable.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace Information_Model::testing {
+
+struct ObserverPimpl : virtual public Observer {
+  ~ObserverPimpl() override = default;
+
+  virtual void dispatch(const std::shared_ptr<DataVariant>& value) = 0;
+};
+
+/**
+ * @brief Notification latencies of a single Observer
+ *
+ */
+struct ObserverLatency {
+  /**
+   * @brief Time between the ObservableMock::notify() call and the moment the
+   * notification was handed to the Observer
+   *
+   */
+  LatencyHistogram notify_to_dispatch;
+  /**
+   * @brief Time the Observer callback took to return
+   *
+   */
+  LatencyHistogram dispatch_to_return;
+};
+
+/**
+ * @brief Reporting filter, that is evaluated for each notification before it
+ * is dispatched to the filtered Observer
+ *
+ * The first notification is always dispatched. Every following notification
+ * is compared against the last notification, that was dispatched to the same
+ * Observer, and is dropped if any of the configured conditions is not met
+ *
+ */
+struct NotificationFilter {
+  /**
+   * @brief Only dispatch notifications, that differ from the last dispatched
+   * value
+   *
+   */
+  bool on_change = false;
+  /**
+   * @brief Only dispatch numeric notifications, that differ from the last
+   * dispatched value by more than the given amount
+   *
+   */
+  std::optional<double> absolute_deadband = std::nullopt;
+  /**
+   * @brief Only dispatch numeric notifications, that differ from the last
+   * dispatched value by more than the given percentage of the last dispatched
+   * value
+   *
+   */
+  std::optional<double> percent_deadband = std::nullopt;
+  /**
+   * @brief Only dispatch notifications, if at least the given amount of time
+   * has passed since the last dispatched notification. Notifications that
+   * arrive sooner are dropped, not delayed
+   *
+   */
+  std::chrono::nanoseconds min_interval = std::chrono::nanoseconds::zero();
+};
+
+struct FilterState;
+struct LatencyRecord;
+struct PayloadPool;
+
+/**
+ * @brief Tracks the Observers of a single observable and dispatches
+ * notifications to them
+ *
+ * Shared by ObservableMock and ObservableFake, so both track, filter and
+ * notify Observers the same way. Observers only keep a weak reference to
+ * their registry, so they can outlive it
+ *
+ * @attention Must be owned by a std::shared_ptr
+ *
+ */
+struct ObserverRegistry
+    : public std::enable_shared_from_this<ObserverRegistry> {
+  using IsObservingCallback = std::function<void(bool)>;
+  using Clock = std::chrono::steady_clock;
+
+  ObserverRegistry();
+
+  ~ObserverRegistry();
+
+  ObserverRegistry(const ObserverRegistry&) = delete;
+  ObserverRegistry& operator=(const ObserverRegistry&) = delete;
+
+  /**
+   * @brief Sets the callback, that is called with true when the first
+   * Observer is attached and with false when the last one is released
+   *
+   * Calls are made in transition order and without holding any lock, so the
+   * callback may attach or release Observers itself. If another thread is
+   * already calling the callback, that thread also makes the call for a
+   * transition caused by this thread
+   *
+   * Exceptions thrown for an attached Observer are rethrown by attach(), the
+   * Observer is released again. Exceptions thrown for a released Observer are
+   * discarded, since Observers are released by their destructors
+   *
+   * @param callback
+   */
+  void setObservingCallback(const IsObservingCallback& callback);
+
+  /**
+   * @brief Attaches a new Observer, that only receives the notifications
+   * which pass the given filter, if one is given
+   *
+   * @throws std::invalid_argument - if callback or handler are empty
+   *
+   * @param callback
+   * @param handler
+   * @param filter
+   * @return ObserverPtr
+   */
+  ObserverPtr attach(const Observable::ObserveCallback& callback,
+      const Observable::ExceptionHandler& handler,
+      const std::optional<NotificationFilter>& filter);
+
+  /**
+   * @brief Same as @ref ObservableMock::notify(const DataVariant&)
+   *
+   * @param value
+   */
+  void dispatch(const DataVariant& value);
+
+  /**
+   * @brief Same as @ref ObservableMock::notify(DataVariant&&)
+   *
+   * @param value
+   */
+  void dispatch(DataVariant&& value);
+
+  /**
+   * @brief Locks the notification locks of all given registries, in address
+   * order, so concurrent calls do not deadlock. Each registry is locked once,
+   * even if it is given multiple times
+   *
+   * @param registries
+   * @return std::vector<std::unique_lock<std::mutex>>
+   */
+  static std::vector<std::unique_lock<std::mutex>> lockDispatch(
+      std::vector<ObserverRegistry*> registries);
+
+  /**
+   * @brief Same as dispatch(), but requires the caller to hold the lock
+   * returned by lockDispatch() and timestamps latencies from the given time
+   *
+   */
+  void dispatchLocked(const DataVariant& value, Clock::time_point notified_at);
+
+  void dispatchLocked(DataVariant&& value, Clock::time_point notified_at);
+
+  /**
+   * @brief Same as @ref ObservableMock::enableParallelDispatch()
+   *
+   * @param pool
+   */
+  void setWorkerPool(const WorkerPoolPtr& pool);
+
+  /**
+   * @brief Same as @ref ObservableMock::enableLatencyTracking()
+   *
+   * @param enable
+   */
+  void enableLatencyTracking(bool enable);
+
+  /**
+   * @brief Same as @ref ObservableMock::latencies()
+   *
+   * @return std::vector<ObserverLatency>
+   */
+  std::vector<ObserverLatency> latencies();
+
+private:
+  friend struct FakeObserver;
+
+  struct Slot {
+    std::weak_ptr<ObserverPimpl> observer;
+    std::shared_ptr<FilterState> filter;
+    std::shared_ptr<LatencyRecord> latency;
+  };
+
+  struct LiveObserver {
+    std::shared_ptr<ObserverPimpl> observer;
+    std::shared_ptr<FilterState> filter;
+    std::shared_ptr<LatencyRecord> latency;
+  };
+
+  size_t attachSlot(const std::shared_ptr<ObserverPimpl>& observer,
+      const std::optional<NotificationFilter>& filter);
+
+  void release(size_t slot);
+
+  void deliverTransitions();
+
+  template <typename Value> void dispatchValue(Value&& value);
+
+  template <typename Value>
+  void dispatchValueLocked(Value&& value, Clock::time_point notified_at);
+
+  void applyFilters(const DataVariant& value);
+
+  std::shared_ptr<LatencyRecord> makeLatencyRecord();
+
+  void foldReleasedLatencies();
+
+  static void dispatchTo(const LiveObserver& live,
+      const std::shared_ptr<DataVariant>& payload,
+      Clock::time_point notified_at);
+
+  std::mutex mx_;
+  IsObservingCallback is_observing_;
+  // observing transitions are queued in order under mx_ and delivered by one
+  // thread at a time
+  std::deque<bool> transitions_;
+  bool delivering_ = false;
+  std::vector<Slot> slots_;
+  std::vector<size_t> free_slots_;
+  size_t active_ = 0;
+  // records of released observers are kept, so they can still be exported
+  std::vector<std::shared_ptr<LatencyRecord>> latencies_;
+  size_t released_latencies_ = 0;
+  std::atomic<bool> tracking_ = false;
+  std::mutex dispatch_mx_;
+  std::vector<LiveObserver> live_;
+  std::shared_ptr<PayloadPool> payloads_;
+  WorkerPoolPtr pool_;
+};
+
+using ObserverRegistryPtr = std::shared_ptr<ObserverRegistry>;
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_OBSERVER_REGISTRY_HPP
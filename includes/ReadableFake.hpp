@@ -0,0 +1,62 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_READABLE_FAKE_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_READABLE_FAKE_HPP
+#include "ReadableMock.hpp"
+#include "ReadableState.hpp"
+
+#include <Information_Model/Readable.hpp>
+
+namespace Information_Model::testing {
+
+/**
+ * @brief Plain Readable implementation without any gmock machinery
+ *
+ * Behaves like a NiceMock<ReadableMock> with the same constructor arguments,
+ * but read() and dataType() calls are direct virtual calls, that take no locks
+ * and do not search for expectations. Calls can not be expected or counted
+ *
+ */
+struct ReadableFake : virtual public Readable {
+  using ReadCallback = ReadableMock::ReadCallback;
+
+  ReadableFake() = default;
+
+  explicit ReadableFake(DataType type);
+
+  explicit ReadableFake(const DataVariant& value);
+
+  ReadableFake(DataType type, const ReadCallback& read_cb);
+
+  ~ReadableFake() override = default;
+
+  /**
+   * @brief Same as @ref ReadableMock::updateType()
+   *
+   * @param type
+   */
+  void updateType(DataType type);
+
+  /**
+   * @brief Same as @ref ReadableMock::updateValue()
+   *
+   * @param value
+   */
+  void updateValue(const DataVariant& value);
+
+  /**
+   * @brief Same as @ref ReadableMock::updateReadCallback()
+   *
+   * @param read_cb
+   */
+  void updateReadCallback(const ReadCallback& read_cb);
+
+  DataType dataType() const final;
+
+  DataVariant read() const final;
+
+private:
+  ReadableState state_;
+};
+
+using ReadableFakePtr = std::shared_ptr<ReadableFake>;
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_READABLE_FAKE_HPP
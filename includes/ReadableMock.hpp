@@ -1,16 +1,16 @@
 #ifndef __STAG_INFORMATION_MODEL_MOCKS_READABLE_MOCK_HPP
 #define __STAG_INFORMATION_MODEL_MOCKS_READABLE_MOCK_HPP
+#include "ReadableState.hpp"
+
 #include <Information_Model/Readable.hpp>
 #include <gmock/gmock.h>
 
-#include <optional>
-
 namespace Information_Model::testing {
 
 struct ReadableMock : virtual public Readable {
-  using ReadCallback = std::function<DataVariant()>;
+  using ReadCallback = ReadableState::ReadCallback;
 
-  ReadableMock() = default;
+  ReadableMock();
 
   explicit ReadableMock(DataType type);
 
@@ -23,7 +23,11 @@ struct ReadableMock : virtual public Readable {
   /**
    * @brief Change the modeled data type
    *
-   * Sets the result of dataType() method calls
+   * Sets the result of dataType() method calls. Like all other update methods,
+   * only changes the state, that the default actions registered on
+   * construction consult, so any number of updates can be made without
+   * growing the mock. Update methods can be called while other threads call
+   * dataType() or read(), see @ref ReadableState
    *
    * @param type
    */
@@ -53,9 +57,9 @@ struct ReadableMock : virtual public Readable {
   MOCK_METHOD(DataVariant, read, (), (const final));
 
 private:
-  DataType type_ = DataType::Boolean;
-  std::optional<DataVariant> value_;
-  ReadCallback read_;
+  void setDefaultCalls();
+
+  ReadableState state_;
 };
 
 using ReadableMockPtr = std::shared_ptr<ReadableMock>;
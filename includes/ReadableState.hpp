@@ -0,0 +1,111 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_READABLE_STATE_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_READABLE_STATE_HPP
+#include <Information_Model/Readable.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace Information_Model::testing {
+
+/**
+ * @brief Modeled data type and read() source of ReadableMock and ReadableFake
+ * instances
+ *
+ * Trivially copyable values (Boolean, Integer, Unsigned Integer, Double and
+ * Timestamp) are published through a sequence lock. Readers copy them without
+ * taking any lock and retry if an update was in progress, so read() never
+ * blocks on updateValue() and such updates do not allocate
+ *
+ * String and Opaque values and read callbacks are published as immutable
+ * snapshots by atomically swapping a shared pointer. Readers always see
+ * either the previous or the new snapshot as a whole and never wait for a
+ * value to be copied
+ *
+ * @attention std::atomic_load() and std::atomic_store() of a shared pointer
+ * are not lock-free on common standard libraries, so readers and writers of
+ * snapshots briefly serialize on the pointer swap
+ *
+ * @attention dataType() and read() results of the same update become visible
+ * one after another, a reader can observe the new value with the previous
+ * data type
+ *
+ */
+struct ReadableState {
+  using ReadCallback = std::function<DataVariant()>;
+
+  ReadableState() = default;
+
+  explicit ReadableState(DataType type);
+
+  ReadableState(const ReadableState&) = delete;
+  ReadableState& operator=(const ReadableState&) = delete;
+
+  DataType type() const;
+
+  /**
+   * @brief Returns the last updated value, or calls the last updated read
+   * callback
+   *
+   * Returns an empty DataVariant if neither was set
+   *
+   * @throws ReadCallbackUnavailable - if the last updated read callback was
+   * empty
+   *
+   * @return DataVariant
+   */
+  DataVariant read() const;
+
+  void updateType(DataType type);
+
+  /**
+   * @brief Publishes the given value and its data type
+   *
+   * @attention Replaces the last updated read callback
+   *
+   * @param value
+   */
+  void updateValue(const DataVariant& value);
+
+  /**
+   * @brief Publishes the given read callback
+   *
+   * @attention Replaces the last updated value
+   *
+   * @param read_cb
+   */
+  void updateReadCallback(const ReadCallback& read_cb);
+
+private:
+  struct Source {
+    std::optional<DataVariant> value;
+    ReadCallback read;
+    bool unavailable = false;
+  };
+
+  using SourcePtr = std::shared_ptr<const Source>;
+  // large enough for every trivially copyable DataVariant alternative
+  using Words = std::array<std::atomic<uint64_t>, 2>;
+
+  enum class SourceKind : uint8_t { Empty, Trivial, Snapshot };
+
+  void publish(SourceKind kind, size_t index, const uint64_t* words);
+
+  std::atomic<DataType> type_ = DataType::Boolean;
+  // odd while an update is in progress
+  std::atomic<uint64_t> sequence_ = 0;
+  std::atomic<SourceKind> kind_ = SourceKind::Empty;
+  std::atomic<size_t> trivial_index_ = 0;
+  Words trivial_words_ = {};
+  // serializes updates, readers never take it
+  std::mutex update_mx_;
+  // empty until the first snapshot update, to keep unused instances
+  // allocation free
+  SourcePtr source_;
+};
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_READABLE_STATE_HPP
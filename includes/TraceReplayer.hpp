@@ -0,0 +1,188 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_TRACE_REPLAYER_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_TRACE_REPLAYER_HPP
+#include "LatencyHistogram.hpp"
+#include "ObservableMock.hpp"
+
+#include <Information_Model/Device.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Information_Model::testing {
+
+struct MalformedTrace : public std::runtime_error {
+  MalformedTrace(
+      const std::string& trace_path, size_t position, const std::string& reason)
+      : std::runtime_error("Malformed trace " + trace_path + " at byte " +
+            std::to_string(position) + ": " + reason) {}
+};
+
+/**
+ * @brief Summary of a single TraceReplayer::replay() run
+ *
+ */
+struct ReplayReport {
+  /**
+   * @brief Number of values, that were notified
+   *
+   */
+  size_t dispatched = 0;
+  /**
+   * @brief Number of values, that belonged to unmapped trace columns
+   *
+   */
+  size_t skipped = 0;
+  /**
+   * @brief Wall clock time the replay took
+   *
+   */
+  std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
+  /**
+   * @brief Delay between the scheduled and the actual dispatch time of each
+   * notified value. Empty for TraceReplayer::MAX_SPEED replays
+   *
+   */
+  LatencyHistogram lag;
+};
+
+/**
+ * @brief Replays recorded telemetry traces as ObservableMock and
+ * ObservableFake notifications
+ *
+ * Traces are memory-mapped and read sequentially, pages that were already
+ * replayed are handed back to the operating system, so traces may be larger
+ * than the available memory. Two trace formats are supported, the format is
+ * detected from the first bytes of the trace file:
+ *
+ * CSV traces start with a header row, that names the timestamp column
+ * followed by the value column names. Each following row holds a timestamp in
+ * nanoseconds and a value for each column. Empty cells are skipped. Cells may
+ * be enclosed in double quotes, quotes within quoted cells are escaped by
+ * doubling them. Values are parsed according to the data type of the
+ * ObservableMock or ObservableFake the column is mapped to:
+ *  - Boolean as true, false, 1 or 0
+ *  - Integer, Unsigned_Integer and Double as decimal numbers
+ *  - Timestamp as YYYY-MM-DDTHH:MM:SS.ffffff
+ *  - Opaque as hex encoded bytes
+ *  - String as is
+ *
+ * Binary traces are written by the BinaryTraceWriter and are self describing
+ *
+ * Timestamps must not decrease throughout the trace
+ *
+ */
+struct TraceReplayer {
+  using ColumnMapping = std::unordered_map<std::string, std::string>;
+
+  /**
+   * @brief Replays the trace as fast as possible, without pacing
+   *
+   */
+  static constexpr double MAX_SPEED = std::numeric_limits<double>::infinity();
+
+  /**
+   * @brief Maps a given trace file and resolves the given column name to
+   * element id mapping. Trace columns without a mapping are skipped
+   *
+   * @throws std::invalid_argument - if the trace file can not be opened, if a
+   * mapped column does not exist within the trace, or if a mapped element is
+   * neither an ObservableMock nor an ObservableFake
+   * @throws MalformedTrace - if the trace header is malformed
+   * @throws ElementNotFound - if a mapped element does not exist
+   *
+   * @param trace_path
+   * @param device
+   * @param mapping - trace column name to element id mapping
+   */
+  TraceReplayer(const std::string& trace_path,
+      const Device& device,
+      const ColumnMapping& mapping);
+
+  ~TraceReplayer();
+
+  /**
+   * @brief Notifies every mapped trace value to its ObservableMock or
+   * ObservableFake and blocks until the whole trace was replayed or stop() was
+   * called
+   *
+   * The first trace value is notified immediately, every following value is
+   * notified once the time difference to the first timestamp, divided by the
+   * given speed, has passed. Replays can be repeated, each replay starts from
+   * the beginning of the trace
+   *
+   * @throws std::invalid_argument - if the given speed is not positive
+   * @throws MalformedTrace - if the trace contains malformed records
+   *
+   * @param speed - pace scaling factor, 1 replays the trace at its original
+   * pace, 10 replays it ten times faster
+   * @return ReplayReport
+   */
+  ReplayReport replay(double speed = 1.0);
+
+  /**
+   * @brief Stops the ongoing replay() call, can be called from any thread
+   *
+   * If no replay is ongoing, the next replay() call stops before notifying
+   * any value
+   *
+   */
+  void stop();
+
+private:
+  struct Pimpl;
+  std::unique_ptr<Pimpl> pimpl_;
+};
+
+/**
+ * @brief Writes binary traces, that can be replayed by the TraceReplayer
+ *
+ * Binary traces start with the STAGTRC1 magic bytes, followed by the number of
+ * columns as uint32 and each column name prefixed with its uint16 length. Each
+ * record holds the int64 timestamp in nanoseconds, the uint32 column index,
+ * the uint8 DataType of the value and the value itself. Opaque and String
+ * values are prefixed with their uint32 length. All numbers are stored in
+ * host byte order
+ *
+ */
+struct BinaryTraceWriter {
+  /**
+   * @throws std::invalid_argument - if the trace file can not be created or a
+   * column name is longer than 65535 characters
+   *
+   * @param trace_path
+   * @param columns
+   */
+  BinaryTraceWriter(
+      const std::string& trace_path, const std::vector<std::string>& columns);
+
+  /**
+   * @brief Appends a single value record
+   *
+   * @throws std::invalid_argument - if the given column does not exist
+   *
+   * @param timestamp
+   * @param column - column index
+   * @param value
+   */
+  void write(std::chrono::nanoseconds timestamp,
+      size_t column,
+      const DataVariant& value);
+
+  /**
+   * @brief Writes all buffered records to the trace file
+   *
+   */
+  void flush();
+
+private:
+  std::ofstream trace_;
+  size_t column_count_;
+};
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_TRACE_REPLAYER_HPP
@@ -0,0 +1,70 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_WORKER_POOL_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_WORKER_POOL_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace Information_Model::testing {
+
+/**
+ * @brief A work-stealing thread pool, used by the mocks to fan out work
+ * (for example notification dispatching) across multiple cores
+ *
+ * Each worker owns a task queue and steals tasks from the other queues once
+ * its own queue runs empty. The thread that calls parallelFor() also executes
+ * queued tasks while it waits, so parallelFor() may be nested
+ *
+ */
+struct WorkerPool {
+  using Task = std::function<void(size_t)>;
+
+  /**
+   * @brief Starts a worker thread for each available core, except the one
+   * used by the calling thread
+   *
+   */
+  WorkerPool();
+
+  /**
+   * @brief Starts a given number of worker threads. A pool without workers
+   * runs all tasks on the calling thread
+   *
+   * @param worker_count
+   */
+  explicit WorkerPool(size_t worker_count);
+
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  /**
+   * @brief Returns the number of worker threads
+   *
+   * @return size_t
+   */
+  size_t size() const;
+
+  /**
+   * @brief Calls the given task for every index in range [0, count) and blocks
+   * until all of the calls have returned. The index range is partitioned into
+   * contiguous chunks, each chunk is executed by a single thread in ascending
+   * index order
+   *
+   * @throws any exception thrown by the given task. If multiple tasks throw,
+   * only the first exception is rethrown
+   *
+   * @param count
+   * @param task
+   */
+  void parallelFor(size_t count, const Task& task);
+
+private:
+  struct Pimpl;
+  std::unique_ptr<Pimpl> pimpl_;
+};
+
+using WorkerPoolPtr = std::shared_ptr<WorkerPool>;
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_WORKER_POOL_HPP
@@ -0,0 +1,96 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_WRITABLE_FAKE_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_WRITABLE_FAKE_HPP
+#include "ReadableFake.hpp"
+#include "WritableMock.hpp"
+
+#include <Information_Model/Writable.hpp>
+
+#include <atomic>
+#include <memory>
+
+namespace Information_Model::testing {
+
+/**
+ * @brief Plain Writable implementation without any gmock machinery
+ *
+ * Behaves like a NiceMock<WritableMock> with the same constructor arguments,
+ * see @ref ReadableFake for the differences
+ *
+ */
+struct WritableFake : public Writable {
+  using ReadCallback = WritableMock::ReadCallback;
+  using WriteCallback = WritableMock::WriteCallback;
+
+  WritableFake() = default;
+
+  explicit WritableFake(DataType type);
+
+  WritableFake(DataType type, const ReadCallback& read_cb);
+
+  explicit WritableFake(const DataVariant& value);
+
+  WritableFake(DataType type, const WriteCallback& write_cb);
+
+  WritableFake(DataType type, const ReadCallback& read_cb,
+      const WriteCallback& write_cb);
+
+  ~WritableFake() override = default;
+
+  void setWriteOnly(bool write_only);
+
+  /**
+   * @brief Same as @ref WritableMock::updateType()
+   *
+   * @param type
+   */
+  void updateType(DataType type);
+
+  /**
+   * @brief Same as @ref WritableMock::updateValue()
+   *
+   * @param value
+   */
+  void updateValue(const DataVariant& value);
+
+  /**
+   * @brief Same as @ref WritableMock::updateReadCallback()
+   *
+   * @param read_cb
+   */
+  void updateReadCallback(const ReadCallback& read_cb);
+
+  /**
+   * @brief Same as @ref WritableMock::updateWriteCallback()
+   *
+   * @param write_cb
+   */
+  void updateWriteCallback(const WriteCallback& write_cb);
+
+  /**
+   * @brief Same as @ref WritableMock::updateCallbacks()
+   *
+   * @param read_cb
+   * @param write_cb
+   */
+  void updateCallbacks(
+      const ReadCallback& read_cb, const WriteCallback& write_cb);
+
+  DataType dataType() const final;
+
+  DataVariant read() const final;
+
+  bool isWriteOnly() const final;
+
+  void write(const DataVariant& value) const final;
+
+private:
+  ReadableFake readable_;
+  std::atomic<bool> write_only_ = false;
+  // swapped atomically, so callbacks can be updated while other threads
+  // write, write() calls do nothing until a write callback is given
+  std::shared_ptr<const WriteCallback> write_;
+};
+
+using WritableFakePtr = std::shared_ptr<WritableFake>;
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_WRITABLE_FAKE_HPP
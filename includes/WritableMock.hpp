@@ -4,13 +4,15 @@
 
 #include <Information_Model/Writable.hpp>
 
+#include <atomic>
+
 namespace Information_Model::testing {
 
 struct WritableMock : public Writable {
   using ReadCallback = ReadableMock::ReadCallback;
   using WriteCallback = std::function<void(const DataVariant&)>;
 
-  WritableMock() = default;
+  WritableMock();
 
   explicit WritableMock(DataType type);
 
@@ -82,9 +84,15 @@ struct WritableMock : public Writable {
   MOCK_METHOD(void, write, (const DataVariant&), (const final));
 
 private:
-  void setReadableCalls() const;
+  void setDefaultCalls();
+
+  void writeValue(const DataVariant& value) const;
 
+  // mutable, since setWriteOnly() is const
+  mutable std::atomic<bool> write_only_ = false;
   WriteCallback write_;
+  // write() calls are ignored until a write callback is set
+  bool write_set_ = false;
   ReadableMockPtr readable_;
 };
 
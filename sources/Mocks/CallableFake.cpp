@@ -0,0 +1,121 @@
+#include "CallableFake.hpp"
+
+namespace Information_Model::testing {
+using namespace std;
+
+CallableFake::CallableFake(const ExecutorPtr& executor) : executor_(executor) {}
+
+CallableFake::CallableFake(DataType result_type,
+    const ParameterTypes& supported_params,
+    const Executor::Response& default_response)
+    : result_type_(result_type), supported_params_(supported_params),
+      default_response_(default_response),
+      executor_(makeExecutor(
+          result_type_, supported_params_, default_response_, 100ms)) {}
+
+CallableFake::CallableFake(
+    const ExecuteCallback& execute_cb, const ParameterTypes& supported_params)
+    : execute_cb_(execute_cb), supported_params_(supported_params),
+      use_callbacks_(true) {}
+
+CallableFake::CallableFake(DataType result_type,
+    const ExecuteCallback& execute_cb,
+    const AsyncExecuteCallback& async_execute_cb,
+    const CancelCallback& cancel_cb, const ParameterTypes& supported_params)
+    : result_type_(result_type), execute_cb_(execute_cb),
+      async_execute_cb_(async_execute_cb), cancel_cb_(cancel_cb),
+      supported_params_(supported_params), use_callbacks_(true) {}
+
+void CallableFake::checkAvailable() const {
+  if (!use_callbacks_ && !executor_) {
+    throw ExecutorNotAvailable();
+  }
+}
+
+void CallableFake::checkReturning() const {
+  checkAvailable();
+  if (use_callbacks_ && result_type_ == DataType::None) {
+    throw ResultReturningNotSupported();
+  }
+}
+
+void CallableFake::execute(const Parameters& parameters) const {
+  checkAvailable();
+  if (use_callbacks_) {
+    execute_cb_(parameters);
+  } else {
+    executor_->execute(parameters);
+  }
+}
+
+DataVariant CallableFake::call(uintmax_t timeout) const {
+  return call(makeDefaultParams(supported_params_), timeout);
+}
+
+DataVariant CallableFake::call(
+    const Parameters& parameters, uintmax_t timeout) const {
+  auto result = asyncCall(parameters);
+  auto status = result.waitFor(chrono::milliseconds(timeout));
+  if (status == future_status::ready) {
+    return result.get();
+  } else {
+    throw CallTimedout(use_callbacks_ ? "External Executor"
+                                      : "CallableFake Executor");
+  }
+}
+
+ResultFuture CallableFake::asyncCall(const Parameters& parameters) const {
+  checkReturning();
+  if (use_callbacks_) {
+    return async_execute_cb_(parameters);
+  } else {
+    return executor_->asyncCall(parameters);
+  }
+}
+
+void CallableFake::cancelAsyncCall(uintmax_t call_id) const {
+  checkReturning();
+  if (use_callbacks_) {
+    cancel_cb_(call_id);
+  } else {
+    executor_->cancel(call_id);
+  }
+}
+
+DataType CallableFake::resultType() const {
+  return use_callbacks_ || !executor_ ? result_type_ : executor_->resultType();
+}
+
+ParameterTypes CallableFake::parameterTypes() const {
+  return use_callbacks_ || !executor_ ? supported_params_
+                                      : executor_->parameterTypes();
+}
+
+ExecutorPtr CallableFake::getExecutor() const {
+  if (!executor_) {
+    throw logic_error("External callbacks are used instead of the executor");
+  }
+  return executor_;
+}
+
+void CallableFake::changeExecutor(const ExecutorPtr& executor) {
+  if (executor_) {
+    executor_->cancelAll();
+  }
+  executor_ = executor;
+  use_callbacks_ = false;
+}
+
+void CallableFake::useDefaultExecutor() {
+  executor_ =
+      makeExecutor(result_type_, supported_params_, default_response_, 100ms);
+  use_callbacks_ = false;
+}
+
+void CallableFake::useDefaultCallbacks() {
+  if (!execute_cb_) {
+    throw logic_error("Default callbacks not set");
+  }
+  use_callbacks_ = true;
+}
+} // namespace Information_Model::testing
@@ -0,0 +1,108 @@
+#include "DataVariantParser.hpp"
+
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+
+template <typename Number> Number parseNumber(string_view text) {
+  Number result{};
+  auto [end, error] = from_chars(text.data(), text.data() + text.size(), result);
+  if (error != errc() || end != text.data() + text.size()) {
+    throw invalid_argument("Invalid number " + string(text));
+  }
+  return result;
+}
+
+double parseDouble(string_view text) {
+  // strtod requires a null terminated string
+  constexpr size_t MAX_DOUBLE_LENGTH = 64;
+  char buffer[MAX_DOUBLE_LENGTH + 1];
+  if (text.empty() || text.size() > MAX_DOUBLE_LENGTH) {
+    throw invalid_argument("Invalid number " + string(text));
+  }
+  memcpy(buffer, text.data(), text.size());
+  buffer[text.size()] = '\0';
+  char* end = nullptr;
+  auto result = strtod(buffer, &end);
+  if (end != buffer + text.size()) {
+    throw invalid_argument("Invalid number " + string(text));
+  }
+  return result;
+}
+
+uint8_t parseHexDigit(char digit) {
+  if (digit >= '0' && digit <= '9') {
+    return static_cast<uint8_t>(digit - '0');
+  } else if (digit >= 'a' && digit <= 'f') {
+    return static_cast<uint8_t>(digit - 'a' + 10);
+  } else if (digit >= 'A' && digit <= 'F') {
+    return static_cast<uint8_t>(digit - 'A' + 10);
+  } else {
+    throw invalid_argument("Invalid hex digit " + string(1, digit));
+  }
+}
+
+DataVariant parseDataVariant(string_view text, DataType type) {
+  switch (type) {
+  case DataType::Boolean: {
+    if (text == "true" || text == "1") {
+      return true;
+    } else if (text == "false" || text == "0") {
+      return false;
+    }
+    throw invalid_argument("Invalid boolean " + string(text));
+  }
+  case DataType::Integer: {
+    return parseNumber<intmax_t>(text);
+  }
+  case DataType::Unsigned_Integer: {
+    return parseNumber<uintmax_t>(text);
+  }
+  case DataType::Double: {
+    return parseDouble(text);
+  }
+  case DataType::Timestamp: {
+    Timestamp timestamp{};
+    auto component = [&text](size_t offset, size_t length) {
+      if (text.size() < offset + length) {
+        throw invalid_argument("Invalid timestamp " + string(text));
+      }
+      return parseNumber<uint32_t>(text.substr(offset, length));
+    };
+    // YYYY-MM-DDTHH:MM:SS.ffffff
+    timestamp.year = static_cast<uint16_t>(component(0, 4));
+    timestamp.month = static_cast<uint8_t>(component(5, 2));
+    timestamp.day = static_cast<uint8_t>(component(8, 2));
+    timestamp.hours = static_cast<uint8_t>(component(11, 2));
+    timestamp.minutes = static_cast<uint8_t>(component(14, 2));
+    timestamp.seconds = static_cast<uint8_t>(component(17, 2));
+    timestamp.microseconds = component(20, 6);
+    return timestamp;
+  }
+  case DataType::Opaque: {
+    if (text.size() % 2 != 0) {
+      throw invalid_argument("Odd number of hex digits");
+    }
+    vector<uint8_t> bytes;
+    bytes.reserve(text.size() / 2);
+    for (size_t i = 0; i < text.size(); i += 2) {
+      bytes.push_back(static_cast<uint8_t>(
+          parseHexDigit(text[i]) << 4 | parseHexDigit(text[i + 1])));
+    }
+    return bytes;
+  }
+  case DataType::String: {
+    return string(text);
+  }
+  default: {
+    throw invalid_argument("Can not parse " + toString(type) + " values");
+  }
+  }
+}
+} // namespace Information_Model::testing
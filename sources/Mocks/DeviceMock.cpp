@@ -1,4 +1,7 @@
 #include "DeviceMock.hpp"
+#include "IdPath.hpp"
+
+#include <functional>
 
 namespace Information_Model::testing {
 using namespace std;
@@ -7,7 +10,8 @@ using namespace ::testing;
 DeviceMock::DeviceMock(
     const string& base_id, const optional<FullMetaInfo>& meta)
     : MetaInfoMock(base_id, meta),
-      group_(make_shared<NiceMock<GroupMock>>(base_id + ":")) {
+      group_(make_shared<NiceMock<GroupMock>>(
+          base_id + IdPath::DEVICE_SEPARATOR)) {
   ON_CALL(*this, group).WillByDefault(Return(group_));
   ON_CALL(*this, size).WillByDefault(Invoke(group_.get(), &Group::size));
   ON_CALL(*this, element).WillByDefault(Invoke(group_.get(), &Group::element));
@@ -16,8 +20,135 @@ DeviceMock::DeviceMock(
 
 string DeviceMock::generateID() { return group_->generateID(); }
 
+vector<string> DeviceMock::generateIDs(size_t count) {
+  return group_->generateIDs(count);
+}
+
 void DeviceMock::addElement(const ElementPtr& element) {
   group_->addElement(element);
 }
 
-} // namespace Information_Model::testing
\ No newline at end of file
+void DeviceMock::addElements(
+    const vector<string>& ids, const vector<ElementPtr>& elements) {
+  group_->addElements(ids, elements);
+}
+
+size_t DeviceMock::addElements(
+    size_t count, const GroupMock::ElementFactory& factory) {
+  return group_->addElements(count, factory);
+}
+
+size_t DeviceMock::addLazyElements(
+    size_t count, const GroupMock::ElementFactory& factory) {
+  return group_->addLazyElements(count, factory);
+}
+
+ObserverRegistryPtr DeviceMock::observers(const ObservablePtr& observable) {
+  if (auto mock = dynamic_pointer_cast<ObservableMock>(observable)) {
+    return mock->registry_;
+  }
+  if (auto fake = dynamic_pointer_cast<ObservableFake>(observable)) {
+    return fake->registry_;
+  }
+  return nullptr;
+}
+
+void DeviceMock::visitObservers(const GroupPtr& group,
+    const function<void(const string&, ObserverRegistry&)>& visitor) {
+  group->visit([&visitor](const ElementPtr& element) {
+    auto function = element->function();
+    if (holds_alternative<GroupPtr>(function)) {
+      visitObservers(get<GroupPtr>(function), visitor);
+    } else if (holds_alternative<ObservablePtr>(function)) {
+      if (auto registry = observers(get<ObservablePtr>(function))) {
+        visitor(element->id(), *registry);
+      }
+    }
+  });
+}
+
+void DeviceMock::enableLatencyTracking(bool enable) {
+  visitObservers(group_, [enable](const string&, ObserverRegistry& registry) {
+    registry.enableLatencyTracking(enable);
+  });
+}
+
+unordered_map<string, vector<ObserverLatency>>
+DeviceMock::notificationLatencies() const {
+  unordered_map<string, vector<ObserverLatency>> result;
+  visitObservers(
+      group_, [&result](const string& id, ObserverRegistry& registry) {
+        result.emplace(id, registry.latencies());
+      });
+  return result;
+}
+
+// releases the batched values on every exit, so a throwing observer does not
+// keep them alive until the next tick. Keeps the capacity for the next tick
+struct TickBatchGuard {
+  ~TickBatchGuard() { batch.clear(); }
+
+  vector<pair<ObserverRegistryPtr, DataVariant>>& batch;
+};
+
+void DeviceMock::tick(const vector<pair<string, DataVariant>>& values) {
+  scoped_lock guard(tick_mx_);
+  TickBatchGuard batch_guard{tick_batch_};
+  tick_batch_.reserve(values.size());
+  for (const auto& [ref_id, value] : values) {
+    tick_batch_.emplace_back(tickTarget(ref_id), value);
+  }
+  publishTickBatch();
+}
+
+void DeviceMock::tick(vector<pair<string, DataVariant>>&& values) {
+  scoped_lock guard(tick_mx_);
+  TickBatchGuard batch_guard{tick_batch_};
+  tick_batch_.reserve(values.size());
+  for (auto& [ref_id, value] : values) {
+    tick_batch_.emplace_back(tickTarget(ref_id), move(value));
+  }
+  publishTickBatch();
+}
+
+void DeviceMock::publishTickBatch() {
+  vector<ObserverRegistry*> registries;
+  registries.reserve(tick_batch_.size());
+  for (const auto& [registry, value] : tick_batch_) {
+    registries.push_back(registry.get());
+  }
+  auto locks = ObserverRegistry::lockDispatch(move(registries));
+  auto notified_at = ObserverRegistry::Clock::now();
+  for (auto& [registry, value] : tick_batch_) {
+    registry->dispatchLocked(move(value), notified_at);
+  }
+}
+
+const ObserverRegistryPtr& DeviceMock::tickTarget(const string& ref_id) {
+  auto it = tick_targets_.find(ref_id);
+  if (it != tick_targets_.end()) {
+    return it->second;
+  }
+  auto element = group_->element(ref_id);
+  auto registry = element->type() == ElementType::Observable
+      ? observers(get<ObservablePtr>(element->function()))
+      : nullptr;
+  if (!registry) {
+    throw invalid_argument(
+        "Element " + ref_id + " is not an ObservableMock or ObservableFake");
+  }
+  // elements can not be removed, so resolved targets stay valid
+  return tick_targets_.emplace(ref_id, move(registry)).first->second;
+}
+
+void DeviceMock::parallelVisit(
+    WorkerPool& pool, const Group::Visitor& visitor, VisitOrder order) const {
+  group_->parallelVisit(pool, visitor, order);
+}
+
+void DeviceMock::parallelVisit(WorkerPool& pool,
+    const GroupMock::PathVisitor& visitor,
+    VisitOrder order) const {
+  group_->parallelVisit(pool, visitor, order);
+}
+} // namespace Information_Model::testing
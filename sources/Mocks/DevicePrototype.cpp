@@ -0,0 +1,92 @@
+#include "DevicePrototype.hpp"
+#include "DeviceMock.hpp"
+#include "ElementFake.hpp"
+#include "ElementMock.hpp"
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+DevicePrototype::DevicePrototype(const string& base_id,
+    const BuildInfo& info,
+    optional<size_t> arena_size,
+    bool fakes)
+    : id_(base_id), info_(info), arena_size_(arena_size), fakes_(fakes),
+      groups_({make_shared<Entries>()}) {}
+
+ElementPtr makeClonedElement(bool fake, const MockArenaPtr& arena,
+    const ElementFunction& function, const string& id, const BuildInfo& info) {
+  if (fake) {
+    return makeShared<ElementFake>(
+        arena, function, id, FullMetaInfo{info.name, info.description});
+  }
+  return makeShared<NiceMock<ElementMock>>(
+      arena, function, id, FullMetaInfo{info.name, info.description});
+}
+
+unique_ptr<Device> DevicePrototype::clone(const string& base_id) const {
+  MockArenaPtr arena;
+  if (arena_size_.has_value()) {
+    arena = make_shared<MockArena>(*arena_size_);
+  }
+  auto device = make_unique<NiceMock<DeviceMock>>(
+      base_id, FullMetaInfo{info_.name, info_.description});
+  cloneGroup(*device, 0, arena);
+  return device;
+}
+
+const string& DevicePrototype::id() const { return id_; }
+
+size_t DevicePrototype::size() const {
+  size_t result = 0;
+  for (const auto& entries : groups_) {
+    result += entries->size();
+  }
+  return result;
+}
+
+size_t DevicePrototype::add(
+    size_t group, const BuildInfo& info, FunctionFactory factory) {
+  auto subgroup = NO_GROUP;
+  if (!factory) {
+    subgroup = groups_.size();
+    groups_.push_back(make_shared<Entries>());
+  }
+  groups_[group]->push_back(Entry{info, move(factory), subgroup});
+  return subgroup;
+}
+
+template <class Target>
+void DevicePrototype::cloneGroup(
+    Target& target, size_t group, const MockArenaPtr& arena) const {
+  const auto& entries = groups_[group];
+  // consecutive non group elements are added as a single lazy range
+  size_t range_begin = 0;
+  auto addRange = [this, &target, &entries, &arena, &range_begin](
+                      size_t range_end) {
+    if (range_begin < range_end) {
+      target.addLazyElements(range_end - range_begin,
+          [entries, arena, range_begin, fakes = fakes_](
+              size_t offset, const string& id) {
+            const auto& entry = (*entries)[range_begin + offset];
+            return makeClonedElement(
+                fakes, arena, entry.factory(arena), id, entry.info);
+          });
+    }
+  };
+  for (size_t position = 0; position < entries->size(); ++position) {
+    const auto& entry = (*entries)[position];
+    if (entry.group == NO_GROUP) {
+      continue;
+    }
+    addRange(position);
+    range_begin = position + 1;
+    auto id = target.generateID();
+    auto subgroup = makeShared<NiceMock<GroupMock>>(arena, id);
+    target.addElement(
+        makeClonedElement(fakes_, arena, subgroup, id, entry.info));
+    cloneGroup(*subgroup, entry.group, arena);
+  }
+  addRange(entries->size());
+}
+} // namespace Information_Model::testing
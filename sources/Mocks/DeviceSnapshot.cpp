@@ -0,0 +1,487 @@
+#include "DeviceSnapshot.hpp"
+#include "CallableMock.hpp"
+#include "DeviceMock.hpp"
+#include "ElementMock.hpp"
+#include "IdPath.hpp"
+#include "MappedFile.hpp"
+#include "ObservableMock.hpp"
+#include "ReadableMock.hpp"
+#include "WritableMock.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+constexpr string_view SNAPSHOT_MAGIC = "STAGSNP1";
+// element type, name and description lengths, data type and value kind
+constexpr size_t MIN_ELEMENT_SIZE = 11;
+// groups are indexed recursively, so deeper nesting is rejected instead of
+// exhausting the stack
+constexpr size_t MAX_GROUP_DEPTH = 256;
+
+enum class ValueKind : uint8_t { None, Value, Write_Only };
+
+struct SnapshotWriter {
+  explicit SnapshotWriter(const string& path)
+      : stream_(path, ios::binary | ios::trunc) {
+    if (!stream_) {
+      throw invalid_argument("Could not create snapshot file " + path);
+    }
+  }
+
+  void write(const Device& device) {
+    stream_.write(SNAPSHOT_MAGIC.data(), SNAPSHOT_MAGIC.size());
+    writeString(device.id());
+    writeString(device.name());
+    writeString(device.description());
+    auto count_position = stream_.tellp();
+    writeNumber(static_cast<uint32_t>(0));
+    writeGroup(device.group(), device.id() + IdPath::DEVICE_SEPARATOR);
+    stream_.seekp(count_position);
+    writeNumber(static_cast<uint32_t>(elements_));
+    stream_.seekp(0, ios::end);
+  }
+
+private:
+  template <typename Number> void writeNumber(Number value) {
+    stream_.write(reinterpret_cast<const char*>(&value), sizeof(Number));
+  }
+
+  void writeString(string_view text) {
+    writeNumber(static_cast<uint32_t>(text.size()));
+    stream_.write(text.data(), static_cast<streamsize>(text.size()));
+  }
+
+  void writeGroup(const GroupPtr& group, const string& path_id) {
+    auto elements = group->asVector();
+    writeNumber(static_cast<uint32_t>(elements.size()));
+    IdPath path(path_id);
+    for (size_t index = 0; index < elements.size(); ++index) {
+      const auto& element = elements[index];
+      if (element->id() != path.childId(index)) {
+        throw invalid_argument("Element " + element->id() +
+            " is not at its ID position, only devices with consecutive " +
+            "element IDs can be written into snapshots");
+      }
+      writeElement(element);
+    }
+  }
+
+  void writeElement(const ElementPtr& element) {
+    ++elements_;
+    writeNumber(static_cast<uint8_t>(element->type()));
+    writeString(element->name());
+    writeString(element->description());
+    switch (element->type()) {
+    case ElementType::Group: {
+      writeGroup(get<GroupPtr>(element->function()), element->id());
+      break;
+    }
+    case ElementType::Readable: {
+      auto readable = get<ReadablePtr>(element->function());
+      writeValue(readable->dataType(), readable->read());
+      break;
+    }
+    case ElementType::Writable: {
+      auto writable = get<WritablePtr>(element->function());
+      if (writable->isWriteOnly()) {
+        writeNumber(static_cast<uint8_t>(writable->dataType()));
+        writeNumber(static_cast<uint8_t>(ValueKind::Write_Only));
+      } else {
+        writeValue(writable->dataType(), writable->read());
+      }
+      break;
+    }
+    case ElementType::Observable: {
+      auto observable = get<ObservablePtr>(element->function());
+      writeValue(observable->dataType(), observable->read());
+      break;
+    }
+    case ElementType::Callable: {
+      auto callable = get<CallablePtr>(element->function());
+      writeNumber(static_cast<uint8_t>(callable->resultType()));
+      auto parameters = callable->parameterTypes();
+      writeNumber(static_cast<uint32_t>(parameters.size()));
+      for (const auto& [index, parameter] : parameters) {
+        writeNumber(static_cast<uint64_t>(index));
+        writeNumber(static_cast<uint8_t>(parameter.first));
+        writeNumber(static_cast<uint8_t>(parameter.second ? 1 : 0));
+      }
+      break;
+    }
+    }
+  }
+
+  void writeValue(DataType type, const DataVariant& value) {
+    writeNumber(static_cast<uint8_t>(type));
+    // values, that do not match the data type, can not be restored
+    if (toDataType(value) != type) {
+      writeNumber(static_cast<uint8_t>(ValueKind::None));
+      return;
+    }
+    writeNumber(static_cast<uint8_t>(ValueKind::Value));
+    visit(
+        [this](const auto& alternative) {
+          using Alternative = decay_t<decltype(alternative)>;
+          if constexpr (is_same_v<Alternative, bool>) {
+            writeNumber(static_cast<uint8_t>(alternative ? 1 : 0));
+          } else if constexpr (is_same_v<Alternative, intmax_t>) {
+            writeNumber(static_cast<int64_t>(alternative));
+          } else if constexpr (is_same_v<Alternative, uintmax_t>) {
+            writeNumber(static_cast<uint64_t>(alternative));
+          } else if constexpr (is_same_v<Alternative, double>) {
+            writeNumber(alternative);
+          } else if constexpr (is_same_v<Alternative, Timestamp>) {
+            writeNumber(alternative.year);
+            writeNumber(alternative.month);
+            writeNumber(alternative.day);
+            writeNumber(alternative.hours);
+            writeNumber(alternative.minutes);
+            writeNumber(alternative.seconds);
+            writeNumber(alternative.microseconds);
+          } else if constexpr (is_same_v<Alternative, vector<uint8_t>>) {
+            writeString(string_view(
+                reinterpret_cast<const char*>(alternative.data()),
+                alternative.size()));
+          } else {
+            writeString(alternative);
+          }
+        },
+        value);
+  }
+
+  ofstream stream_;
+  size_t elements_ = 0;
+};
+
+struct SnapshotReader {
+  SnapshotReader(const string& path, string_view content, size_t position = 0)
+      : path_(path), content_(content), position_(position) {}
+
+  size_t position() const { return position_; }
+
+  size_t remaining() const { return content_.size() - position_; }
+
+  template <typename Number> Number read() {
+    Number result;
+    memcpy(&result, readBytes(sizeof(Number)).data(), sizeof(Number));
+    return result;
+  }
+
+  string_view readBytes(size_t count) {
+    if (content_.size() - position_ < count) {
+      fail("Unexpected end of snapshot");
+    }
+    auto result = content_.substr(position_, count);
+    position_ += count;
+    return result;
+  }
+
+  string_view readString() { return readBytes(read<uint32_t>()); }
+
+  ElementType readElementType() {
+    auto type = read<uint8_t>();
+    if (type > static_cast<uint8_t>(ElementType::Callable)) {
+      fail("Unknown element type " + to_string(type));
+    }
+    return static_cast<ElementType>(type);
+  }
+
+  DataType readDataType() {
+    auto type = read<uint8_t>();
+    if (type > static_cast<uint8_t>(DataType::Unknown)) {
+      fail("Unknown data type " + to_string(type));
+    }
+    return static_cast<DataType>(type);
+  }
+
+  ValueKind readValueKind(DataType type, bool writable) {
+    auto kind = read<uint8_t>();
+    if (kind > static_cast<uint8_t>(ValueKind::Write_Only) ||
+        (kind == static_cast<uint8_t>(ValueKind::Write_Only) && !writable)) {
+      fail("Unknown value kind " + to_string(kind));
+    }
+    if (kind == static_cast<uint8_t>(ValueKind::Value) &&
+        type >= DataType::None) {
+      fail(toString(type) + " elements can not have a value");
+    }
+    return static_cast<ValueKind>(kind);
+  }
+
+  DataVariant readValue(DataType type) {
+    switch (type) {
+    case DataType::Boolean: {
+      return read<uint8_t>() != 0;
+    }
+    case DataType::Integer: {
+      return static_cast<intmax_t>(read<int64_t>());
+    }
+    case DataType::Unsigned_Integer: {
+      return static_cast<uintmax_t>(read<uint64_t>());
+    }
+    case DataType::Double: {
+      return read<double>();
+    }
+    case DataType::Timestamp: {
+      Timestamp timestamp{};
+      timestamp.year = read<uint16_t>();
+      timestamp.month = read<uint8_t>();
+      timestamp.day = read<uint8_t>();
+      timestamp.hours = read<uint8_t>();
+      timestamp.minutes = read<uint8_t>();
+      timestamp.seconds = read<uint8_t>();
+      timestamp.microseconds = read<uint32_t>();
+      return timestamp;
+    }
+    case DataType::Opaque: {
+      auto bytes = readString();
+      return vector<uint8_t>(bytes.begin(), bytes.end());
+    }
+    case DataType::String: {
+      return string(readString());
+    }
+    default: {
+      fail(toString(type) + " elements can not have a value");
+    }
+    }
+  }
+
+  void skipValue(DataType type) {
+    // only skips the bytes, without allocating
+    switch (type) {
+    case DataType::Opaque:
+      [[fallthrough]];
+    case DataType::String: {
+      readString();
+      break;
+    }
+    default: {
+      readValue(type);
+    }
+    }
+  }
+
+  [[noreturn]] void fail(const string& reason) const {
+    throw MalformedSnapshot(path_, position_, reason);
+  }
+
+private:
+  const string& path_;
+  string_view content_;
+  size_t position_;
+};
+
+template <class MockType, class... Args>
+ElementFunction makeSnapshotFunction(ValueKind kind,
+    DataType type,
+    SnapshotReader& reader,
+    Args&&... args) {
+  if (kind == ValueKind::Value) {
+    return make_shared<NiceMock<MockType>>(reader.readValue(type));
+  } else {
+    return make_shared<NiceMock<MockType>>(type, forward<Args>(args)...);
+  }
+}
+
+struct DeviceSnapshot::Pimpl {
+  static constexpr size_t NO_GROUP = numeric_limits<size_t>::max();
+
+  struct Record {
+    // position of the element type within the snapshot
+    size_t position;
+    // index of the indexed group for group elements
+    size_t group = NO_GROUP;
+  };
+
+  explicit Pimpl(const string& snapshot_path)
+      : path(snapshot_path),
+        file(snapshot_path, "snapshot", MappedFile::Access::Random) {
+    auto content = file.content();
+    SnapshotReader reader(path, content);
+    if (reader.readBytes(min(content.size(), SNAPSHOT_MAGIC.size())) !=
+        SNAPSHOT_MAGIC) {
+      throw MalformedSnapshot(path, 0, "Missing snapshot magic bytes");
+    }
+    id = reader.readString();
+    name = reader.readString();
+    description = reader.readString();
+    elements = reader.read<uint32_t>();
+    indexGroup(reader, 0);
+    if (reader.position() != content.size()) {
+      reader.fail("Unexpected data after the root group");
+    }
+    size_t indexed = 0;
+    for (const auto& group : groups) {
+      indexed += group.size();
+    }
+    if (indexed != elements) {
+      reader.fail("Snapshot holds " + to_string(indexed) + " elements, but " +
+          to_string(elements) + " were declared");
+    }
+  }
+
+  size_t indexGroup(SnapshotReader& reader, size_t depth) {
+    if (depth > MAX_GROUP_DEPTH) {
+      reader.fail("Groups are nested deeper than " +
+          to_string(MAX_GROUP_DEPTH) + " levels");
+    }
+    auto group = groups.size();
+    groups.emplace_back();
+    auto count = reader.read<uint32_t>();
+    // the count is not trusted to reserve memory, before it fits the file
+    if (count > reader.remaining() / MIN_ELEMENT_SIZE) {
+      reader.fail("Group declares " + to_string(count) +
+          " elements, but only " + to_string(reader.remaining()) +
+          " bytes remain");
+    }
+    vector<Record> records;
+    records.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+      Record record{reader.position()};
+      auto type = reader.readElementType();
+      reader.readString();
+      reader.readString();
+      switch (type) {
+      case ElementType::Group: {
+        record.group = indexGroup(reader, depth + 1);
+        break;
+      }
+      case ElementType::Callable: {
+        reader.readDataType();
+        auto parameters = reader.read<uint32_t>();
+        for (uint32_t parameter = 0; parameter < parameters; ++parameter) {
+          reader.read<uint64_t>();
+          reader.readDataType();
+          reader.read<uint8_t>();
+        }
+        break;
+      }
+      default: {
+        auto data_type = reader.readDataType();
+        auto kind =
+            reader.readValueKind(data_type, type == ElementType::Writable);
+        if (kind == ValueKind::Value) {
+          reader.skipValue(data_type);
+        }
+      }
+      }
+      records.push_back(record);
+    }
+    groups[group] = move(records);
+    return group;
+  }
+
+  FullMetaInfo readMetaInfo(SnapshotReader& reader) const {
+    auto element_name = reader.readString();
+    auto element_description = reader.readString();
+    return FullMetaInfo{
+        string(element_name), string(element_description)};
+  }
+
+  ElementPtr makeElement(size_t position, const string& element_id) const {
+    SnapshotReader reader(path, file.content(), position);
+    auto type = reader.readElementType();
+    auto meta_info = readMetaInfo(reader);
+    ElementFunction function;
+    if (type == ElementType::Callable) {
+      auto result_type = reader.readDataType();
+      ParameterTypes parameters;
+      auto count = reader.read<uint32_t>();
+      for (uint32_t parameter = 0; parameter < count; ++parameter) {
+        auto index = static_cast<uintmax_t>(reader.read<uint64_t>());
+        auto parameter_type = reader.readDataType();
+        parameters.emplace(
+            index, make_pair(parameter_type, reader.read<uint8_t>() != 0));
+      }
+      function = make_shared<NiceMock<CallableMock>>(result_type, parameters);
+    } else {
+      auto data_type = reader.readDataType();
+      auto kind =
+          reader.readValueKind(data_type, type == ElementType::Writable);
+      if (type == ElementType::Readable) {
+        function = makeSnapshotFunction<ReadableMock>(kind, data_type, reader);
+      } else if (type == ElementType::Observable) {
+        function = makeSnapshotFunction<ObservableMock>(kind, data_type, reader);
+      } else if (kind == ValueKind::Write_Only) {
+        function = make_shared<NiceMock<WritableMock>>(
+            data_type, WritableMock::WriteCallback([](const DataVariant&) {}));
+      } else {
+        function = makeSnapshotFunction<WritableMock>(kind, data_type, reader);
+      }
+    }
+    return make_shared<NiceMock<ElementMock>>(function, element_id, meta_info);
+  }
+
+  template <class Target>
+  static void loadGroup(const shared_ptr<const Pimpl>& self,
+      Target& target,
+      size_t group) {
+    const auto& records = self->groups[group];
+    // consecutive non group elements are added as a single lazy range
+    size_t range_begin = 0;
+    auto addRange = [&target, &self, group, &range_begin](size_t range_end) {
+      if (range_begin < range_end) {
+        target.addLazyElements(range_end - range_begin,
+            [self, group, range_begin](size_t offset, const string& id) {
+              return self->makeElement(
+                  self->groups[group][range_begin + offset].position, id);
+            });
+      }
+    };
+    for (size_t position = 0; position < records.size(); ++position) {
+      const auto& record = records[position];
+      if (record.group == NO_GROUP) {
+        continue;
+      }
+      addRange(position);
+      range_begin = position + 1;
+      auto id = target.generateID();
+      SnapshotReader reader(self->path, self->file.content(), record.position);
+      reader.readElementType();
+      auto subgroup = make_shared<NiceMock<GroupMock>>(id);
+      target.addElement(make_shared<NiceMock<ElementMock>>(
+          subgroup, id, self->readMetaInfo(reader)));
+      loadGroup(self, *subgroup, record.group);
+    }
+    addRange(records.size());
+  }
+
+  string path;
+  MappedFile file;
+  string id;
+  string name;
+  string description;
+  size_t elements = 0;
+  // root group first
+  vector<vector<Record>> groups;
+};
+
+void DeviceSnapshot::write(const Device& device, const string& snapshot_path) {
+  SnapshotWriter writer(snapshot_path);
+  writer.write(device);
+}
+
+DeviceSnapshot::DeviceSnapshot(const string& snapshot_path)
+    : pimpl_(make_shared<const Pimpl>(snapshot_path)) {}
+
+DeviceSnapshot::~DeviceSnapshot() = default;
+
+unique_ptr<Device> DeviceSnapshot::load() const { return load(pimpl_->id); }
+
+unique_ptr<Device> DeviceSnapshot::load(const string& base_id) const {
+  auto device = make_unique<NiceMock<DeviceMock>>(
+      base_id, FullMetaInfo{pimpl_->name, pimpl_->description});
+  Pimpl::loadGroup(pimpl_, *device, 0);
+  return device;
+}
+
+const string& DeviceSnapshot::id() const { return pimpl_->id; }
+
+size_t DeviceSnapshot::size() const { return pimpl_->elements; }
+} // namespace Information_Model::testing
@@ -0,0 +1,613 @@
+#include "DeviceSpecLoader.hpp"
+#include "DataVariantParser.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+
+constexpr size_t READ_BUFFER_SIZE = 64 * 1024;
+// number of consecutive elements handed over to MockBuilder::addElements()
+constexpr size_t BATCH_SIZE = 4096;
+
+/**
+ * @brief Pull parser, that reads JSON tokens from a stream through a fixed
+ * size buffer
+ *
+ */
+struct JsonReader {
+  enum class Scalar { String, Number, Boolean, Null };
+
+  JsonReader(istream& input, const string& source)
+      : input_(input), source_(source), buffer_(READ_BUFFER_SIZE) {}
+
+  [[noreturn]] void fail(const string& reason) const {
+    throw MalformedSpec(source_, position(), reason);
+  }
+
+  size_t position() const { return consumed_ + offset_; }
+
+  bool atEnd() { return peek() == '\0'; }
+
+  void beginObject() {
+    expect('{');
+    first_entry_.push_back(true);
+  }
+
+  void beginArray() {
+    expect('[');
+    first_entry_.push_back(true);
+  }
+
+  /**
+   * @brief Reads the key of the next object member, returns false once the
+   * closing brace was consumed
+   *
+   */
+  bool nextMember(string& key) {
+    if (!nextEntry('}')) {
+      return false;
+    }
+    readString(key);
+    expect(':');
+    return true;
+  }
+
+  /**
+   * @brief Returns false once the closing bracket of an array was consumed
+   *
+   */
+  bool nextItem() { return nextEntry(']'); }
+
+  void readString(string& result) {
+    expect('"');
+    result.clear();
+    while (true) {
+      // plain characters are appended in runs, up to the end of the buffer
+      auto run_end = offset_;
+      while (run_end < size_ && isPlain(buffer_[run_end])) {
+        ++run_end;
+      }
+      result.append(buffer_.data() + offset_, run_end - offset_);
+      offset_ = run_end;
+      auto character = get();
+      if (character == '"') {
+        return;
+      } else if (character == '\\') {
+        readEscaped(result);
+      } else if (static_cast<unsigned char>(character) < 0x20) {
+        fail("Unescaped control character within a string");
+      } else {
+        result.push_back(character);
+      }
+    }
+  }
+
+  /**
+   * @brief Reads a string, number, boolean or null value. Strings are
+   * unescaped, other values are returned as they are written
+   *
+   */
+  Scalar readScalar(string& result) {
+    auto next = peek();
+    if (next == '"') {
+      readString(result);
+      return Scalar::String;
+    } else if (next == '{' || next == '[') {
+      fail("Expected a string, number, boolean or null value");
+    }
+    readLiteral(result);
+    if (result == "null") {
+      return Scalar::Null;
+    } else if (result == "true" || result == "false") {
+      return Scalar::Boolean;
+    } else if (result[0] == '-' || (result[0] >= '0' && result[0] <= '9')) {
+      return Scalar::Number;
+    }
+    fail("Invalid literal " + result);
+  }
+
+  void skipValue() {
+    auto next = peek();
+    if (next == '{') {
+      beginObject();
+      while (nextMember(skipped_)) {
+        skipValue();
+      }
+    } else if (next == '[') {
+      beginArray();
+      while (nextItem()) {
+        skipValue();
+      }
+    } else {
+      readScalar(skipped_);
+    }
+  }
+
+private:
+  static bool isPlain(char character) {
+    return character != '"' && character != '\\' &&
+        static_cast<unsigned char>(character) >= 0x20;
+  }
+
+  // next non whitespace character, \0 at the end of input
+  char peek() {
+    while (offset_ < size_ || refill()) {
+      auto character = buffer_[offset_];
+      if (character != ' ' && character != '\n' && character != '\r' &&
+          character != '\t') {
+        return character;
+      }
+      ++offset_;
+    }
+    return '\0';
+  }
+
+  char get() {
+    if (offset_ == size_ && !refill()) {
+      fail("Unexpected end of spec");
+    }
+    return buffer_[offset_++];
+  }
+
+  bool refill() {
+    consumed_ += size_;
+    offset_ = 0;
+    input_.read(buffer_.data(), static_cast<streamsize>(buffer_.size()));
+    size_ = static_cast<size_t>(input_.gcount());
+    return size_ > 0;
+  }
+
+  void expect(char expected) {
+    auto next = peek();
+    if (next == '\0') {
+      fail("Unexpected end of spec");
+    } else if (next != expected) {
+      fail(string("Expected ") + expected);
+    }
+    ++offset_;
+  }
+
+  bool nextEntry(char closing) {
+    if (first_entry_.empty()) {
+      fail("Unbalanced brackets");
+    }
+    if (peek() == closing) {
+      ++offset_;
+      first_entry_.pop_back();
+      return false;
+    }
+    if (first_entry_.back()) {
+      first_entry_.back() = false;
+    } else {
+      expect(',');
+    }
+    return true;
+  }
+
+  void readLiteral(string& result) {
+    result.clear();
+    while (offset_ < size_ || refill()) {
+      auto character = buffer_[offset_];
+      if ((character >= 'a' && character <= 'z') ||
+          (character >= '0' && character <= '9') || character == '-' ||
+          character == '+' || character == '.' || character == 'E') {
+        result.push_back(character);
+        ++offset_;
+      } else {
+        break;
+      }
+    }
+    if (result.empty()) {
+      fail("Expected a value");
+    }
+  }
+
+  void readEscaped(string& result) {
+    auto character = get();
+    switch (character) {
+    case '"':
+    case '\\':
+    case '/': {
+      result.push_back(character);
+      break;
+    }
+    case 'b': {
+      result.push_back('\b');
+      break;
+    }
+    case 'f': {
+      result.push_back('\f');
+      break;
+    }
+    case 'n': {
+      result.push_back('\n');
+      break;
+    }
+    case 'r': {
+      result.push_back('\r');
+      break;
+    }
+    case 't': {
+      result.push_back('\t');
+      break;
+    }
+    case 'u': {
+      appendUtf8(result, readCodePoint());
+      break;
+    }
+    default: {
+      fail(string("Invalid escape sequence \\") + character);
+    }
+    }
+  }
+
+  uint32_t readHexQuad() {
+    uint32_t value = 0;
+    for (size_t i = 0; i < 4; ++i) {
+      auto digit = get();
+      value <<= 4;
+      if (digit >= '0' && digit <= '9') {
+        value |= static_cast<uint32_t>(digit - '0');
+      } else if (digit >= 'a' && digit <= 'f') {
+        value |= static_cast<uint32_t>(digit - 'a' + 10);
+      } else if (digit >= 'A' && digit <= 'F') {
+        value |= static_cast<uint32_t>(digit - 'A' + 10);
+      } else {
+        fail(string("Invalid hex digit ") + digit);
+      }
+    }
+    return value;
+  }
+
+  uint32_t readCodePoint() {
+    auto code_point = readHexQuad();
+    if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+      // high surrogate, must be followed by an escaped low surrogate
+      if (get() != '\\' || get() != 'u') {
+        fail("Unpaired surrogate");
+      }
+      auto low = readHexQuad();
+      if (low < 0xDC00 || low > 0xDFFF) {
+        fail("Unpaired surrogate");
+      }
+      code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+    }
+    return code_point;
+  }
+
+  static void appendUtf8(string& result, uint32_t code_point) {
+    if (code_point < 0x80) {
+      result.push_back(static_cast<char>(code_point));
+    } else if (code_point < 0x800) {
+      result.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+      result.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else if (code_point < 0x10000) {
+      result.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+      result.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+      result.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else {
+      result.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+      result.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+      result.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+      result.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+  }
+
+  istream& input_;
+  string source_;
+  vector<char> buffer_;
+  size_t offset_ = 0;
+  size_t size_ = 0;
+  size_t consumed_ = 0;
+  // tracks if the innermost object or array has had any entries yet
+  vector<bool> first_entry_;
+  string skipped_;
+};
+
+/**
+ * @brief Adds the time spent within its scope to a given total
+ *
+ */
+struct BuildTimer {
+  explicit BuildTimer(chrono::nanoseconds& total)
+      : total_(total), start_(chrono::steady_clock::now()) {}
+
+  ~BuildTimer() { total_ += chrono::steady_clock::now() - start_; }
+
+  BuildTimer(const BuildTimer&) = delete;
+  BuildTimer& operator=(const BuildTimer&) = delete;
+
+private:
+  chrono::nanoseconds& total_;
+  chrono::steady_clock::time_point start_;
+};
+
+struct SpecParser {
+  SpecParser(istream& spec,
+      const string& source,
+      MockBuilder& builder,
+      SpecLoadReport& report)
+      : reader_(spec, source), builder_(builder), report_(report) {}
+
+  unique_ptr<Device> parse() {
+    try {
+      return parseDevice();
+    } catch (...) {
+      // a failed spec must not keep the shared builder busy for later loads
+      if (building_) {
+        builder_.abandonBuild();
+      }
+      throw;
+    }
+  }
+
+private:
+  struct ElementSpec {
+    optional<ElementType> type;
+    BuildInfo info;
+    DataType data_type = DataType::Boolean;
+    optional<string> value;
+    chrono::nanoseconds latency = chrono::nanoseconds::zero();
+    size_t count = 1;
+    bool has_elements = false;
+  };
+
+  unique_ptr<Device> parseDevice() {
+    string id;
+    BuildInfo info;
+    bool device_set = false;
+    string key;
+    reader_.beginObject();
+    while (reader_.nextMember(key)) {
+      if (device_set) {
+        reader_.fail("Elements must be the last member of the device");
+      }
+      if (key == "id") {
+        readText(id);
+      } else if (key == "name") {
+        readText(info.name);
+      } else if (key == "description") {
+        readText(info.description);
+      } else if (key == "latency_profiles") {
+        readLatencyProfiles();
+      } else if (key == "elements") {
+        setDevice(id, info);
+        device_set = true;
+        readElements("");
+      } else {
+        reader_.skipValue();
+      }
+    }
+    if (!reader_.atEnd()) {
+      reader_.fail("Unexpected content after the device");
+    }
+    if (!device_set) {
+      setDevice(id, info);
+    }
+    BuildTimer timer(report_.build_duration);
+    return builder_.result();
+  }
+
+  void setDevice(const string& id, const BuildInfo& info) {
+    if (id.empty()) {
+      reader_.fail("Device id is missing");
+    }
+    BuildTimer timer(report_.build_duration);
+    builder_.setDeviceInfo(id, info);
+    building_ = true;
+  }
+
+  void readText(string& result) {
+    if (reader_.readScalar(result) != JsonReader::Scalar::String) {
+      reader_.fail("Expected a string");
+    }
+  }
+
+  string readNumber() {
+    string number;
+    if (reader_.readScalar(number) != JsonReader::Scalar::Number) {
+      reader_.fail("Expected a number");
+    }
+    return number;
+  }
+
+  template <typename Value> Value readAs(DataType type) {
+    auto number = readNumber();
+    try {
+      return get<Value>(parseDataVariant(number, type));
+    } catch (const invalid_argument& ex) {
+      reader_.fail(ex.what());
+    }
+  }
+
+  chrono::nanoseconds readMicroseconds() {
+    auto microseconds = readAs<double>(DataType::Double);
+    if (microseconds < 0) {
+      reader_.fail("Latency can not be negative");
+    }
+    return chrono::duration_cast<chrono::nanoseconds>(
+        chrono::duration<double, micro>(microseconds));
+  }
+
+  void readLatencyProfiles() {
+    string name;
+    reader_.beginObject();
+    while (reader_.nextMember(name)) {
+      latency_profiles_[name] = readMicroseconds();
+    }
+  }
+
+  ElementType readElementType() {
+    readText(text_);
+    for (auto type : {ElementType::Group,
+             ElementType::Readable,
+             ElementType::Writable,
+             ElementType::Observable,
+             ElementType::Callable}) {
+      if (text_ == toString(type)) {
+        return type;
+      }
+    }
+    reader_.fail("Unknown element type " + text_);
+  }
+
+  DataType readDataType() {
+    readText(text_);
+    for (auto index = static_cast<uint8_t>(DataType::Boolean);
+         index < static_cast<uint8_t>(DataType::Unknown);
+         ++index) {
+      auto type = static_cast<DataType>(index);
+      if (text_ == toString(type)) {
+        return type;
+      }
+    }
+    reader_.fail("Unknown data type " + text_);
+  }
+
+  chrono::nanoseconds readLatencyProfile() {
+    readText(text_);
+    auto it = latency_profiles_.find(text_);
+    if (it == latency_profiles_.end()) {
+      reader_.fail("Unknown latency profile " + text_);
+    }
+    return it->second;
+  }
+
+  void readElements(const string& parent_id) {
+    vector<MockBuilder::ElementDescriptor> batch;
+    reader_.beginArray();
+    while (reader_.nextItem()) {
+      readElement(parent_id, batch);
+    }
+    flush(parent_id, batch);
+  }
+
+  void readElement(
+      const string& parent_id, vector<MockBuilder::ElementDescriptor>& batch) {
+    ElementSpec spec;
+    string key;
+    reader_.beginObject();
+    while (reader_.nextMember(key)) {
+      if (spec.has_elements) {
+        reader_.fail("Elements must be the last member of a group");
+      }
+      if (key == "type") {
+        spec.type = readElementType();
+      } else if (key == "name") {
+        readText(spec.info.name);
+      } else if (key == "description") {
+        readText(spec.info.description);
+      } else if (key == "data_type") {
+        spec.data_type = readDataType();
+      } else if (key == "value") {
+        string value;
+        if (reader_.readScalar(value) != JsonReader::Scalar::Null) {
+          spec.value = move(value);
+        }
+      } else if (key == "latency") {
+        spec.latency = readLatencyProfile();
+      } else if (key == "latency_us") {
+        spec.latency = readMicroseconds();
+      } else if (key == "count") {
+        spec.count = readAs<uintmax_t>(DataType::Unsigned_Integer);
+      } else if (key == "elements") {
+        if (spec.type != ElementType::Group) {
+          reader_.fail("Only groups can have nested elements");
+        }
+        spec.has_elements = true;
+        readElements(addGroup(parent_id, spec.info, batch));
+      } else {
+        reader_.skipValue();
+      }
+    }
+
+    if (!spec.type.has_value()) {
+      reader_.fail("Element type is missing");
+    }
+    if (*spec.type == ElementType::Group) {
+      if (!spec.has_elements) {
+        addGroup(parent_id, spec.info, batch);
+      }
+      return;
+    }
+    MockBuilder::ElementDescriptor descriptor{
+        *spec.type, spec.info, spec.data_type, nullopt, spec.latency};
+    if (spec.value.has_value()) {
+      try {
+        descriptor.default_value = parseDataVariant(*spec.value, spec.data_type);
+      } catch (const invalid_argument& ex) {
+        reader_.fail(ex.what());
+      }
+    }
+    report_.elements += spec.count;
+    // large counts are added in batches too, so they are never held at once
+    for (auto remaining = spec.count; remaining > 0;) {
+      auto chunk = min(remaining, BATCH_SIZE - batch.size());
+      batch.insert(batch.end(), chunk, descriptor);
+      remaining -= chunk;
+      if (batch.size() >= BATCH_SIZE) {
+        flush(parent_id, batch);
+      }
+    }
+  }
+
+  string addGroup(const string& parent_id,
+      const BuildInfo& info,
+      vector<MockBuilder::ElementDescriptor>& batch) {
+    // pending siblings are added first, so IDs follow the spec order
+    flush(parent_id, batch);
+    ++report_.elements;
+    BuildTimer timer(report_.build_duration);
+    return builder_.addGroup(parent_id, info);
+  }
+
+  void flush(
+      const string& parent_id, vector<MockBuilder::ElementDescriptor>& batch) {
+    if (batch.empty()) {
+      return;
+    }
+    BuildTimer timer(report_.build_duration);
+    builder_.addElements(parent_id, batch);
+    batch.clear();
+  }
+
+  JsonReader reader_;
+  MockBuilder& builder_;
+  SpecLoadReport& report_;
+  unordered_map<string, chrono::nanoseconds> latency_profiles_;
+  string text_;
+  bool building_ = false;
+};
+
+DeviceSpecLoader::DeviceSpecLoader(const MockBuilderPtr& builder)
+    : builder_(builder) {
+  if (!builder_) {
+    throw invalid_argument("MockBuilder can not be nullptr");
+  }
+}
+
+unique_ptr<Device> DeviceSpecLoader::load(istream& spec, const string& source) {
+  SpecLoadReport report;
+  auto start = chrono::steady_clock::now();
+  auto device = SpecParser(spec, source, *builder_, report).parse();
+  report.parse_duration =
+      chrono::steady_clock::now() - start - report.build_duration;
+  report_ = report;
+  return device;
+}
+
+unique_ptr<Device> DeviceSpecLoader::loadFile(const string& spec_path) {
+  ifstream spec(spec_path, ios::binary);
+  if (!spec) {
+    throw invalid_argument("Could not open spec file " + spec_path);
+  }
+  return load(spec, spec_path);
+}
+
+const SpecLoadReport& DeviceSpecLoader::report() const { return report_; }
+} // namespace Information_Model::testing
@@ -0,0 +1,21 @@
+#include "ElementFake.hpp"
+
+namespace Information_Model::testing {
+using namespace std;
+
+ElementFake::ElementFake(const ElementFunction& function,
+    const string& id,
+    const optional<FullMetaInfo>& meta)
+    : id_(id), meta_(meta.value_or(FullMetaInfo{})),
+      type_(getElementType(function)), function_(function) {}
+
+string ElementFake::id() const { return id_; }
+
+string ElementFake::name() const { return meta_.name; }
+
+string ElementFake::description() const { return meta_.description; }
+
+ElementType ElementFake::type() const { return type_; }
+
+ElementFunction ElementFake::function() const { return function_; }
+} // namespace Information_Model::testing
@@ -0,0 +1,143 @@
+#include "FleetGenerator.hpp"
+
+#include <stdexcept>
+
+namespace Information_Model::testing {
+using namespace std;
+
+// odd constant of the golden ratio, spreads consecutive device indices over
+// the whole seed range
+constexpr uint64_t SEED_STEP = 0x9E3779B97F4A7C15;
+
+template <typename Value, typename Generator>
+Value pickWeighted(const vector<pair<Value, size_t>>& weights,
+    size_t total,
+    Generator& generator) {
+  // modulo is used instead of a distribution, so the picks do not depend on
+  // the standard library implementation
+  auto roll = static_cast<size_t>(generator() % total);
+  for (const auto& [value, weight] : weights) {
+    if (roll < weight) {
+      return value;
+    }
+    roll -= weight;
+  }
+  return weights.back().first;
+}
+
+double FleetReport::elementsPerSecond() const {
+  if (duration <= chrono::nanoseconds::zero()) {
+    return 0;
+  }
+  return static_cast<double>(elements) /
+      chrono::duration<double>(duration).count();
+}
+
+FleetGenerator::FleetGenerator(
+    const FleetShape& shape, const BuilderConfigurator& configurator)
+    : shape_(shape), configurator_(configurator),
+      element_weights_({{ElementType::Readable, shape.element_mix.readable},
+          {ElementType::Writable, shape.element_mix.writable},
+          {ElementType::Observable, shape.element_mix.observable},
+          {ElementType::Callable, shape.element_mix.callable}}) {
+  for (const auto& [type, weight] : element_weights_) {
+    element_weight_total_ += weight;
+  }
+  if (element_weight_total_ == 0) {
+    throw invalid_argument("Element mix has no weights");
+  }
+  for (const auto& [type, weight] : shape_.data_type_mix) {
+    if (type == DataType::Unknown) {
+      throw invalid_argument("Data type mix can not contain Unknown");
+    }
+    data_type_weight_total_ += weight;
+  }
+  if (data_type_weight_total_ == 0) {
+    throw invalid_argument("Data type mix has no weights");
+  }
+  if (shape_.elements_per_group == 0) {
+    if (shape_.depth == 0 || shape_.group_fan_out == 0) {
+      throw invalid_argument("Fleet shape describes devices without elements");
+    }
+    // the deepest nested groups would hold neither elements nor groups
+    throw invalid_argument("Fleet shape describes empty nested groups");
+  }
+}
+
+vector<DevicePtr> FleetGenerator::generate() {
+  return generate([](size_t count, const WorkerPool::Task& task) {
+    for (size_t index = 0; index < count; ++index) {
+      task(index);
+    }
+  });
+}
+
+vector<DevicePtr> FleetGenerator::generate(WorkerPool& pool) {
+  return generate([&pool](size_t count, const WorkerPool::Task& task) {
+    pool.parallelFor(count, task);
+  });
+}
+
+vector<DevicePtr> FleetGenerator::generate(
+    const function<void(size_t, const WorkerPool::Task&)>& run) {
+  vector<DevicePtr> devices(shape_.device_count);
+  auto start = chrono::steady_clock::now();
+  run(devices.size(),
+      [this, &devices](size_t index) { devices[index] = generateDevice(index); });
+  report_.duration = chrono::steady_clock::now() - start;
+  report_.devices = devices.size();
+  report_.elements = devices.size() * elementsPerDevice();
+  return devices;
+}
+
+DevicePtr FleetGenerator::generateDevice(size_t index) const {
+  if (index >= shape_.device_count) {
+    throw out_of_range("Fleet has no device with index " + to_string(index));
+  }
+  MockBuilder builder;
+  if (configurator_) {
+    configurator_(builder);
+  }
+  auto id = shape_.id_prefix + to_string(index);
+  builder.setDeviceInfo(id, BuildInfo{id, "Generated device"});
+  Generator generator(shape_.seed + SEED_STEP * (index + 1));
+  addGroupContent(builder, generator, "", shape_.depth);
+  return builder.result();
+}
+
+size_t FleetGenerator::elementsPerDevice() const {
+  size_t groups = 0;
+  size_t level_groups = 1;
+  for (size_t level = 0; level < shape_.depth; ++level) {
+    level_groups *= shape_.group_fan_out;
+    groups += level_groups;
+  }
+  return (groups + 1) * shape_.elements_per_group + groups;
+}
+
+const FleetReport& FleetGenerator::report() const { return report_; }
+
+void FleetGenerator::addGroupContent(MockBuilder& builder,
+    Generator& generator,
+    const string& group_id,
+    size_t remaining_depth) const {
+  vector<MockBuilder::ElementDescriptor> descriptors(shape_.elements_per_group);
+  for (auto& descriptor : descriptors) {
+    descriptor.type =
+        pickWeighted(element_weights_, element_weight_total_, generator);
+    descriptor.data_type = pickWeighted(
+        shape_.data_type_mix, data_type_weight_total_, generator);
+    descriptor.info = BuildInfo{toString(descriptor.type), ""};
+  }
+  if (!descriptors.empty()) {
+    builder.addElements(group_id, descriptors);
+  }
+  if (remaining_depth == 0) {
+    return;
+  }
+  for (size_t count = 0; count < shape_.group_fan_out; ++count) {
+    auto subgroup_id = builder.addGroup(group_id, BuildInfo{"Group", ""});
+    addGroupContent(builder, generator, subgroup_id, remaining_depth - 1);
+  }
+}
+} // namespace Information_Model::testing
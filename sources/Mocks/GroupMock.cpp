@@ -1,70 +1,57 @@
 #include "GroupMock.hpp"
+#include "IdPath.hpp"
 
 #include <Information_Model/Element.hpp>
 
+#include <algorithm>
+#include <limits>
+
 namespace Information_Model::testing {
 using namespace std;
 using namespace ::testing;
 
-vector<ElementPtr> toVector(const unordered_map<string, ElementPtr>& map) {
-  vector<ElementPtr> result;
+// local id numbers further than this beyond the generated ones are tracked in
+// a sparse set instead of used_indices_
+constexpr size_t MAX_DENSE_INDEX_GAP = 1024;
 
-  if (!map.empty()) {
-    result.reserve(map.size());
-    size_t i = 0;
-    while (i < map.size()) {
-      auto element = map.at(to_string(i));
-      result.push_back(element);
-      i++;
-    }
-  }
-  return result;
-}
-
-GroupMock::GroupMock(const string& id) : id_(id) {
+GroupMock::GroupMock(const string& id)
+    : shared_index_(make_shared<ElementIndex>()), id_(id) {
   ON_CALL(*this, size).WillByDefault([this]() { return elements_.size(); });
-  ON_CALL(*this, asMap).WillByDefault([this]() { return elements_; });
+  // the Group interface returns by value, so only the cached snapshot is copied
+  ON_CALL(*this, asMap).WillByDefault([this]() { return *mapSnapshot(); });
   ON_CALL(*this, asVector).WillByDefault([this]() {
-    return toVector(elements_);
+    return *vectorSnapshot();
   });
   ON_CALL(*this, element).WillByDefault(Invoke(this, &GroupMock::getElement));
-  ON_CALL(*this, visit).WillByDefault([this](const Group::Visitor& visitor) {
-    for_each(elements_.begin(), elements_.end(),
-        [&visitor](const auto& pair) { visitor(pair.second); });
-  });
+  ON_CALL(*this, visit).WillByDefault(Invoke(this, &GroupMock::forEach));
 }
 
-string GroupMock::generateID() {
-  string new_id = (id_.back() == ':' ? id_ : id_ + '.') + to_string(next_id_);
-  next_id_++;
-  return new_id;
-}
+string GroupMock::generateID() { return IdPath(id_).childId(next_id_++); }
 
 void GroupMock::addElement(const ElementPtr& element) {
   if (!element) {
     throw invalid_argument("Given element is empty");
   }
-  auto sanitized_id = id_;
-  if (sanitized_id.back() == ':') {
-    sanitized_id.pop_back();
+  IdPath path(id_);
+  // id() returns by value, so it is only fetched once
+  auto element_id = element->id();
+  string_view trimmed_id = element_id;
+  if (!trimmed_id.empty() && trimmed_id.back() == IdPath::SEGMENT_SEPARATOR) {
+    trimmed_id.remove_suffix(1);
   }
-  if (element->id() == sanitized_id) {
+  if (trimmed_id == path.name()) {
     throw invalid_argument("Given element has the same ID as this group");
   }
-  if (element->id().compare(0, id_.length(), id_) != 0) {
+  if (!path.contains(trimmed_id)) {
     throw invalid_argument("Given element is not part of this group");
   }
 
-  auto sub_id = element->id().substr(id_.size());
-  if (sub_id.front() == '.') {
-    sub_id.erase(0, 1);
-  }
-  if (sub_id.back() == '.') {
-    sub_id.pop_back();
-  }
-  auto group_marker = sub_id.find('.');
-  if (group_marker != string::npos) {
-    auto parent = getElement(id_ + sub_id.substr(0, group_marker));
+  auto child_id = path.child(trimmed_id);
+  if (child_id.size() != trimmed_id.size()) {
+    auto parent = findElement(child_id);
+    if (!parent) {
+      throw ElementNotFound(string(child_id));
+    }
     if (parent->type() != ElementType::Group) {
       throw invalid_argument(
           "Parent element " + parent->id() + " is not a group");
@@ -73,54 +60,399 @@ void GroupMock::addElement(const ElementPtr& element) {
         dynamic_pointer_cast<GroupMock>(get<GroupPtr>(parent->function()));
     parent_function->addElement(element);
   } else {
-    if (!elements_.try_emplace(sub_id, element).second) {
+    auto index = IdPath(child_id).index();
+    if (!index.has_value()) {
+      throw invalid_argument(
+          "Given element id " + element_id + " does not end with a number");
+    }
+    unique_lock index_guard(shared_index_->elements_mx);
+    if (isIndexUsed(*index) ||
+        shared_index_->elements.count(element_id) != 0) {
       throw logic_error(
-          "Element with id " + element->id() + " is already in this group");
+          "Element with id " + element_id + " is already in this group");
     }
+    const auto& owned_id = shared_index_->ids.emplace_back(move(element_id));
+    shared_index_->elements.emplace(owned_id, element);
+    GroupMockPtr subgroup;
     if (element->type() == ElementType::Group) {
-      auto subgroup_id = sub_id.substr(0, sub_id.find('.'));
-      auto subgroup =
+      subgroup =
           dynamic_pointer_cast<GroupMock>(get<GroupPtr>(element->function()));
-      subgroups_.emplace(subgroup_id, subgroup);
+      shared_index_->groups.emplace(owned_id, subgroup);
+    }
+    index_guard.unlock();
+    markIndex(*index);
+    elements_.push_back(element);
+    ids_.push_back(owned_id);
+    if (subgroup) {
+      subgroup->shareIndex(shared_index_);
     }
+    subgroups_.push_back(move(subgroup));
+    invalidateSnapshots();
   }
 }
 
-ElementPtr GroupMock::getElement(const string& ref_id) {
-  auto sanitized_id = id_;
-  if (sanitized_id.back() == ':') {
-    sanitized_id.pop_back();
+vector<string> GroupMock::generateIDs(size_t count) {
+  IdPath path(id_);
+  vector<string> ids;
+  ids.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    ids.push_back(path.childId(next_id_++));
+  }
+  return ids;
+}
+
+void GroupMock::addElements(
+    const vector<string>& ids, const vector<ElementPtr>& elements) {
+  if (ids.size() != elements.size()) {
+    throw invalid_argument("Given ID and element counts differ");
+  }
+  IdPath path(id_);
+  vector<size_t> indices;
+  indices.reserve(ids.size());
+  for (size_t position = 0; position < ids.size(); ++position) {
+    if (!elements[position]) {
+      throw invalid_argument("Given element is empty");
+    }
+    if (elements[position]->type() == ElementType::Group) {
+      throw invalid_argument("Groups can not be added in bulk");
+    }
+    if (path.child(ids[position]).size() != ids[position].size()) {
+      throw invalid_argument(
+          "Given element " + ids[position] + " is not a child of this group");
+    }
+    auto index = IdPath(ids[position]).index();
+    if (!index.has_value()) {
+      throw invalid_argument(
+          "Given element id " + ids[position] + " does not end with a number");
+    }
+    indices.push_back(*index);
+  }
+
+  unique_lock index_guard(shared_index_->elements_mx);
+  // mark all of the indices first, so a duplicate adds none of the elements
+  for (size_t position = 0; position < indices.size(); ++position) {
+    auto index = indices[position];
+    if (isIndexUsed(index) ||
+        shared_index_->elements.count(ids[position]) != 0) {
+      for (size_t marked = 0; marked < position; ++marked) {
+        unmarkIndex(indices[marked]);
+      }
+      throw logic_error(
+          "Element with id " + ids[position] + " is already in this group");
+    }
+    markIndex(index);
   }
-  if (ref_id == sanitized_id) {
+
+  auto count = elements.size() + elements_.size();
+  elements_.reserve(count);
+  ids_.reserve(count);
+  subgroups_.reserve(count);
+  shared_index_->elements.reserve(
+      shared_index_->elements.size() + elements.size());
+  for (size_t position = 0; position < elements.size(); ++position) {
+    const auto& owned_id = shared_index_->ids.emplace_back(ids[position]);
+    shared_index_->elements.emplace(owned_id, elements[position]);
+    elements_.push_back(elements[position]);
+    ids_.push_back(owned_id);
+    subgroups_.emplace_back();
+  }
+  index_guard.unlock();
+  invalidateSnapshots();
+}
+
+size_t GroupMock::addElements(size_t count, const ElementFactory& factory) {
+  if (!factory) {
+    throw invalid_argument("ElementFactory can not be nullptr");
+  }
+  auto first_index = next_id_;
+  if (count > numeric_limits<size_t>::max() - first_index) {
+    throw invalid_argument("Given element count is too large");
+  }
+  IdPath path(id_);
+  vector<string> ids;
+  vector<ElementPtr> elements;
+  ids.reserve(count);
+  elements.reserve(count);
+  for (size_t offset = 0; offset < count; ++offset) {
+    ids.push_back(path.childId(first_index + offset));
+    elements.push_back(factory(offset, ids.back()));
+  }
+  addElements(ids, elements);
+  next_id_ = first_index + count;
+  return first_index;
+}
+
+ElementPtr GroupMock::getElement(const string& ref_id) {
+  IdPath path(id_);
+  if (ref_id == path.name()) {
     throw IDPointsThisGroup(ref_id);
   }
-  if (ref_id.compare(0, id_.length(), id_) != 0) {
-    // if referenced id does not start with this id, than the element is not in
-    // this group
+  // the index is shared with the parent and sibling groups, so referenced id
+  // must be nested below this group
+  if (!path.contains(ref_id)) {
     throw ElementNotFound(ref_id);
   }
+  if (auto element = findElement(ref_id)) {
+    return element;
+  }
+  throw ElementNotFound(ref_id);
+}
 
-  auto sub_id = ref_id.substr(id_.size());
-  if (sub_id.front() == '.') {
-    sub_id.erase(0, 1);
+ElementPtr GroupMock::findElement(string_view ref_id) {
+  {
+    shared_lock index_guard(shared_index_->elements_mx);
+    const auto& elements = shared_index_->elements;
+    if (auto it = elements.find(ref_id); it != elements.end()) {
+      if (auto element = it->second.lock()) {
+        return element;
+      }
+    }
   }
-  auto group_marker = sub_id.find('.');
-  if (group_marker == string::npos) {
-    if (auto it = elements_.find(sub_id); it != elements_.end()) {
-      return it->second;
-    } else {
-      // no element with given id exists
-      throw ElementNotFound(ref_id);
+  return findLazy(ref_id);
+}
+
+ElementPtr GroupMock::findLazy(string_view ref_id) {
+  IdPath ref(ref_id);
+  auto index = ref.index();
+  auto parent_id = ref.parent();
+  auto local_id = ref_id.substr(parent_id.size() + 1);
+  // generated ids never have leading zeros
+  if (!index.has_value() || (local_id.size() > 1 && local_id.front() == '0')) {
+    return nullptr;
+  }
+  if (parent_id == IdPath(id_).name()) {
+    return materialize(*index);
+  }
+  GroupMockPtr parent;
+  {
+    shared_lock index_guard(shared_index_->elements_mx);
+    const auto& groups = shared_index_->groups;
+    if (auto it = groups.find(parent_id); it != groups.end()) {
+      parent = it->second.lock();
     }
+  }
+  // materializing takes the index lock again to add the element
+  return parent ? parent->materialize(*index) : nullptr;
+}
+
+size_t GroupMock::addLazyElements(size_t count, const ElementFactory& factory) {
+  if (!factory) {
+    throw invalid_argument("ElementFactory can not be nullptr");
+  }
+  auto first_index = next_id_;
+  if (count > numeric_limits<size_t>::max() - first_index) {
+    throw invalid_argument("Given lazy element count is too large");
+  }
+  auto end_index = first_index + count;
+  for (auto index = first_index;
+       index < min(end_index, used_indices_.size());
+       ++index) {
+    if (used_indices_[index]) {
+      throw logic_error("Element with id " + IdPath(id_).childId(index) +
+          " is already in this group");
+    }
+  }
+  for (auto index : sparse_indices_) {
+    if (index >= first_index && index < end_index) {
+      throw logic_error("Element with id " + IdPath(id_).childId(index) +
+          " is already in this group");
+    }
+  }
+  next_id_ = end_index;
+  if (count == 0) {
+    return first_index;
+  }
+  if (end_index > used_indices_.size()) {
+    used_indices_.resize(end_index);
+  }
+  fill(used_indices_.begin() + static_cast<ptrdiff_t>(first_index),
+      used_indices_.begin() + static_cast<ptrdiff_t>(end_index),
+      true);
+
+  scoped_lock guard(lazy_mx_);
+  lazy_ranges_.push_back(
+      LazyRange{first_index, elements_.size(), count, factory});
+  auto total = elements_.size() + count;
+  elements_.resize(total);
+  ids_.resize(total);
+  subgroups_.resize(total);
+  invalidateSnapshots();
+  return first_index;
+}
+
+bool GroupMock::isIndexUsed(size_t index) const {
+  // dense marks can grow past earlier sparse ones, so both are checked
+  return (index < used_indices_.size() && used_indices_[index]) ||
+      sparse_indices_.count(index) != 0;
+}
+
+void GroupMock::markIndex(size_t index) {
+  auto dense_end = max(next_id_, used_indices_.size());
+  if (index < used_indices_.size()) {
+    used_indices_[index] = true;
+  } else if (index <= dense_end || index - dense_end < MAX_DENSE_INDEX_GAP) {
+    used_indices_.resize(index + 1);
+    used_indices_[index] = true;
+  } else {
+    sparse_indices_.insert(index);
+  }
+}
+
+void GroupMock::unmarkIndex(size_t index) {
+  if (index < used_indices_.size()) {
+    used_indices_[index] = false;
+  }
+  sparse_indices_.erase(index);
+}
+
+ElementPtr GroupMock::materialize(size_t index) const {
+  scoped_lock guard(lazy_mx_);
+  for (const auto& range : lazy_ranges_) {
+    if (index >= range.first_index && index - range.first_index < range.count) {
+      return materializeLocked(range, index - range.first_index);
+    }
+  }
+  return nullptr;
+}
+
+void GroupMock::materializeAll() const {
+  scoped_lock guard(lazy_mx_);
+  for (const auto& range : lazy_ranges_) {
+    for (size_t offset = 0; offset < range.count; ++offset) {
+      materializeLocked(range, offset);
+    }
+  }
+}
+
+const ElementPtr& GroupMock::materializeLocked(
+    const LazyRange& range, size_t offset) const {
+  auto position = range.first_position + offset;
+  if (!elements_[position]) {
+    auto id = IdPath(id_).childId(range.first_index + offset);
+    auto element = range.factory(offset, id);
+    if (!element) {
+      throw logic_error("ElementFactory returned no element for " + id);
+    }
+    // the index owns the id, so it outlives this group as long as any nested
+    // group of the same device still views it
+    scoped_lock index_guard(shared_index_->elements_mx);
+    const auto& owned_id = shared_index_->ids.emplace_back(move(id));
+    elements_[position] = move(element);
+    ids_[position] = owned_id;
+    // later lookups of this element take a single probe, same as for eagerly
+    // added elements
+    shared_index_->elements.emplace(owned_id, elements_[position]);
+  }
+  return elements_[position];
+}
+
+void GroupMock::shareIndex(const shared_ptr<ElementIndex>& index) {
+  if (shared_index_ == index) {
+    return;
+  }
+  // elements that were added before this group was attached to its parent,
+  // their ids stay owned by the merged index
+  scoped_lock index_guard(index->elements_mx, shared_index_->elements_mx);
+  index->elements.insert(
+      shared_index_->elements.begin(), shared_index_->elements.end());
+  index->groups.insert(
+      shared_index_->groups.begin(), shared_index_->groups.end());
+  index->merged.push_back(shared_index_);
+  adoptIndex(index);
+}
+
+void GroupMock::adoptIndex(const shared_ptr<ElementIndex>& index) {
+  shared_index_ = index;
+  for (const auto& subgroup : subgroups_) {
+    if (subgroup) {
+      subgroup->adoptIndex(index);
+    }
+  }
+}
+
+GroupMock::ElementMapSnapshot GroupMock::mapSnapshot() const {
+  materializeAll();
+  scoped_lock guard(snapshot_mx_);
+  if (!map_snapshot_) {
+    auto map = make_shared<ElementMap>();
+    IdPath path(id_);
+    map->reserve(elements_.size());
+    for (size_t index = 0; index < elements_.size(); ++index) {
+      map->emplace(path.localId(ids_[index]), elements_[index]);
+    }
+    map_snapshot_ = move(map);
+  }
+  return map_snapshot_;
+}
+
+GroupMock::ElementVectorSnapshot GroupMock::vectorSnapshot() const {
+  materializeAll();
+  scoped_lock guard(snapshot_mx_);
+  if (!vector_snapshot_) {
+    vector_snapshot_ = make_shared<std::vector<ElementPtr>>(elements_);
+  }
+  return vector_snapshot_;
+}
+
+void GroupMock::invalidateSnapshots() {
+  scoped_lock guard(snapshot_mx_);
+  map_snapshot_.reset();
+  vector_snapshot_.reset();
+}
+
+void GroupMock::forEach(const Group::Visitor& visitor) const {
+  materializeAll();
+  for (const auto& element : elements_) {
+    visitor(element);
+  }
+}
+
+void GroupMock::parallelVisit(
+    WorkerPool& pool, const Group::Visitor& visitor, VisitOrder order) const {
+  parallelVisit(
+      pool,
+      [&visitor](const ElementPtr& element, const IdPath&) { visitor(element); },
+      order);
+}
+
+void GroupMock::parallelVisit(
+    WorkerPool& pool, const PathVisitor& visitor, VisitOrder order) const {
+  if (order == VisitOrder::Unordered) {
+    fanOut(pool, visitor);
   } else {
-    auto subgroup_id = sub_id.substr(0, group_marker);
-    if (auto it = subgroups_.find(subgroup_id); it != subgroups_.end()) {
-      return it->second->element(ref_id);
-    } else {
-      // no subgroup containing given id exists
-      throw ElementNotFound(ref_id);
+    FlattenedElements flattened;
+    flatten(pool, flattened);
+    for (const auto& [element, id] : flattened) {
+      visitor(element, IdPath(id));
     }
   }
 }
 
+void GroupMock::fanOut(WorkerPool& pool, const PathVisitor& visitor) const {
+  materializeAll();
+  pool.parallelFor(elements_.size(), [this, &pool, &visitor](size_t index) {
+    visitor(elements_[index], IdPath(ids_[index]));
+    if (subgroups_[index]) {
+      subgroups_[index]->fanOut(pool, visitor);
+    }
+  });
+}
+
+void GroupMock::flatten(WorkerPool& pool, FlattenedElements& flattened) const {
+  materializeAll();
+  // each nested group is flattened into its own buffer concurrently, the
+  // buffers are then appended in insertion order
+  vector<FlattenedElements> nested(elements_.size());
+  pool.parallelFor(elements_.size(), [this, &pool, &nested](size_t index) {
+    if (subgroups_[index]) {
+      subgroups_[index]->flatten(pool, nested[index]);
+    }
+  });
+  flattened.reserve(flattened.size() + elements_.size());
+  for (size_t index = 0; index < elements_.size(); ++index) {
+    flattened.emplace_back(elements_[index], ids_[index]);
+    flattened.insert(
+        flattened.end(), nested[index].begin(), nested[index].end());
+  }
+}
 } // namespace Information_Model::testing
@@ -0,0 +1,69 @@
+#include "IdPath.hpp"
+
+#include <charconv>
+#include <limits>
+
+namespace Information_Model::testing {
+using namespace std;
+
+constexpr char SEPARATORS[] = {
+    IdPath::SEGMENT_SEPARATOR, IdPath::DEVICE_SEPARATOR, '\0'};
+
+string_view IdPath::parent() const noexcept {
+  if (isRoot()) {
+    return {};
+  }
+  auto end = id_.find_last_of(SEPARATORS);
+  return end == string_view::npos ? string_view{} : id_.substr(0, end);
+}
+
+bool IdPath::contains(string_view ref_id) const noexcept {
+  return ref_id.size() > prefixLength() &&
+      ref_id.compare(0, id_.size(), id_) == 0 &&
+      (isRoot() || ref_id[id_.size()] == SEGMENT_SEPARATOR);
+}
+
+string_view IdPath::child(string_view ref_id) const noexcept {
+  if (!contains(ref_id)) {
+    return {};
+  }
+  auto end = ref_id.find(SEGMENT_SEPARATOR, prefixLength());
+  return ref_id.substr(0, end);
+}
+
+string_view IdPath::localId(string_view ref_id) const noexcept {
+  auto child_id = child(ref_id);
+  if (child_id.empty()) {
+    return {};
+  }
+  return child_id.substr(prefixLength());
+}
+
+optional<size_t> IdPath::index() const noexcept {
+  auto begin = id_.find_last_of(SEPARATORS);
+  auto segment = begin == string_view::npos ? id_ : id_.substr(begin + 1);
+  size_t result = 0;
+  const auto* end = segment.data() + segment.size();
+  auto [last, error] = from_chars(segment.data(), end, result);
+  if (segment.empty() || error != errc() || last != end) {
+    return nullopt;
+  }
+  return result;
+}
+
+string IdPath::childId(size_t index) const {
+  constexpr size_t MAX_INDEX_LENGTH = numeric_limits<size_t>::digits10 + 1;
+  char digits[MAX_INDEX_LENGTH];
+  auto [last, _] = to_chars(digits, digits + MAX_INDEX_LENGTH, index);
+  auto digit_count = static_cast<size_t>(last - digits);
+
+  string result;
+  result.reserve(prefixLength() + digit_count);
+  result.append(id_);
+  if (!isRoot()) {
+    result.push_back(SEGMENT_SEPARATOR);
+  }
+  result.append(digits, digit_count);
+  return result;
+}
+} // namespace Information_Model::testing
@@ -0,0 +1,116 @@
+#include "LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Information_Model::testing {
+using namespace std;
+
+// values below LINEAR_LIMIT get a bucket each, every following power of two
+// range is split into SUB_BUCKETS buckets
+constexpr uint64_t SUB_BUCKETS = 64;
+constexpr uint64_t LINEAR_LIMIT = 2 * SUB_BUCKETS;
+
+size_t mostSignificantBit(uint64_t value) {
+  size_t msb = 0;
+  while (value >>= 1) {
+    ++msb;
+  }
+  return msb;
+}
+
+size_t bucketIndex(uint64_t value) {
+  if (value < LINEAR_LIMIT) {
+    return value;
+  }
+  // shift, so that the remaining value is within [SUB_BUCKETS, LINEAR_LIMIT)
+  auto shift = mostSignificantBit(value) - mostSignificantBit(SUB_BUCKETS);
+  return LINEAR_LIMIT + (shift - 1) * SUB_BUCKETS +
+      ((value >> shift) - SUB_BUCKETS);
+}
+
+uint64_t highestEquivalentValue(size_t index) {
+  if (index < LINEAR_LIMIT) {
+    return index;
+  }
+  auto offset = index - LINEAR_LIMIT;
+  auto shift = offset / SUB_BUCKETS + 1;
+  auto sub_bucket = offset % SUB_BUCKETS + SUB_BUCKETS;
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(chrono::nanoseconds latency) {
+  auto value = static_cast<uint64_t>(std::max<chrono::nanoseconds::rep>(
+      latency.count(), 0));
+  auto index = bucketIndex(value);
+  if (index >= counts_.size()) {
+    counts_.resize(index + 1, 0);
+  }
+  ++counts_[index];
+  if (count_ == 0 || value < min_) {
+    min_ = value;
+  }
+  max_ = std::max(max_, value);
+  sum_ += static_cast<long double>(value);
+  ++count_;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+  if (other.count_ == 0) {
+    return;
+  }
+  if (other.counts_.size() > counts_.size()) {
+    counts_.resize(other.counts_.size(), 0);
+  }
+  for (size_t i = 0; i < other.counts_.size(); ++i) {
+    counts_[i] += other.counts_[i];
+  }
+  min_ = count_ == 0 ? other.min_ : std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+  sum_ += other.sum_;
+  count_ += other.count_;
+}
+
+void LatencyHistogram::reset() { *this = LatencyHistogram(); }
+
+size_t LatencyHistogram::count() const { return count_; }
+
+chrono::nanoseconds LatencyHistogram::min() const {
+  return chrono::nanoseconds(static_cast<chrono::nanoseconds::rep>(min_));
+}
+
+chrono::nanoseconds LatencyHistogram::max() const {
+  return chrono::nanoseconds(static_cast<chrono::nanoseconds::rep>(max_));
+}
+
+chrono::nanoseconds LatencyHistogram::mean() const {
+  if (count_ == 0) {
+    return chrono::nanoseconds(0);
+  }
+  return chrono::nanoseconds(static_cast<chrono::nanoseconds::rep>(
+      llroundl(sum_ / static_cast<long double>(count_))));
+}
+
+chrono::nanoseconds LatencyHistogram::percentile(double percentile) const {
+  if (percentile < 0 || percentile > 100) {
+    throw invalid_argument("Percentile must be within [0,100] range");
+  }
+  if (count_ == 0) {
+    return chrono::nanoseconds(0);
+  }
+  auto target = std::max<uint64_t>(static_cast<uint64_t>(ceil(
+                                  percentile / 100 * static_cast<double>(count_))),
+      1);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < counts_.size(); ++i) {
+    seen += counts_[i];
+    if (seen >= target) {
+      // bucket bounds may exceed the recorded range
+      auto value = clamp(highestEquivalentValue(i), min_, max_);
+      return chrono::nanoseconds(static_cast<chrono::nanoseconds::rep>(value));
+    }
+  }
+  return max();
+}
+} // namespace Information_Model::testing
@@ -0,0 +1,115 @@
+#include "MappedFile.hpp"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Information_Model::testing {
+using namespace std;
+
+MappedFile::MappedFile(
+    const string& path, const string& file_kind, Access access) {
+#ifdef _WIN32
+  auto file = CreateFileA(path.c_str(),
+      GENERIC_READ,
+      FILE_SHARE_READ,
+      nullptr,
+      OPEN_EXISTING,
+      access == Access::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN
+                                   : FILE_FLAG_RANDOM_ACCESS,
+      nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw invalid_argument("Could not open " + file_kind + " file " + path);
+  }
+  file_ = file;
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) {
+    unmap();
+    throw invalid_argument("Could not stat " + file_kind + " file " + path);
+  }
+  size_ = static_cast<size_t>(size.QuadPart);
+  if (size_ > 0) {
+    mapping_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping_ != nullptr) {
+      data_ = static_cast<const char*>(
+          MapViewOfFile(static_cast<HANDLE>(mapping_), FILE_MAP_READ, 0, 0, 0));
+    }
+    if (data_ == nullptr) {
+      unmap();
+      throw invalid_argument("Could not map " + file_kind + " file " + path);
+    }
+  }
+#else
+  auto descriptor = open(path.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    throw invalid_argument("Could not open " + file_kind + " file " + path);
+  }
+  struct stat info {};
+  if (fstat(descriptor, &info) != 0) {
+    close(descriptor);
+    throw invalid_argument("Could not stat " + file_kind + " file " + path);
+  }
+  size_ = static_cast<size_t>(info.st_size);
+  if (size_ > 0) {
+    auto* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (data == MAP_FAILED) {
+      close(descriptor);
+      throw invalid_argument("Could not map " + file_kind + " file " + path);
+    }
+    data_ = static_cast<const char*>(data);
+    madvise(data,
+        size_,
+        access == Access::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+  }
+  // the mapping stays valid after the descriptor is closed
+  close(descriptor);
+#endif
+}
+
+MappedFile::~MappedFile() { unmap(); }
+
+string_view MappedFile::content() const { return string_view(data_, size_); }
+
+void MappedFile::release(size_t position) {
+#ifndef _WIN32
+  constexpr size_t RELEASE_STEP = 64 * 1024 * 1024;
+  if (position < released_ + RELEASE_STEP) {
+    return;
+  }
+  auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  auto until = position / page_size * page_size;
+  madvise(
+      const_cast<char*>(data_) + released_, until - released_, MADV_DONTNEED);
+  released_ = until;
+#else
+  (void)position;
+#endif
+}
+
+void MappedFile::rewind() { released_ = 0; }
+
+void MappedFile::unmap() {
+#ifdef _WIN32
+  if (data_ != nullptr) {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_ != nullptr) {
+    CloseHandle(static_cast<HANDLE>(mapping_));
+  }
+  if (file_ != nullptr) {
+    CloseHandle(static_cast<HANDLE>(file_));
+  }
+#else
+  if (data_ != nullptr) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+#endif
+}
+} // namespace Information_Model::testing
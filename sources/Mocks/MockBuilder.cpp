@@ -1,16 +1,232 @@
 #include "MockBuilder.hpp"
 
+#include "ElementFake.hpp"
 #include "ElementMock.hpp"
+#include "IdPath.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
 
 namespace Information_Model::testing {
 using namespace std;
 using namespace ::testing;
 
+template <class MockType, class... Args>
+shared_ptr<NiceMock<MockType>> makeMock(
+    const MockArenaPtr& arena, Args&&... args) {
+  return makeShared<NiceMock<MockType>>(arena, forward<Args>(args)...);
+}
+
+template <class MockType> struct FakeOf;
+template <> struct FakeOf<ReadableMock> { using type = ReadableFake; };
+template <> struct FakeOf<WritableMock> { using type = WritableFake; };
+template <> struct FakeOf<ObservableMock> { using type = ObservableFake; };
+template <> struct FakeOf<CallableMock> { using type = CallableFake; };
+
+// builds the plain fake with the same arguments instead, if fake is set
+template <class MockType, class... Args>
+ElementFunction makeFunctionMock(
+    bool fake, const MockArenaPtr& arena, Args&&... args) {
+  if (fake) {
+    return makeShared<typename FakeOf<MockType>::type>(
+        arena, forward<Args>(args)...);
+  }
+  return makeMock<MockType>(arena, forward<Args>(args)...);
+}
+
+template <class... Args>
+ElementFunction makeObservableMock(bool fake, const MockArenaPtr& arena,
+    const MockBuilder::IsObservingCallback& observe_cb, Args&&... args) {
+  if (fake) {
+    auto observable = makeShared<ObservableFake>(arena, forward<Args>(args)...);
+    observable->enableSubscribeFaking(observe_cb);
+    return observable;
+  }
+  auto observable = makeMock<ObservableMock>(arena, forward<Args>(args)...);
+  observable->enableSubscribeFaking(observe_cb);
+  return observable;
+}
+
+ElementPtr wrapFunction(bool fake, const MockArenaPtr& arena,
+    const ElementFunction& function, const string& id, const BuildInfo& info) {
+  if (fake) {
+    return makeShared<ElementFake>(
+        arena, function, id, FullMetaInfo{info.name, info.description});
+  }
+  return makeMock<ElementMock>(
+      arena, function, id, FullMetaInfo{info.name, info.description});
+}
+
+MockBuilder::NotifyCallback makeNotifier(const ElementFunction& function) {
+  const auto& observable = get<ObservablePtr>(function);
+  if (auto fake = dynamic_pointer_cast<ObservableFake>(observable)) {
+    return [fake](const DataVariant& value) { fake->notify(value); };
+  }
+  auto mock = static_pointer_cast<ObservableMock>(observable);
+  return [mock](const DataVariant& value) { mock->notify(value); };
+}
+
+ReadableMock::ReadCallback makeDelayedRead(
+    chrono::nanoseconds latency, const DataVariant& value) {
+  return [latency, value]() {
+    this_thread::sleep_for(latency);
+    return value;
+  };
+}
+
+// elements with a latency read their value through a blocking callback
+ElementFunction makeDelayedFunction(bool fake, const MockArenaPtr& arena,
+    const MockBuilder::ElementDescriptor& descriptor) {
+  auto value = descriptor.default_value.value_or(
+      setVariant(descriptor.data_type).value_or(DataVariant{}));
+  auto type = descriptor.default_value ? toDataType(*descriptor.default_value)
+                                       : descriptor.data_type;
+  auto read_cb = makeDelayedRead(descriptor.latency, value);
+  switch (descriptor.type) {
+  case ElementType::Readable: {
+    return makeFunctionMock<ReadableMock>(fake, arena, type, read_cb);
+  }
+  case ElementType::Writable: {
+    WritableMock::WriteCallback write_cb =
+        [latency = descriptor.latency](const DataVariant&) {
+          this_thread::sleep_for(latency);
+        };
+    return makeFunctionMock<WritableMock>(
+        fake, arena, type, read_cb, write_cb);
+  }
+  case ElementType::Observable: {
+    return makeFunctionMock<ObservableMock>(fake, arena, type, read_cb);
+  }
+  default: {
+    throw invalid_argument(
+        "Can not build " + toString(descriptor.type) + " element with latency");
+  }
+  }
+}
+
+ElementFunction makeFunction(bool fake, const MockArenaPtr& arena,
+    const MockBuilder::ElementDescriptor& descriptor) {
+  if (descriptor.latency > chrono::nanoseconds::zero()) {
+    return makeDelayedFunction(fake, arena, descriptor);
+  }
+  const auto& value = descriptor.default_value;
+  switch (descriptor.type) {
+  case ElementType::Readable: {
+    return value
+        ? makeFunctionMock<ReadableMock>(fake, arena, *value)
+        : makeFunctionMock<ReadableMock>(fake, arena, descriptor.data_type);
+  }
+  case ElementType::Writable: {
+    return value
+        ? makeFunctionMock<WritableMock>(fake, arena, *value)
+        : makeFunctionMock<WritableMock>(fake, arena, descriptor.data_type);
+  }
+  case ElementType::Observable: {
+    return value
+        ? makeFunctionMock<ObservableMock>(fake, arena, *value)
+        : makeFunctionMock<ObservableMock>(fake, arena, descriptor.data_type);
+  }
+  case ElementType::Callable: {
+    return makeFunctionMock<CallableMock>(
+        fake, arena, descriptor.data_type, ParameterTypes{});
+  }
+  default: {
+    throw invalid_argument(
+        "Can not build " + toString(descriptor.type) + " element in bulk");
+  }
+  }
+}
+
+ElementPtr makeElement(bool fake, const MockArenaPtr& arena,
+    const MockBuilder::ElementDescriptor& descriptor,
+    const string& id) {
+  return wrapFunction(fake,
+      arena,
+      makeFunction(fake, arena, descriptor),
+      id,
+      descriptor.info);
+}
+
+namespace {
+bool sameInfo(const BuildInfo& lhs, const BuildInfo& rhs) {
+  return lhs.name == rhs.name && lhs.description == rhs.description;
+}
+
+bool sameDescriptor(const MockBuilder::ElementDescriptor& lhs,
+    const MockBuilder::ElementDescriptor& rhs) {
+  return lhs.type == rhs.type && sameInfo(lhs.info, rhs.info) &&
+      lhs.data_type == rhs.data_type &&
+      lhs.default_value == rhs.default_value && lhs.latency == rhs.latency;
+}
+} // namespace
+
+// consecutive equal descriptors are stored once as a run
+struct DescriptorRuns {
+  explicit DescriptorRuns(
+      const vector<MockBuilder::ElementDescriptor>& descriptors) {
+    for (size_t offset = 0; offset < descriptors.size(); ++offset) {
+      if (runs_.empty() || !sameDescriptor(runs_.back(), descriptors[offset])) {
+        runs_.push_back(descriptors[offset]);
+        run_ends_.push_back(offset + 1);
+      } else {
+        run_ends_.back() = offset + 1;
+      }
+    }
+  }
+
+  const MockBuilder::ElementDescriptor& at(size_t offset) const {
+    auto run = upper_bound(run_ends_.begin(), run_ends_.end(), offset);
+    return runs_[static_cast<size_t>(run - run_ends_.begin())];
+  }
+
+private:
+  vector<MockBuilder::ElementDescriptor> runs_;
+  vector<size_t> run_ends_;
+};
+
+void MockBuilder::enableArena(size_t initial_size) {
+  if (result_) {
+    throw DeviceBuildInProgress();
+  }
+  arena_size_ = initial_size;
+}
+
+void MockBuilder::enableLazyElements() {
+  if (result_) {
+    throw DeviceBuildInProgress();
+  }
+  lazy_elements_ = true;
+}
+
+void MockBuilder::enableFakes() {
+  if (result_) {
+    throw DeviceBuildInProgress();
+  }
+  fakes_ = true;
+}
+
+void MockBuilder::enablePrototypeRecording() {
+  if (result_) {
+    throw DeviceBuildInProgress();
+  }
+  record_prototype_ = true;
+}
+
 void MockBuilder::setDeviceInfo(
     const string& unique_id, const BuildInfo& element_info) {
   if (!result_) {
+    if (arena_size_.has_value()) {
+      arena_ = make_shared<MockArena>(*arena_size_);
+    }
     result_ = make_unique<NiceMock<DeviceMock>>(
         unique_id, FullMetaInfo{element_info.name, element_info.description});
+    empty_groups_ = {""};
+    if (record_prototype_) {
+      prototype_ = shared_ptr<DevicePrototype>(
+          new DevicePrototype(unique_id, element_info, arena_size_, fakes_));
+      prototype_groups_ = {{"", 0}};
+    }
   } else {
     throw DeviceBuildInProgress();
   }
@@ -25,9 +241,15 @@ string MockBuilder::addGroup(
   checkBase();
 
   auto id = assignID(parent_id);
-  auto group = make_shared<NiceMock<GroupMock>>(id);
+  auto group = makeMock<GroupMock>(arena_, id);
   subgroups_.try_emplace(id, group);
   addElementMock(group, id, element_info);
+  fillGroup(parent_id);
+  empty_groups_.insert(id);
+  if (prototype_) {
+    prototype_groups_.try_emplace(
+        id, prototype_->add(prototypeGroup(parent_id), element_info, nullptr));
+  }
   return id;
 }
 
@@ -43,14 +265,24 @@ string MockBuilder::addReadable(
 
 string MockBuilder::addReadable(const string& parent_id,
     const BuildInfo& element_info, DataType data_type) {
-  auto readable = make_shared<NiceMock<ReadableMock>>(data_type);
-  return makeElementMock(parent_id, readable, element_info);
+  return makeElementMock(parent_id,
+      element_info,
+      [fakes = fakes_, data_type](
+          const MockArenaPtr& arena) -> ElementFunction {
+        return makeFunctionMock<ReadableMock>(fakes, arena, data_type);
+      })
+      .first;
 }
 
 string MockBuilder::addReadable(const string& parent_id,
     const BuildInfo& element_info, const DataVariant& default_value) {
-  auto readable = make_shared<NiceMock<ReadableMock>>(default_value);
-  return makeElementMock(parent_id, readable, element_info);
+  return makeElementMock(parent_id,
+      element_info,
+      [fakes = fakes_, default_value](
+          const MockArenaPtr& arena) -> ElementFunction {
+        return makeFunctionMock<ReadableMock>(fakes, arena, default_value);
+      })
+      .first;
 }
 
 string MockBuilder::addReadable(const BuildInfo& element_info,
@@ -68,8 +300,13 @@ string MockBuilder::addReadable(const string& parent_id,
     throw invalid_argument("ReadCallback can not be nullptr");
   }
 
-  auto readable = make_shared<NiceMock<ReadableMock>>(data_type, read_cb);
-  return makeElementMock(parent_id, readable, element_info);
+  return makeElementMock(parent_id,
+      element_info,
+      [fakes = fakes_, data_type, read_cb](
+          const MockArenaPtr& arena) -> ElementFunction {
+        return makeFunctionMock<ReadableMock>(fakes, arena, data_type, read_cb);
+      })
+      .first;
 }
 
 string MockBuilder::addWritable(
@@ -84,14 +321,24 @@ string MockBuilder::addWritable(
 
 string MockBuilder::addWritable(const string& parent_id,
     const BuildInfo& element_info, DataType data_type) {
-  auto writable = make_shared<NiceMock<WritableMock>>(data_type);
-  return makeElementMock(parent_id, writable, element_info);
+  return makeElementMock(parent_id,
+      element_info,
+      [fakes = fakes_, data_type](
+          const MockArenaPtr& arena) -> ElementFunction {
+        return makeFunctionMock<WritableMock>(fakes, arena, data_type);
+      })
+      .first;
 }
 
 string MockBuilder::addWritable(const string& parent_id,
     const BuildInfo& element_info, const DataVariant& default_value) {
-  auto writable = make_shared<NiceMock<WritableMock>>(default_value);
-  return makeElementMock(parent_id, writable, element_info);
+  return makeElementMock(parent_id,
+      element_info,
+      [fakes = fakes_, default_value](
+          const MockArenaPtr& arena) -> ElementFunction {
+        return makeFunctionMock<WritableMock>(fakes, arena, default_value);
+      })
+      .first;
 }
 
 string MockBuilder::addWritable(const BuildInfo& element_info,
@@ -110,9 +357,14 @@ string MockBuilder::addWritable(const string& parent_id,
     throw invalid_argument("WriteCallback can not be nullptr");
   }
 
-  auto writable =
-      make_shared<NiceMock<WritableMock>>(data_type, read_cb, write_cb);
-  return makeElementMock(parent_id, writable, element_info);
+  return makeElementMock(parent_id,
+      element_info,
+      [fakes = fakes_, data_type, read_cb, write_cb](
+          const MockArenaPtr& arena) -> ElementFunction {
+        return makeFunctionMock<WritableMock>(
+            fakes, arena, data_type, read_cb, write_cb);
+      })
+      .first;
 }
 
 pair<string, MockBuilder::NotifyCallback> MockBuilder::addObservable(
@@ -134,12 +386,14 @@ pair<string, MockBuilder::NotifyCallback> MockBuilder::addObservable(
     throw invalid_argument("IsObservingCallback can not be nullptr");
   }
 
-  auto observable = make_shared<NiceMock<ObservableMock>>(data_type);
-  observable->enableSubscribeFaking(observe_cb);
-  auto id = makeElementMock(parent_id, observable, element_info);
+  auto [id, function] = makeElementMock(parent_id,
+      element_info,
+      [fakes = fakes_, data_type, observe_cb](
+          const MockArenaPtr& arena) -> ElementFunction {
+        return makeObservableMock(fakes, arena, observe_cb, data_type);
+      });
 
-  return make_pair(
-      id, bind(&ObservableMock::notify, observable, placeholders::_1));
+  return make_pair(id, makeNotifier(function));
 }
 
 pair<string, MockBuilder::NotifyCallback> MockBuilder::addObservable(
@@ -149,12 +403,14 @@ pair<string, MockBuilder::NotifyCallback> MockBuilder::addObservable(
     throw invalid_argument("IsObservingCallback can not be nullptr");
   }
 
-  auto observable = make_shared<NiceMock<ObservableMock>>(default_value);
-  observable->enableSubscribeFaking(observe_cb);
-  auto id = makeElementMock(parent_id, observable, element_info);
+  auto [id, function] = makeElementMock(parent_id,
+      element_info,
+      [fakes = fakes_, default_value, observe_cb](
+          const MockArenaPtr& arena) -> ElementFunction {
+        return makeObservableMock(fakes, arena, observe_cb, default_value);
+      });
 
-  return make_pair(
-      id, bind(&ObservableMock::notify, observable, placeholders::_1));
+  return make_pair(id, makeNotifier(function));
 }
 
 pair<string, MockBuilder::NotifyCallback> MockBuilder::addObservable(
@@ -176,11 +432,13 @@ pair<string, MockBuilder::NotifyCallback> MockBuilder::addObservable(
     throw invalid_argument("IsObservingCallback can not be nullptr");
   }
 
-  auto observable = make_shared<NiceMock<ObservableMock>>(data_type, read_cb);
-  observable->enableSubscribeFaking(observe_cb);
-  auto id = makeElementMock(parent_id, observable, element_info);
-  return make_pair(
-      id, bind(&ObservableMock::notify, observable, placeholders::_1));
+  auto [id, function] = makeElementMock(parent_id,
+      element_info,
+      [fakes = fakes_, data_type, read_cb, observe_cb](
+          const MockArenaPtr& arena) -> ElementFunction {
+        return makeObservableMock(fakes, arena, observe_cb, data_type, read_cb);
+      });
+  return make_pair(id, makeNotifier(function));
 }
 
 string MockBuilder::addCallable(const BuildInfo& element_info,
@@ -196,9 +454,14 @@ string MockBuilder::addCallable(
 string MockBuilder::addCallable(const string& parent_id,
     const BuildInfo& element_info, DataType result_type,
     const ParameterTypes& parameter_types) {
-  auto callable =
-      make_shared<NiceMock<CallableMock>>(result_type, parameter_types);
-  return makeElementMock(parent_id, callable, element_info);
+  return makeElementMock(parent_id,
+      element_info,
+      [fakes = fakes_, result_type, parameter_types](
+          const MockArenaPtr& arena) -> ElementFunction {
+        return makeFunctionMock<CallableMock>(
+            fakes, arena, result_type, parameter_types);
+      })
+      .first;
 }
 
 string MockBuilder::addCallable(const string& parent_id,
@@ -207,8 +470,12 @@ string MockBuilder::addCallable(const string& parent_id,
     throw invalid_argument("Executor can not be nullptr");
   }
 
-  auto callable = make_shared<NiceMock<CallableMock>>(executor);
-  return makeElementMock(parent_id, callable, element_info);
+  return makeElementMock(parent_id,
+      element_info,
+      [fakes = fakes_, executor](const MockArenaPtr& arena) -> ElementFunction {
+        return makeFunctionMock<CallableMock>(fakes, arena, executor);
+      })
+      .first;
 }
 
 string MockBuilder::addCallable(const BuildInfo& element_info,
@@ -223,9 +490,14 @@ string MockBuilder::addCallable(const string& parent_id,
     throw invalid_argument("ExecuteCallback can not be nullptr");
   }
 
-  auto callable =
-      make_shared<NiceMock<CallableMock>>(execute_cb, parameter_types);
-  return makeElementMock(parent_id, callable, element_info);
+  return makeElementMock(parent_id,
+      element_info,
+      [fakes = fakes_, execute_cb, parameter_types](
+          const MockArenaPtr& arena) -> ElementFunction {
+        return makeFunctionMock<CallableMock>(
+            fakes, arena, execute_cb, parameter_types);
+      })
+      .first;
 }
 
 string MockBuilder::addCallable(const BuildInfo& element_info,
@@ -254,9 +526,87 @@ string MockBuilder::addCallable(const string& parent_id,
     throw invalid_argument("CancelCallback can not be nullptr");
   }
 
-  auto callable = make_shared<NiceMock<CallableMock>>(
-      result_type, execute_cb, async_execute_cb, cancel_cb, parameter_types);
-  return makeElementMock(parent_id, callable, element_info);
+  return makeElementMock(parent_id,
+      element_info,
+      [fakes = fakes_,
+          result_type,
+          execute_cb,
+          async_execute_cb,
+          cancel_cb,
+          parameter_types](const MockArenaPtr& arena) -> ElementFunction {
+        return makeFunctionMock<CallableMock>(fakes,
+            arena,
+            result_type,
+            execute_cb,
+            async_execute_cb,
+            cancel_cb,
+            parameter_types);
+      })
+      .first;
+}
+
+vector<string> MockBuilder::addElements(
+    const string& parent_id, const vector<ElementDescriptor>& descriptors) {
+  checkBase();
+  for (const auto& descriptor : descriptors) {
+    if (descriptor.type == ElementType::Group) {
+      throw invalid_argument("Groups can not be added in bulk");
+    }
+    if (descriptor.type == ElementType::Callable &&
+        descriptor.default_value.has_value()) {
+      throw invalid_argument("Callable elements do not support default values");
+    }
+    if (descriptor.type == ElementType::Callable &&
+        descriptor.latency > chrono::nanoseconds::zero()) {
+      throw invalid_argument("Callable elements do not support latency");
+    }
+  }
+  GroupMockPtr parent;
+  if (!parent_id.empty()) {
+    parent = getParentGroup(parent_id);
+  }
+
+  auto ids = insertElements(parent_id, parent, descriptors);
+  // only record the elements once they were added, so a throwing insert
+  // leaves the build as it was
+  recordElements(parent_id, descriptors);
+  if (!descriptors.empty()) {
+    fillGroup(parent_id);
+  }
+  return ids;
+}
+
+vector<string> MockBuilder::insertElements(const string& parent_id,
+    const GroupMockPtr& parent,
+    const vector<ElementDescriptor>& descriptors) {
+  auto runs = make_shared<const DescriptorRuns>(descriptors);
+  // lazy factories outlive this builder, so they hold their own arena
+  // reference
+  auto factory = [runs, arena = arena_, fakes = fakes_](
+                     size_t offset, const string& id) {
+    return makeElement(fakes, arena, runs->at(offset), id);
+  };
+  // either way, the IDs are only taken once all of the elements are added
+  size_t first_index = 0;
+  string path_id = parent_id;
+  if (parent) {
+    first_index = lazy_elements_
+        ? parent->addLazyElements(descriptors.size(), factory)
+        : parent->addElements(descriptors.size(), factory);
+  } else {
+    first_index = lazy_elements_
+        ? result_->addLazyElements(descriptors.size(), factory)
+        : result_->addElements(descriptors.size(), factory);
+    path_id = result_->id() + IdPath::DEVICE_SEPARATOR;
+  }
+
+  IdPath path(path_id);
+  vector<string> ids;
+  ids.reserve(descriptors.size());
+  for (size_t offset = 0; offset < descriptors.size(); ++offset) {
+    ids.push_back(path.childId(first_index + offset));
+  }
+  return ids;
 }
 
 GroupMockPtr MockBuilder::getParentGroup(const string& parent_id) {
@@ -277,20 +627,49 @@ string MockBuilder::assignID(const string& parent_id) {
   }
 }
 
-string MockBuilder::makeElementMock(const string& parent_id,
-    const ElementFunction& function, const BuildInfo& element_info) {
+pair<string, ElementFunction> MockBuilder::makeElementMock(
+    const string& parent_id,
+    const BuildInfo& element_info,
+    const DevicePrototype::FunctionFactory& factory) {
   checkBase();
 
   auto id = assignID(parent_id);
+  auto function = factory(arena_);
   addElementMock(function, id, element_info);
-  return id;
+  fillGroup(parent_id);
+  if (prototype_) {
+    prototype_->add(prototypeGroup(parent_id), element_info, factory);
+  }
+  return make_pair(id, function);
+}
+
+size_t MockBuilder::prototypeGroup(const string& parent_id) const {
+  return prototype_groups_.at(parent_id);
+}
+
+void MockBuilder::recordElements(
+    const string& parent_id, const vector<ElementDescriptor>& descriptors) {
+  if (!prototype_) {
+    return;
+  }
+  auto group = prototypeGroup(parent_id);
+  auto runs = make_shared<const DescriptorRuns>(descriptors);
+  for (size_t offset = 0; offset < descriptors.size(); ++offset) {
+    prototype_->add(group,
+        descriptors[offset].info,
+        [runs, offset, fakes = fakes_](const MockArenaPtr& arena) {
+          return makeFunction(fakes, arena, runs->at(offset));
+        });
+  }
 }
 
 void MockBuilder::addElementMock(const ElementFunction& function,
     const std::string& id, const BuildInfo& element_info) {
-  auto element = make_shared<NiceMock<ElementMock>>(
-      function, id, FullMetaInfo{element_info.name, element_info.description});
-  result_->addElement(element);
+  result_->addElement(wrapFunction(fakes_, arena_, function, id, element_info));
+}
+
+void MockBuilder::fillGroup(const string& parent_id) {
+  empty_groups_.erase(parent_id);
 }
 
 void MockBuilder::checkBase() const {
@@ -300,21 +679,41 @@ void MockBuilder::checkBase() const {
 }
 
 void MockBuilder::checkGroups() const {
-  if (result_->group()->size() == 0) {
-    throw GroupEmpty(result_->id());
+  if (empty_groups_.empty()) {
+    return;
   }
-  for (const auto& [id, group] : subgroups_) {
-    if (group->size() == 0) {
-      throw GroupEmpty(result_->id(), id);
-    }
+  if (empty_groups_.count("") != 0) {
+    throw GroupEmpty(result_->id());
   }
+  throw GroupEmpty(result_->id(), *empty_groups_.begin());
 }
 
 unique_ptr<Device> MockBuilder::result() {
   checkBase();
   checkGroups();
+  unique_ptr<Device> device = move(result_);
+  abandonBuild();
+  return device;
+}
+
+void MockBuilder::abandonBuild() {
+  result_.reset();
   subgroups_.clear();
-  return move(result_);
+  empty_groups_.clear();
+  prototype_groups_.clear();
+  prototype_.reset();
+  // built mocks keep the arena alive on their own
+  arena_.reset();
+}
+
+DevicePrototypePtr MockBuilder::resultPrototype() {
+  checkBase();
+  if (!prototype_) {
+    throw logic_error("Prototype recording is not enabled");
+  }
+  auto prototype = prototype_;
+  result();
+  return prototype;
 }
 
 } // namespace Information_Model::testing
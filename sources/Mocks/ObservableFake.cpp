@@ -0,0 +1,75 @@
+#include "ObservableFake.hpp"
+
+namespace Information_Model::testing {
+using namespace std;
+
+ObservableFake::ObservableFake() : registry_(make_shared<ObserverRegistry>()) {}
+
+ObservableFake::ObservableFake(DataType type)
+    : readable_(type), registry_(make_shared<ObserverRegistry>()) {}
+
+ObservableFake::ObservableFake(const DataVariant& value)
+    : readable_(value), registry_(make_shared<ObserverRegistry>()) {}
+
+ObservableFake::ObservableFake(DataType type, const ReadCallback& read_cb)
+    : readable_(type, read_cb), registry_(make_shared<ObserverRegistry>()) {}
+
+void ObservableFake::enableSubscribeFaking(
+    const IsObservingCallback& callback) {
+  faking_ = static_cast<bool>(callback);
+  if (callback) {
+    registry_->setObservingCallback(callback);
+  }
+}
+
+void ObservableFake::enableParallelDispatch(const WorkerPoolPtr& pool) {
+  registry_->setWorkerPool(pool);
+}
+
+ObserverPtr ObservableFake::subscribe(
+    const Observable::ObserveCallback& callback,
+    const Observable::ExceptionHandler& handler,
+    const NotificationFilter& filter) {
+  ObservableMock::checkFilter(filter, readable_);
+  return registry_->attach(callback, handler, filter);
+}
+
+void ObservableFake::enableLatencyTracking(bool enable) {
+  registry_->enableLatencyTracking(enable);
+}
+
+vector<ObserverLatency> ObservableFake::latencies() const {
+  return registry_->latencies();
+}
+
+void ObservableFake::updateType(DataType type) { readable_.updateType(type); }
+
+void ObservableFake::updateValue(const DataVariant& value) {
+  readable_.updateValue(value);
+}
+
+void ObservableFake::updateReadCallback(const ReadCallback& read_cb) {
+  readable_.updateReadCallback(read_cb);
+}
+
+void ObservableFake::notify(const DataVariant& value) {
+  registry_->dispatch(value);
+}
+
+void ObservableFake::notify(DataVariant&& value) {
+  registry_->dispatch(move(value));
+}
+
+DataType ObservableFake::dataType() const { return readable_.dataType(); }
+
+DataVariant ObservableFake::read() const { return readable_.read(); }
+
+ObserverPtr ObservableFake::subscribe(
+    const Observable::ObserveCallback& callback,
+    const Observable::ExceptionHandler& handler) {
+  if (!faking_) {
+    return make_shared<Observer>();
+  }
+  return registry_->attach(callback, handler, nullopt);
+}
+} // namespace Information_Model::testing
@@ -1,19 +1,37 @@
 #include "ObservableMock.hpp"
 
+#include <vector>
+
 namespace Information_Model::testing {
 using namespace std;
 using namespace ::testing;
 
+bool isNumeric(DataType type) {
+  return type == DataType::Integer || type == DataType::Unsigned_Integer ||
+      type == DataType::Double;
+}
+
+ObservableMock::ObservableMock()
+    : readable_(make_shared<NiceMock<ReadableMock>>()),
+      registry_(make_shared<ObserverRegistry>()) {
+  setReadableCalls();
+}
+
 ObservableMock::ObservableMock(DataType type)
-    : readable_(make_shared<NiceMock<ReadableMock>>(type)) {}
+    : readable_(make_shared<NiceMock<ReadableMock>>(type)),
+      registry_(make_shared<ObserverRegistry>()) {
+  setReadableCalls();
+}
 
 ObservableMock::ObservableMock(const DataVariant& value)
-    : readable_(make_shared<NiceMock<ReadableMock>>(value)) {
+    : readable_(make_shared<NiceMock<ReadableMock>>(value)),
+      registry_(make_shared<ObserverRegistry>()) {
   setReadableCalls();
 }
 
 ObservableMock::ObservableMock(DataType type, const ReadCallback& read_cb)
-    : readable_(make_shared<NiceMock<ReadableMock>>(type, read_cb)) {
+    : readable_(make_shared<NiceMock<ReadableMock>>(type, read_cb)),
+      registry_(make_shared<ObserverRegistry>()) {
   setReadableCalls();
 }
 
@@ -27,14 +45,47 @@ void ObservableMock::setReadableCalls() const {
 void ObservableMock::enableSubscribeFaking(
     const IsObservingCallback& callback) {
   if (callback) {
-    is_observing_ = callback;
+    registry_->setObservingCallback(callback);
     ON_CALL(*this, subscribe)
-        .WillByDefault(Invoke(this, &ObservableMock::attachObserver));
+        .WillByDefault([this](const Observable::ObserveCallback& callback,
+                           const Observable::ExceptionHandler& handler) {
+          return attachObserver(callback, handler, nullopt);
+        });
   } else {
     ON_CALL(*this, subscribe).WillByDefault(Return(make_shared<Observer>()));
   }
 }
 
+void notifyTogether(
+    const vector<pair<ObservableMockPtr, DataVariant>>& notifications) {
+  vector<ObserverRegistry*> registries;
+  registries.reserve(notifications.size());
+  for (const auto& [observable, _] : notifications) {
+    if (!observable) {
+      throw invalid_argument("Given observable is empty");
+    }
+    registries.push_back(observable->registry_.get());
+  }
+  auto locks = ObserverRegistry::lockDispatch(move(registries));
+
+  auto notified_at = ObserverRegistry::Clock::now();
+  for (const auto& [observable, value] : notifications) {
+    observable->registry_->dispatchLocked(value, notified_at);
+  }
+}
+
+void ObservableMock::enableParallelDispatch(const WorkerPoolPtr& pool) {
+  registry_->setWorkerPool(pool);
+}
+
+void ObservableMock::enableLatencyTracking(bool enable) {
+  registry_->enableLatencyTracking(enable);
+}
+
+vector<ObserverLatency> ObservableMock::latencies() const {
+  return registry_->latencies();
+}
+
 void ObservableMock::updateType(DataType type) { readable_->updateType(type); }
 
 void ObservableMock::updateValue(const DataVariant& value) {
@@ -45,64 +96,44 @@ void ObservableMock::updateReadCallback(const ReadCallback& read_cb) {
   readable_->updateReadCallback(read_cb);
 }
 
-struct FakeObserver : public ObserverPimpl {
-  explicit FakeObserver(const Observable::ObserveCallback& callback,
-      const Observable::ExceptionHandler& handler)
-      : callback_(callback), handler_(handler) {}
-
-  ~FakeObserver() override = default;
-
-  void dispatch(const shared_ptr<DataVariant>& value) override {
-    unique_lock guard(mx_);
-    try {
-      callback_(value);
-    } catch (...) {
-      handler_(current_exception());
-    }
-  }
-
-private:
-  mutex mx_;
-  Observable::ObserveCallback callback_;
-  Observable::ExceptionHandler handler_;
-};
-
 ObserverPtr ObservableMock::attachObserver(
     const Observable::ObserveCallback& callback,
-    const Observable::ExceptionHandler& handler) {
-  if (!callback) {
-    throw invalid_argument("ObserveCallback can not be empty");
-  }
+    const Observable::ExceptionHandler& handler,
+    const optional<NotificationFilter>& filter) {
+  return registry_->attach(callback, handler, filter);
+}
 
-  if (!handler) {
-    throw invalid_argument("ExceptionHandler can not be empty");
+void ObservableMock::checkFilter(
+    const NotificationFilter& filter, const Readable& readable) {
+  if (filter.min_interval < chrono::nanoseconds::zero()) {
+    throw invalid_argument("Minimum interval can not be negative");
   }
-
-  unique_lock guard(mx_);
-  auto was_empty = observers_.empty();
-  auto observer = make_shared<FakeObserver>(callback, handler);
-  observers_.emplace_back(observer);
-  if (was_empty) {
-    is_observing_(true);
+  if (filter.absolute_deadband || filter.percent_deadband) {
+    if (filter.absolute_deadband.value_or(0) < 0 ||
+        filter.percent_deadband.value_or(0) < 0) {
+      throw invalid_argument("Deadband can not be negative");
+    }
+    auto type = readable.dataType();
+    if (!isNumeric(type)) {
+      throw invalid_argument(
+          "Deadband can not be used for " + toString(type) + " data type");
+    }
   }
-  return observer;
+}
+
+ObserverPtr ObservableMock::subscribe(
+    const Observable::ObserveCallback& callback,
+    const Observable::ExceptionHandler& handler,
+    const NotificationFilter& filter) {
+  checkFilter(filter, *readable_);
+  return attachObserver(callback, handler, filter);
 }
 
 void ObservableMock::notify(const DataVariant& value) {
-  unique_lock guard(mx_);
-  { // we want value_ptr to run out of scope and be destroyed
-    auto value_ptr = make_shared<DataVariant>(value);
-    for (auto it = observers_.begin(); it != observers_.end();) {
-      if (auto observer = it->lock()) {
-        observer->dispatch(value_ptr);
-        ++it;
-      } else {
-        it = observers_.erase(it);
-      }
-    }
-  }
-  if (observers_.empty()) {
-    is_observing_(false);
-  }
+  registry_->dispatch(value);
+}
+
+void ObservableMock::notify(DataVariant&& value) {
+  registry_->dispatch(move(value));
 }
 } // namespace Information_Model::testing
@@ -0,0 +1,485 @@
+#include "ObserverRegistry.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Information_Model::testing {
+using namespace std;
+
+// latencies of up to this many released observers are exported separately,
+// any further ones are merged into the oldest released record
+constexpr size_t MAX_RELEASED_LATENCIES = 256;
+
+size_t retainedCapacity(const DataVariant& value) {
+  if (const auto* text = get_if<string>(&value)) {
+    return text->capacity();
+  }
+  if (const auto* bytes = get_if<vector<uint8_t>>(&value)) {
+    return bytes->capacity();
+  }
+  return 0;
+}
+
+struct PayloadPool : public enable_shared_from_this<PayloadPool> {
+  /**
+   * @brief Returns a payload buffer holding the given value. Buffers are
+   * handed back to the pool once the last observer released them and are
+   * then reused, so copy assigned values keep the previously allocated
+   * capacity and moved values are not copied
+   *
+   */
+  template <typename Value> shared_ptr<DataVariant> acquire(Value&& value) {
+    unique_ptr<DataVariant> buffer;
+    {
+      scoped_lock guard(mx_);
+      if (!free_.empty()) {
+        buffer = move(free_.back());
+        free_.pop_back();
+      }
+    }
+    if (buffer) {
+      *buffer = forward<Value>(value);
+    } else {
+      buffer = make_unique<DataVariant>(forward<Value>(value));
+    }
+    // observers can keep the payload past the lifetime of this pool
+    return shared_ptr<DataVariant>(buffer.release(),
+        [pool = weak_from_this()](DataVariant* released) {
+          unique_ptr<DataVariant> owned(released);
+          if (auto alive = pool.lock()) {
+            alive->recycle(move(owned));
+          }
+        });
+  }
+
+private:
+  static constexpr size_t MAX_POOLED_PAYLOADS = 8;
+  // larger buffers are freed, so a single large notification does not pin
+  // its memory for the lifetime of the observable
+  static constexpr size_t MAX_RETAINED_CAPACITY = 64 * 1024;
+
+  void recycle(unique_ptr<DataVariant> buffer) {
+    if (retainedCapacity(*buffer) > MAX_RETAINED_CAPACITY) {
+      return;
+    }
+    scoped_lock guard(mx_);
+    if (free_.size() < MAX_POOLED_PAYLOADS) {
+      free_.push_back(move(buffer));
+    }
+  }
+
+  mutex mx_;
+  vector<unique_ptr<DataVariant>> free_;
+};
+
+struct LatencyRecord {
+  void record(chrono::nanoseconds notify_to_dispatch,
+      chrono::nanoseconds dispatch_to_return) {
+    scoped_lock guard(mx_);
+    latency_.notify_to_dispatch.record(notify_to_dispatch);
+    latency_.dispatch_to_return.record(dispatch_to_return);
+  }
+
+  ObserverLatency snapshot() {
+    scoped_lock guard(mx_);
+    return latency_;
+  }
+
+  void merge(LatencyRecord& other) {
+    scoped_lock guard(mx_, other.mx_);
+    latency_.notify_to_dispatch.merge(other.latency_.notify_to_dispatch);
+    latency_.dispatch_to_return.merge(other.latency_.dispatch_to_return);
+  }
+
+  // guarded by the mutex of the owning registry
+  bool released = false;
+
+private:
+  mutex mx_;
+  ObserverLatency latency_;
+};
+
+optional<double> toNumber(const DataVariant& value) {
+  if (holds_alternative<intmax_t>(value)) {
+    return static_cast<double>(get<intmax_t>(value));
+  } else if (holds_alternative<uintmax_t>(value)) {
+    return static_cast<double>(get<uintmax_t>(value));
+  } else if (holds_alternative<double>(value)) {
+    return get<double>(value);
+  } else {
+    return nullopt;
+  }
+}
+
+struct FilterState {
+  using Clock = chrono::steady_clock;
+
+  explicit FilterState(const NotificationFilter& filter) : filter_(filter) {}
+
+  /**
+   * @brief Checks if the given value passes the filter and remembers it as the
+   * last dispatched value if it does. Only called while dispatching, so
+   * notifications are serialized
+   *
+   */
+  bool accept(const DataVariant& value, Clock::time_point now) {
+    if (last_.has_value()) {
+      if (now - last_at_ < filter_.min_interval) {
+        return false;
+      }
+      if (filter_.on_change && value == *last_) {
+        return false;
+      }
+      if (!exceedsDeadbands(value)) {
+        return false;
+      }
+    }
+    last_ = value;
+    last_at_ = now;
+    return true;
+  }
+
+private:
+  bool exceedsDeadbands(const DataVariant& value) const {
+    if (!filter_.absolute_deadband && !filter_.percent_deadband) {
+      return true;
+    }
+    auto current = toNumber(value);
+    auto last = toNumber(*last_);
+    if (!current || !last) {
+      // type was changed to a non numeric one, fall back to change detection
+      return value != *last_;
+    }
+    auto change = fabs(*current - *last);
+    if (filter_.absolute_deadband && change <= *filter_.absolute_deadband) {
+      return false;
+    }
+    if (filter_.percent_deadband &&
+        change <= fabs(*last) * *filter_.percent_deadband / 100) {
+      return false;
+    }
+    return true;
+  }
+
+  NotificationFilter filter_;
+  optional<DataVariant> last_;
+  Clock::time_point last_at_;
+};
+
+struct FakeObserver : public ObserverPimpl {
+  FakeObserver(const weak_ptr<ObserverRegistry>& registry,
+      const Observable::ObserveCallback& callback,
+      const Observable::ExceptionHandler& handler)
+      : registry_(registry), callback_(callback), handler_(handler) {}
+
+  ~FakeObserver() override {
+    if (slot_ == UNASSIGNED) {
+      return;
+    }
+    if (auto registry = registry_.lock()) {
+      registry->release(slot_);
+    }
+  }
+
+  void assignSlot(size_t slot) { slot_ = slot; }
+
+  void dispatch(const shared_ptr<DataVariant>& value) override {
+    unique_lock guard(mx_);
+    try {
+      callback_(value);
+    } catch (...) {
+      handler_(current_exception());
+    }
+  }
+
+private:
+  static constexpr size_t UNASSIGNED = numeric_limits<size_t>::max();
+
+  mutex mx_;
+  weak_ptr<ObserverRegistry> registry_;
+  size_t slot_ = UNASSIGNED;
+  Observable::ObserveCallback callback_;
+  Observable::ExceptionHandler handler_;
+};
+
+ObserverRegistry::ObserverRegistry() : payloads_(make_shared<PayloadPool>()) {}
+
+ObserverRegistry::~ObserverRegistry() = default;
+
+void ObserverRegistry::setObservingCallback(
+    const IsObservingCallback& callback) {
+  scoped_lock guard(mx_);
+  is_observing_ = callback;
+}
+
+ObserverPtr ObserverRegistry::attach(
+    const Observable::ObserveCallback& callback,
+    const Observable::ExceptionHandler& handler,
+    const optional<NotificationFilter>& filter) {
+  if (!callback) {
+    throw invalid_argument("ObserveCallback can not be empty");
+  }
+
+  if (!handler) {
+    throw invalid_argument("ExceptionHandler can not be empty");
+  }
+
+  auto observer =
+      make_shared<FakeObserver>(weak_from_this(), callback, handler);
+  observer->assignSlot(attachSlot(observer, filter));
+  // delivered once the slot is assigned, so a throwing is_observing_ call
+  // releases the right slot while the observer is destroyed
+  deliverTransitions();
+  return observer;
+}
+
+size_t ObserverRegistry::attachSlot(const shared_ptr<ObserverPimpl>& observer,
+    const optional<NotificationFilter>& filter) {
+  size_t slot;
+  {
+    scoped_lock guard(mx_);
+    if (free_slots_.empty()) {
+      slot = slots_.size();
+      slots_.emplace_back();
+    } else {
+      slot = free_slots_.back();
+      free_slots_.pop_back();
+    }
+    slots_[slot].observer = observer;
+    slots_[slot].filter = filter ? make_shared<FilterState>(*filter) : nullptr;
+    slots_[slot].latency = tracking_ ? makeLatencyRecord() : nullptr;
+    if (active_++ == 0) {
+      transitions_.push_back(true);
+    }
+  }
+  return slot;
+}
+
+void ObserverRegistry::release(size_t slot) {
+  {
+    scoped_lock guard(mx_);
+    if (slots_[slot].latency) {
+      slots_[slot].latency->released = true;
+      ++released_latencies_;
+    }
+    slots_[slot] = Slot{};
+    free_slots_.push_back(slot);
+    if (released_latencies_ > MAX_RELEASED_LATENCIES) {
+      foldReleasedLatencies();
+    }
+    if (--active_ == 0) {
+      transitions_.push_back(false);
+    }
+  }
+  try {
+    deliverTransitions();
+  } catch (...) {
+    // releases are made by observer destructors, so is_observing_ exceptions
+    // can not be propagated
+  }
+}
+
+void ObserverRegistry::deliverTransitions() {
+  unique_lock guard(mx_);
+  if (delivering_) {
+    // the delivering thread, which may be further up this call stack, also
+    // delivers the transitions queued in the meantime
+    return;
+  }
+  delivering_ = true;
+  // is_observing_ is called without holding mx_, so it may attach or release
+  // observers and dispatch notifications
+  while (!transitions_.empty()) {
+    auto observing = transitions_.front();
+    transitions_.pop_front();
+    auto is_observing = is_observing_;
+    guard.unlock();
+    try {
+      if (is_observing) {
+        is_observing(observing);
+      }
+    } catch (...) {
+      guard.lock();
+      delivering_ = false;
+      throw;
+    }
+    guard.lock();
+  }
+  delivering_ = false;
+}
+
+void ObserverRegistry::dispatch(const DataVariant& value) {
+  dispatchValue(value);
+}
+
+void ObserverRegistry::dispatch(DataVariant&& value) {
+  dispatchValue(move(value));
+}
+
+template <typename Value> void ObserverRegistry::dispatchValue(Value&& value) {
+  // taken before waiting for dispatch_mx_, so the wait counts as latency
+  auto notified_at = tracking_ ? Clock::now() : Clock::time_point{};
+  // serializes notifications, so every observer sees them in the same order
+  scoped_lock dispatch_guard(dispatch_mx_);
+  // tracking only changes while dispatch_mx_ is held, so decide again, in
+  // case it changed while waiting
+  if (!tracking_) {
+    notified_at = Clock::time_point{};
+  } else if (notified_at == Clock::time_point{}) {
+    notified_at = Clock::now();
+  }
+  dispatchValueLocked(forward<Value>(value), notified_at);
+}
+
+vector<unique_lock<mutex>> ObserverRegistry::lockDispatch(
+    vector<ObserverRegistry*> registries) {
+  // locking in address order prevents deadlocks between concurrent calls
+  sort(registries.begin(), registries.end());
+  registries.erase(
+      unique(registries.begin(), registries.end()), registries.end());
+  vector<unique_lock<mutex>> locks;
+  locks.reserve(registries.size());
+  for (auto* registry : registries) {
+    locks.emplace_back(registry->dispatch_mx_);
+  }
+  return locks;
+}
+
+void ObserverRegistry::dispatchLocked(
+    const DataVariant& value, Clock::time_point notified_at) {
+  dispatchValueLocked(value, notified_at);
+}
+
+void ObserverRegistry::dispatchLocked(
+    DataVariant&& value, Clock::time_point notified_at) {
+  dispatchValueLocked(move(value), notified_at);
+}
+
+template <typename Value>
+void ObserverRegistry::dispatchValueLocked(
+    Value&& value, Clock::time_point notified_at) {
+  {
+    scoped_lock guard(mx_);
+    live_.reserve(active_);
+    for (const auto& slot : slots_) {
+      if (auto observer = slot.observer.lock()) {
+        live_.push_back(
+            LiveObserver{move(observer), slot.filter, slot.latency});
+      }
+    }
+  }
+  applyFilters(value);
+  if (!live_.empty()) {
+    auto payload = payloads_->acquire(forward<Value>(value));
+    // observers are called without holding mx_, so they can unsubscribe or
+    // subscribe from within their callbacks
+    try {
+      if (pool_ && live_.size() > 1) {
+        pool_->parallelFor(
+            live_.size(), [this, &payload, notified_at](size_t i) {
+              dispatchTo(live_[i], payload, notified_at);
+            });
+      } else {
+        for (const auto& live : live_) {
+          dispatchTo(live, payload, notified_at);
+        }
+      }
+    } catch (...) {
+      // an exception handler threw, release the observers before rethrowing
+      live_.clear();
+      throw;
+    }
+    live_.clear();
+  }
+}
+
+void ObserverRegistry::setWorkerPool(const WorkerPoolPtr& pool) {
+  scoped_lock dispatch_guard(dispatch_mx_);
+  pool_ = pool;
+}
+
+void ObserverRegistry::enableLatencyTracking(bool enable) {
+  scoped_lock dispatch_guard(dispatch_mx_);
+  scoped_lock guard(mx_);
+  if (enable) {
+    latencies_.clear();
+    released_latencies_ = 0;
+    for (auto& slot : slots_) {
+      if (!slot.observer.expired()) {
+        slot.latency = makeLatencyRecord();
+      }
+    }
+  } else {
+    for (auto& slot : slots_) {
+      slot.latency = nullptr;
+    }
+  }
+  tracking_ = enable;
+}
+
+vector<ObserverLatency> ObserverRegistry::latencies() {
+  scoped_lock guard(mx_);
+  vector<ObserverLatency> result;
+  result.reserve(latencies_.size());
+  for (const auto& latency : latencies_) {
+    result.push_back(latency->snapshot());
+  }
+  return result;
+}
+
+void ObserverRegistry::applyFilters(const DataVariant& value) {
+  optional<Clock::time_point> now;
+  auto rejected = [&value, &now](const LiveObserver& live) {
+    if (!live.filter) {
+      return false;
+    }
+    if (!now) {
+      now = Clock::now();
+    }
+    return !live.filter->accept(value, *now);
+  };
+  live_.erase(remove_if(live_.begin(), live_.end(), rejected), live_.end());
+}
+
+shared_ptr<LatencyRecord> ObserverRegistry::makeLatencyRecord() {
+  return latencies_.emplace_back(make_shared<LatencyRecord>());
+}
+
+void ObserverRegistry::foldReleasedLatencies() {
+  // released records are no longer copied out of slots_, so once a record is
+  // only referenced by latencies_, no dispatch can record into it anymore
+  LatencyRecord* merged = nullptr;
+  released_latencies_ = 0;
+  auto kept = latencies_.begin();
+  for (auto it = latencies_.begin(); it != latencies_.end(); ++it) {
+    auto& latency = *it;
+    if (latency->released && merged && latency.use_count() == 1) {
+      merged->merge(*latency);
+      continue;
+    }
+    if (latency->released) {
+      merged = merged ? merged : latency.get();
+      ++released_latencies_;
+    }
+    if (kept != it) {
+      *kept = move(latency);
+    }
+    ++kept;
+  }
+  latencies_.erase(kept, latencies_.end());
+}
+
+void ObserverRegistry::dispatchTo(const LiveObserver& live,
+    const shared_ptr<DataVariant>& payload, Clock::time_point notified_at) {
+  if (live.latency) {
+    auto dispatched_at = Clock::now();
+    live.observer->dispatch(payload);
+    auto returned_at = Clock::now();
+    live.latency->record(
+        dispatched_at - notified_at, returned_at - dispatched_at);
+  } else {
+    live.observer->dispatch(payload);
+  }
+}
+} // namespace Information_Model::testing
@@ -0,0 +1,28 @@
+#include "ReadableFake.hpp"
+
+namespace Information_Model::testing {
+using namespace std;
+
+ReadableFake::ReadableFake(DataType type) : state_(type) {}
+
+ReadableFake::ReadableFake(const DataVariant& value) { updateValue(value); }
+
+ReadableFake::ReadableFake(DataType type, const ReadCallback& read_cb)
+    : ReadableFake(type) {
+  updateReadCallback(read_cb);
+}
+
+void ReadableFake::updateType(DataType type) { state_.updateType(type); }
+
+void ReadableFake::updateValue(const DataVariant& value) {
+  state_.updateValue(value);
+}
+
+void ReadableFake::updateReadCallback(const ReadCallback& read_cb) {
+  state_.updateReadCallback(read_cb);
+}
+
+DataType ReadableFake::dataType() const { return state_.type(); }
+
+DataVariant ReadableFake::read() const { return state_.read(); }
+} // namespace Information_Model::testing
@@ -0,0 +1,125 @@
+#include "ReadableState.hpp"
+
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace Information_Model::testing {
+using namespace std;
+
+constexpr size_t TRIVIAL_WORD_COUNT = 2;
+
+template <typename Value>
+constexpr bool IS_TRIVIAL = is_trivially_copyable_v<Value> &&
+    is_default_constructible_v<Value> &&
+    sizeof(Value) <= TRIVIAL_WORD_COUNT * sizeof(uint64_t);
+
+// copies a trivially copyable alternative into plain words, returns false for
+// any other alternative
+bool toWords(const DataVariant& value, uint64_t* words) {
+  return visit(
+      [words](const auto& alternative) {
+        using Alternative = decay_t<decltype(alternative)>;
+        if constexpr (IS_TRIVIAL<Alternative>) {
+          memcpy(words, &alternative, sizeof(Alternative));
+          return true;
+        } else {
+          return false;
+        }
+      },
+      value);
+}
+
+template <size_t Index = 0>
+DataVariant fromWords(size_t index, const uint64_t* words) {
+  if constexpr (Index < variant_size_v<DataVariant>) {
+    using Alternative = variant_alternative_t<Index, DataVariant>;
+    if constexpr (IS_TRIVIAL<Alternative>) {
+      if (index == Index) {
+        Alternative alternative;
+        memcpy(&alternative, words, sizeof(Alternative));
+        return DataVariant(in_place_index<Index>, alternative);
+      }
+    }
+    return fromWords<Index + 1>(index, words);
+  } else {
+    return DataVariant{};
+  }
+}
+
+ReadableState::ReadableState(DataType type) : type_(type) {}
+
+DataType ReadableState::type() const { return type_.load(); }
+
+DataVariant ReadableState::read() const {
+  uint64_t words[TRIVIAL_WORD_COUNT];
+  SourceKind kind;
+  size_t index;
+  while (true) {
+    auto begin = sequence_.load(memory_order_acquire);
+    if (begin % 2 != 0) {
+      this_thread::yield();
+      continue;
+    }
+    // acquire loads keep the sequence recheck after the copy
+    kind = kind_.load(memory_order_acquire);
+    index = trivial_index_.load(memory_order_acquire);
+    for (size_t word = 0; word < TRIVIAL_WORD_COUNT; ++word) {
+      words[word] = trivial_words_[word].load(memory_order_acquire);
+    }
+    if (sequence_.load(memory_order_relaxed) == begin) {
+      break;
+    }
+  }
+  if (kind == SourceKind::Empty) {
+    return DataVariant{};
+  }
+  if (kind == SourceKind::Trivial) {
+    return fromWords(index, words);
+  }
+  auto source = atomic_load(&source_);
+  if (source->read) {
+    return source->read();
+  }
+  if (source->unavailable) {
+    throw ReadCallbackUnavailable();
+  }
+  return source->value.value_or(DataVariant{});
+}
+
+void ReadableState::updateType(DataType type) { type_.store(type); }
+
+void ReadableState::updateValue(const DataVariant& value) {
+  uint64_t words[TRIVIAL_WORD_COUNT] = {};
+  scoped_lock guard(update_mx_);
+  if (toWords(value, words)) {
+    publish(SourceKind::Trivial, value.index(), words);
+  } else {
+    atomic_store(&source_,
+        SourcePtr(make_shared<Source>(Source{value, nullptr, false})));
+    publish(SourceKind::Snapshot, 0, words);
+  }
+  updateType(toDataType(value));
+}
+
+void ReadableState::updateReadCallback(const ReadCallback& read_cb) {
+  uint64_t words[TRIVIAL_WORD_COUNT] = {};
+  scoped_lock guard(update_mx_);
+  atomic_store(&source_,
+      SourcePtr(make_shared<Source>(Source{nullopt, read_cb, !read_cb})));
+  publish(SourceKind::Snapshot, 0, words);
+}
+
+void ReadableState::publish(
+    SourceKind kind, size_t index, const uint64_t* words) {
+  auto sequence = sequence_.load(memory_order_relaxed);
+  sequence_.store(sequence + 1, memory_order_relaxed);
+  // release stores keep the odd sequence ahead of the copy
+  kind_.store(kind, memory_order_release);
+  trivial_index_.store(index, memory_order_release);
+  for (size_t word = 0; word < TRIVIAL_WORD_COUNT; ++word) {
+    trivial_words_[word].store(words[word], memory_order_release);
+  }
+  sequence_.store(sequence + 2, memory_order_release);
+}
+} // namespace Information_Model::testing
@@ -0,0 +1,533 @@
+#include "TraceReplayer.hpp"
+#include "DataVariantParser.hpp"
+#include "DeviceMock.hpp"
+#include "MappedFile.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <string_view>
+
+namespace Information_Model::testing {
+using namespace std;
+
+constexpr string_view BINARY_TRACE_MAGIC = "STAGTRC1";
+
+struct TraceEvent {
+  int64_t timestamp = 0;
+  size_t column = 0;
+  DataVariant value;
+};
+
+struct TraceReader {
+  TraceReader(const string& path, string_view content)
+      : path_(path), content_(content) {}
+
+  virtual ~TraceReader() = default;
+
+  const vector<string>& columns() const { return columns_; }
+
+  size_t position() const { return position_; }
+
+  size_t skipped() const { return skipped_; }
+
+  /**
+   * @brief Sets the data type of each column, columns with DataType::None are
+   * skipped
+   *
+   */
+  void setColumnTypes(const vector<DataType>& types) { types_ = types; }
+
+  void rewind() {
+    position_ = records_begin_;
+    skipped_ = 0;
+    rewindRecord();
+  }
+
+  /**
+   * @brief Reads the next value of a mapped column
+   *
+   * @return false if the end of the trace was reached
+   */
+  virtual bool next(TraceEvent& event) = 0;
+
+protected:
+  virtual void rewindRecord() {}
+
+  [[noreturn]] void fail(const string& reason) const {
+    throw MalformedTrace(path_, position_, reason);
+  }
+
+  bool isMapped(size_t column) const {
+    return column < types_.size() && types_[column] != DataType::None;
+  }
+
+  string path_;
+  string_view content_;
+  size_t position_ = 0;
+  size_t records_begin_ = 0;
+  size_t skipped_ = 0;
+  vector<string> columns_;
+  vector<DataType> types_;
+};
+
+struct CSVTraceReader : public TraceReader {
+  CSVTraceReader(const string& path, string_view content)
+      : TraceReader(path, content) {
+    bool row_end = false;
+    while (!row_end) {
+      auto cell = nextCell(row_end);
+      if (!cell.has_value()) {
+        fail("Missing header row");
+      }
+      columns_.emplace_back(*cell);
+    }
+    if (columns_.size() < 2) {
+      fail("Header row must name the timestamp and at least one value column");
+    }
+    // first header cell names the timestamp column
+    columns_.erase(columns_.begin());
+    records_begin_ = position_;
+  }
+
+  bool next(TraceEvent& event) override {
+    while (true) {
+      if (column_ == NO_ROW) {
+        if (!startRow()) {
+          return false;
+        }
+      }
+      if (row_end_) {
+        column_ = NO_ROW;
+        continue;
+      }
+      auto column = column_++;
+      auto cell = nextCell(row_end_);
+      if (column >= columns_.size()) {
+        fail("Row has more cells than the header row");
+      }
+      if (!cell.has_value() || cell->empty()) {
+        continue;
+      }
+      if (!isMapped(column)) {
+        ++skipped_;
+        continue;
+      }
+      event.timestamp = timestamp_;
+      event.column = column;
+      try {
+        event.value = parseDataVariant(*cell, types_[column]);
+      } catch (const invalid_argument& ex) {
+        fail(ex.what());
+      }
+      return true;
+    }
+  }
+
+private:
+  static constexpr size_t NO_ROW = numeric_limits<size_t>::max();
+
+  void rewindRecord() override { column_ = NO_ROW; }
+
+  bool startRow() {
+    optional<string_view> cell;
+    do {
+      cell = nextCell(row_end_);
+      if (!cell.has_value()) {
+        return false;
+      }
+      // skip empty lines
+    } while (row_end_ && cell->empty());
+    try {
+      timestamp_ = get<intmax_t>(parseDataVariant(*cell, DataType::Integer));
+    } catch (const invalid_argument& ex) {
+      fail(ex.what());
+    }
+    column_ = 0;
+    return true;
+  }
+
+  /**
+   * @brief Reads the next cell, quoted cells that contain escaped quotes are
+   * unescaped into unquoted_
+   *
+   * @return std::nullopt if the end of the trace was reached
+   */
+  optional<string_view> nextCell(bool& row_end) {
+    if (position_ >= content_.size()) {
+      row_end = true;
+      return nullopt;
+    }
+    string_view cell;
+    if (content_[position_] == '"') {
+      cell = nextQuotedCell();
+    } else {
+      auto begin = position_;
+      while (position_ < content_.size() && content_[position_] != ',' &&
+          content_[position_] != '\n') {
+        ++position_;
+      }
+      cell = content_.substr(begin, position_ - begin);
+      if (!cell.empty() && cell.back() == '\r') {
+        cell.remove_suffix(1);
+      }
+    }
+    row_end = position_ >= content_.size() || content_[position_] == '\n';
+    if (position_ < content_.size()) {
+      ++position_; // consume the delimiter
+    }
+    return cell;
+  }
+
+  string_view nextQuotedCell() {
+    ++position_; // opening quote
+    auto begin = position_;
+    bool escaped = false;
+    while (true) {
+      if (position_ >= content_.size()) {
+        fail("Unterminated quoted cell");
+      }
+      if (content_[position_] == '"') {
+        if (position_ + 1 < content_.size() &&
+            content_[position_ + 1] == '"') {
+          escaped = true;
+          position_ += 2;
+          continue;
+        }
+        break;
+      }
+      ++position_;
+    }
+    auto cell = content_.substr(begin, position_ - begin);
+    ++position_; // closing quote
+    if (position_ < content_.size() && content_[position_] == '\r') {
+      ++position_;
+    }
+    if (!escaped) {
+      return cell;
+    }
+    unquoted_.clear();
+    for (size_t i = 0; i < cell.size(); ++i) {
+      unquoted_.push_back(cell[i]);
+      if (cell[i] == '"') {
+        ++i; // skip the escaping quote
+      }
+    }
+    return unquoted_;
+  }
+
+  size_t column_ = NO_ROW;
+  bool row_end_ = true;
+  int64_t timestamp_ = 0;
+  string unquoted_;
+};
+
+struct BinaryTraceReader : public TraceReader {
+  BinaryTraceReader(const string& path, string_view content)
+      : TraceReader(path, content) {
+    position_ = BINARY_TRACE_MAGIC.size();
+    auto count = read<uint32_t>();
+    // every column name takes at least its length, so a count that does not
+    // fit the file is rejected before reserving for it
+    if (count > (content_.size() - position_) / sizeof(uint16_t)) {
+      fail("Trace declares " + to_string(count) + " columns, but only " +
+          to_string(content_.size() - position_) + " bytes remain");
+    }
+    columns_.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+      auto length = read<uint16_t>();
+      columns_.emplace_back(readBytes(length));
+    }
+    records_begin_ = position_;
+  }
+
+  bool next(TraceEvent& event) override {
+    while (position_ < content_.size()) {
+      event.timestamp = read<int64_t>();
+      event.column = read<uint32_t>();
+      if (event.column >= columns_.size()) {
+        fail("Record refers to column " + to_string(event.column) +
+            ", but only " + to_string(columns_.size()) + " columns exist");
+      }
+      if (!isMapped(event.column)) {
+        skipValue(read<uint8_t>());
+        ++skipped_;
+        continue;
+      }
+      event.value = readValue(read<uint8_t>());
+      return true;
+    }
+    return false;
+  }
+
+private:
+  template <typename Number> Number read() {
+    Number result;
+    memcpy(&result, readBytes(sizeof(Number)).data(), sizeof(Number));
+    return result;
+  }
+
+  string_view readBytes(size_t count) {
+    if (content_.size() - position_ < count) {
+      fail("Unexpected end of trace");
+    }
+    auto result = content_.substr(position_, count);
+    position_ += count;
+    return result;
+  }
+
+  Timestamp readTimestamp() {
+    Timestamp timestamp{};
+    timestamp.year = read<uint16_t>();
+    timestamp.month = read<uint8_t>();
+    timestamp.day = read<uint8_t>();
+    timestamp.hours = read<uint8_t>();
+    timestamp.minutes = read<uint8_t>();
+    timestamp.seconds = read<uint8_t>();
+    timestamp.microseconds = read<uint32_t>();
+    return timestamp;
+  }
+
+  DataVariant readValue(uint8_t index) {
+    switch (static_cast<DataType>(index)) {
+    case DataType::Boolean: {
+      return read<uint8_t>() != 0;
+    }
+    case DataType::Integer: {
+      return static_cast<intmax_t>(read<int64_t>());
+    }
+    case DataType::Unsigned_Integer: {
+      return static_cast<uintmax_t>(read<uint64_t>());
+    }
+    case DataType::Double: {
+      return read<double>();
+    }
+    case DataType::Timestamp: {
+      return readTimestamp();
+    }
+    case DataType::Opaque: {
+      auto bytes = readBytes(read<uint32_t>());
+      return vector<uint8_t>(bytes.begin(), bytes.end());
+    }
+    case DataType::String: {
+      return string(readBytes(read<uint32_t>()));
+    }
+    default: {
+      fail("Unknown value type " + to_string(index));
+    }
+    }
+  }
+
+  void skipValue(uint8_t index) {
+    // only skips the bytes, without allocating
+    switch (static_cast<DataType>(index)) {
+    case DataType::Opaque:
+      [[fallthrough]];
+    case DataType::String: {
+      readBytes(read<uint32_t>());
+      break;
+    }
+    default: {
+      readValue(index);
+    }
+    }
+  }
+};
+
+unique_ptr<TraceReader> makeTraceReader(
+    const string& path, string_view content) {
+  if (content.substr(0, BINARY_TRACE_MAGIC.size()) == BINARY_TRACE_MAGIC) {
+    return make_unique<BinaryTraceReader>(path, content);
+  } else {
+    return make_unique<CSVTraceReader>(path, content);
+  }
+}
+
+struct TraceReplayer::Pimpl {
+  Pimpl(const string& trace_path, const Device& device,
+      const ColumnMapping& mapping)
+      : path(trace_path), file(trace_path, "trace"),
+        reader(makeTraceReader(trace_path, file.content())) {
+    const auto& columns = reader->columns();
+    observables.resize(columns.size());
+    vector<DataType> types(columns.size(), DataType::None);
+    for (const auto& [column, element_id] : mapping) {
+      auto it = find(columns.begin(), columns.end(), column);
+      if (it == columns.end()) {
+        throw invalid_argument(
+            "Column " + column + " does not exist in trace " + trace_path);
+      }
+      auto index = static_cast<size_t>(distance(columns.begin(), it));
+      auto element = device.element(element_id);
+      auto observable = element->type() == ElementType::Observable
+          ? get<ObservablePtr>(element->function())
+          : nullptr;
+      // dispatching through the registry notifies the same way as
+      // ObservableMock::notify() and ObservableFake::notify()
+      observables[index] =
+          observable ? DeviceMock::observers(observable) : nullptr;
+      if (!observables[index]) {
+        throw invalid_argument("Element " + element_id +
+            " is not an ObservableMock or ObservableFake");
+      }
+      types[index] = observable->dataType();
+    }
+    reader->setColumnTypes(types);
+  }
+
+  ReplayReport replay(double speed) {
+    using Clock = chrono::steady_clock;
+
+    ReplayReport report;
+    file.rewind();
+    reader->rewind();
+    bool paced = isfinite(speed);
+    auto start = Clock::now();
+    optional<int64_t> first_timestamp;
+    int64_t last_timestamp = numeric_limits<int64_t>::min();
+    TraceEvent event;
+    while (reader->next(event)) {
+      if (event.timestamp < last_timestamp) {
+        throw MalformedTrace(
+            path, reader->position(), "Timestamps must not decrease");
+      }
+      last_timestamp = event.timestamp;
+      if (!first_timestamp) {
+        first_timestamp = event.timestamp;
+      }
+      auto scheduled = start;
+      if (paced) {
+        scheduled += chrono::duration_cast<Clock::duration>(
+            chrono::duration<double, nano>(
+                static_cast<double>(event.timestamp - *first_timestamp) /
+                speed));
+      }
+      {
+        unique_lock lock(mx);
+        if (paced) {
+          stop_requested.wait_until(lock, scheduled, [this]() {
+            return stopping;
+          });
+        }
+        if (stopping) {
+          // each stop() ends a single replay, later replays run again
+          stopping = false;
+          break;
+        }
+      }
+      if (paced) {
+        report.lag.record(Clock::now() - scheduled);
+      }
+      observables[event.column]->dispatch(move(event.value));
+      ++report.dispatched;
+      file.release(reader->position());
+    }
+    report.skipped = reader->skipped();
+    report.duration = Clock::now() - start;
+    return report;
+  }
+
+  void stop() {
+    {
+      scoped_lock guard(mx);
+      stopping = true;
+    }
+    stop_requested.notify_all();
+  }
+
+  string path;
+  MappedFile file;
+  unique_ptr<TraceReader> reader;
+  vector<ObserverRegistryPtr> observables;
+  mutex mx;
+  condition_variable stop_requested;
+  bool stopping = false;
+};
+
+TraceReplayer::TraceReplayer(const string& trace_path, const Device& device,
+    const ColumnMapping& mapping)
+    : pimpl_(make_unique<Pimpl>(trace_path, device, mapping)) {}
+
+TraceReplayer::~TraceReplayer() = default;
+
+ReplayReport TraceReplayer::replay(double speed) {
+  if (!(speed > 0)) {
+    throw invalid_argument("Replay speed must be positive");
+  }
+  return pimpl_->replay(speed);
+}
+
+void TraceReplayer::stop() { pimpl_->stop(); }
+
+template <typename Number>
+void writeNumber(ofstream& stream, Number value) {
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(Number));
+}
+
+void writeBytes(ofstream& stream, const char* data, size_t size) {
+  writeNumber(stream, static_cast<uint32_t>(size));
+  stream.write(data, static_cast<streamsize>(size));
+}
+
+BinaryTraceWriter::BinaryTraceWriter(
+    const string& trace_path, const vector<string>& columns)
+    : trace_(trace_path, ios::binary | ios::trunc),
+      column_count_(columns.size()) {
+  if (!trace_) {
+    throw invalid_argument("Could not create trace file " + trace_path);
+  }
+  trace_.write(BINARY_TRACE_MAGIC.data(), BINARY_TRACE_MAGIC.size());
+  writeNumber(trace_, static_cast<uint32_t>(columns.size()));
+  for (const auto& column : columns) {
+    if (column.size() > numeric_limits<uint16_t>::max()) {
+      throw invalid_argument("Column name " + column + " is too long");
+    }
+    writeNumber(trace_, static_cast<uint16_t>(column.size()));
+    trace_.write(column.data(), static_cast<streamsize>(column.size()));
+  }
+}
+
+void BinaryTraceWriter::write(
+    chrono::nanoseconds timestamp, size_t column, const DataVariant& value) {
+  if (column >= column_count_) {
+    throw invalid_argument("Column " + to_string(column) + " does not exist");
+  }
+  writeNumber(trace_, static_cast<int64_t>(timestamp.count()));
+  writeNumber(trace_, static_cast<uint32_t>(column));
+  writeNumber(trace_, static_cast<uint8_t>(toDataType(value)));
+  visit(
+      [this](const auto& alternative) {
+        using Alternative = decay_t<decltype(alternative)>;
+        if constexpr (is_same_v<Alternative, bool>) {
+          writeNumber(trace_, static_cast<uint8_t>(alternative ? 1 : 0));
+        } else if constexpr (is_same_v<Alternative, intmax_t>) {
+          writeNumber(trace_, static_cast<int64_t>(alternative));
+        } else if constexpr (is_same_v<Alternative, uintmax_t>) {
+          writeNumber(trace_, static_cast<uint64_t>(alternative));
+        } else if constexpr (is_same_v<Alternative, double>) {
+          writeNumber(trace_, alternative);
+        } else if constexpr (is_same_v<Alternative, Timestamp>) {
+          writeNumber(trace_, alternative.year);
+          writeNumber(trace_, alternative.month);
+          writeNumber(trace_, alternative.day);
+          writeNumber(trace_, alternative.hours);
+          writeNumber(trace_, alternative.minutes);
+          writeNumber(trace_, alternative.seconds);
+          writeNumber(trace_, alternative.microseconds);
+        } else if constexpr (is_same_v<Alternative, vector<uint8_t>>) {
+          writeBytes(trace_,
+              reinterpret_cast<const char*>(alternative.data()),
+              alternative.size());
+        } else {
+          writeBytes(trace_, alternative.data(), alternative.size());
+        }
+      },
+      value);
+}
+
+void BinaryTraceWriter::flush() { trace_.flush(); }
+} // namespace Information_Model::testing
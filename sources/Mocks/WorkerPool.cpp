@@ -0,0 +1,214 @@
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+
+struct Batch {
+  explicit Batch(const WorkerPool::Task& task) : task_(task) {}
+
+  void run(size_t begin, size_t end) {
+    try {
+      for (auto i = begin; i < end; ++i) {
+        task_(i);
+      }
+    } catch (...) {
+      scoped_lock guard(mx_);
+      if (!error_) {
+        error_ = current_exception();
+      }
+    }
+    scoped_lock guard(mx_);
+    if (--pending_ == 0) {
+      done_.notify_all();
+    }
+  }
+
+  void expect(size_t chunks) {
+    scoped_lock guard(mx_);
+    pending_ += chunks;
+  }
+
+  bool finished() {
+    scoped_lock guard(mx_);
+    return pending_ == 0;
+  }
+
+  template <class Rep, class Period>
+  void waitFor(const chrono::duration<Rep, Period>& timeout) {
+    unique_lock guard(mx_);
+    done_.wait_for(guard, timeout, [this]() { return pending_ == 0; });
+  }
+
+  void rethrow() {
+    scoped_lock guard(mx_);
+    if (error_) {
+      rethrow_exception(error_);
+    }
+  }
+
+private:
+  const WorkerPool::Task& task_;
+  mutex mx_;
+  condition_variable done_;
+  size_t pending_ = 0;
+  exception_ptr error_;
+};
+
+struct Chunk {
+  Batch* batch;
+  size_t begin;
+  size_t end;
+};
+
+struct TaskQueue {
+  void push(const Chunk& chunk) {
+    scoped_lock guard(mx_);
+    chunks_.push_back(chunk);
+  }
+
+  optional<Chunk> pop() {
+    scoped_lock guard(mx_);
+    if (chunks_.empty()) {
+      return nullopt;
+    }
+    auto chunk = chunks_.front();
+    chunks_.pop_front();
+    return chunk;
+  }
+
+  optional<Chunk> steal() {
+    scoped_lock guard(mx_);
+    if (chunks_.empty()) {
+      return nullopt;
+    }
+    auto chunk = chunks_.back();
+    chunks_.pop_back();
+    return chunk;
+  }
+
+private:
+  mutex mx_;
+  deque<Chunk> chunks_;
+};
+
+struct WorkerPool::Pimpl {
+  explicit Pimpl(size_t worker_count) : queues_(max<size_t>(worker_count, 1)) {
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+      workers_.emplace_back(&Pimpl::work, this, i);
+    }
+  }
+
+  ~Pimpl() {
+    {
+      scoped_lock guard(idle_mx_);
+      stopping_ = true;
+    }
+    work_available_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  size_t size() const { return workers_.size(); }
+
+  void parallelFor(size_t count, const Task& task) {
+    if (count == 0) {
+      return;
+    }
+    if (workers_.empty() || count == 1) {
+      for (size_t i = 0; i < count; ++i) {
+        task(i);
+      }
+      return;
+    }
+
+    Batch batch(task);
+    // a few chunks per thread, so idle threads have something to steal
+    auto threads = workers_.size() + 1;
+    auto chunk_size = max<size_t>(count / (threads * 4), 1);
+    auto chunks = (count + chunk_size - 1) / chunk_size;
+    batch.expect(chunks);
+    {
+      scoped_lock guard(idle_mx_);
+      queued_ += chunks;
+    }
+    for (size_t i = 0; i < chunks; ++i) {
+      auto begin = i * chunk_size;
+      queues_[next_queue_++ % queues_.size()].push(
+          Chunk{&batch, begin, min(begin + chunk_size, count)});
+    }
+    work_available_.notify_all();
+
+    // the calling thread helps out until all of the chunks are done
+    while (!batch.finished()) {
+      if (auto chunk = take(next_queue_ % queues_.size())) {
+        chunk->batch->run(chunk->begin, chunk->end);
+      } else {
+        batch.waitFor(100us);
+      }
+    }
+    batch.rethrow();
+  }
+
+private:
+  optional<Chunk> take(size_t own_queue) {
+    auto chunk = queues_[own_queue].pop();
+    for (size_t i = 1; !chunk && i < queues_.size(); ++i) {
+      chunk = queues_[(own_queue + i) % queues_.size()].steal();
+    }
+    if (chunk) {
+      scoped_lock guard(idle_mx_);
+      --queued_;
+    }
+    return chunk;
+  }
+
+  void work(size_t own_queue) {
+    while (true) {
+      if (auto chunk = take(own_queue)) {
+        chunk->batch->run(chunk->begin, chunk->end);
+      } else {
+        unique_lock guard(idle_mx_);
+        work_available_.wait(
+            guard, [this]() { return stopping_ || queued_ > 0; });
+        if (stopping_) {
+          return;
+        }
+      }
+    }
+  }
+
+  vector<TaskQueue> queues_;
+  atomic<size_t> next_queue_{0};
+  mutex idle_mx_;
+  condition_variable work_available_;
+  size_t queued_ = 0;
+  bool stopping_ = false;
+  vector<thread> workers_;
+};
+
+WorkerPool::WorkerPool()
+    : WorkerPool(max<size_t>(thread::hardware_concurrency(), 1) - 1) {}
+
+WorkerPool::WorkerPool(size_t worker_count)
+    : pimpl_(make_unique<Pimpl>(worker_count)) {}
+
+WorkerPool::~WorkerPool() = default;
+
+size_t WorkerPool::size() const { return pimpl_->size(); }
+
+void WorkerPool::parallelFor(size_t count, const Task& task) {
+  pimpl_->parallelFor(count, task);
+}
+} // namespace Information_Model::testing
@@ -0,0 +1,72 @@
+#include "WritableFake.hpp"
+
+namespace Information_Model::testing {
+using namespace std;
+
+WritableFake::WritableFake(DataType type) : readable_(type) {}
+
+WritableFake::WritableFake(DataType type, const ReadCallback& read_cb)
+    : readable_(type, read_cb), write_only_(!read_cb) {}
+
+WritableFake::WritableFake(const DataVariant& value) : readable_(value) {}
+
+WritableFake::WritableFake(DataType type, const WriteCallback& write_cb)
+    : readable_(type), write_only_(true) {
+  updateWriteCallback(write_cb);
+}
+
+WritableFake::WritableFake(
+    DataType type, const ReadCallback& read_cb, const WriteCallback& write_cb)
+    : WritableFake(type, read_cb) {
+  updateWriteCallback(write_cb);
+}
+
+void WritableFake::setWriteOnly(bool write_only) { write_only_ = write_only; }
+
+void WritableFake::updateType(DataType type) { readable_.updateType(type); }
+
+void WritableFake::updateValue(const DataVariant& value) {
+  readable_.updateValue(value);
+}
+
+void WritableFake::updateReadCallback(const ReadCallback& read_cb) {
+  if (read_cb) {
+    readable_.updateReadCallback(read_cb);
+    write_only_ = false;
+  } else {
+    write_only_ = true;
+  }
+}
+
+void WritableFake::updateWriteCallback(const WriteCallback& write_cb) {
+  atomic_store(&write_, make_shared<const WriteCallback>(write_cb));
+}
+
+void WritableFake::updateCallbacks(
+    const ReadCallback& read_cb, const WriteCallback& write_cb) {
+  updateReadCallback(read_cb);
+  updateWriteCallback(write_cb);
+}
+
+DataType WritableFake::dataType() const { return readable_.dataType(); }
+
+DataVariant WritableFake::read() const {
+  if (write_only_) {
+    throw NonReadable();
+  }
+  return readable_.read();
+}
+
+bool WritableFake::isWriteOnly() const { return write_only_; }
+
+void WritableFake::write(const DataVariant& value) const {
+  auto write = atomic_load(&write_);
+  if (!write) {
+    return;
+  }
+  if (!*write) {
+    throw WriteCallbackUnavailable();
+  }
+  (*write)(value);
+}
+} // namespace Information_Model::testing
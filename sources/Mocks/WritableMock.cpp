@@ -4,28 +4,29 @@ namespace Information_Model::testing {
 using namespace std;
 using namespace ::testing;
 
+WritableMock::WritableMock()
+    : readable_(make_shared<NiceMock<ReadableMock>>()) {
+  setDefaultCalls();
+}
+
 WritableMock::WritableMock(DataType type)
     : readable_(make_shared<NiceMock<ReadableMock>>(type)) {
-  setReadableCalls();
-  setWriteOnly(false);
+  setDefaultCalls();
 }
 
 WritableMock::WritableMock(DataType type, const ReadCallback& read_cb)
     : readable_(make_shared<NiceMock<ReadableMock>>(type, read_cb)) {
-  setReadableCalls();
+  setDefaultCalls();
   setWriteOnly(!read_cb);
 }
 
 WritableMock::WritableMock(const DataVariant& value)
     : readable_(make_shared<NiceMock<ReadableMock>>(value)) {
-  setReadableCalls();
-  setWriteOnly(false);
+  setDefaultCalls();
 }
 
 WritableMock::WritableMock(DataType type, const WriteCallback& write_cb)
     : WritableMock(type) {
-  setReadableCalls();
-  readable_->updateType(type);
   updateWriteCallback(write_cb);
   setWriteOnly(true);
 }
@@ -36,18 +37,34 @@ WritableMock::WritableMock(
   updateWriteCallback(write_cb);
 }
 
-void WritableMock::setReadableCalls() const {
-  ON_CALL(*this, read)
-      .WillByDefault(Invoke(readable_.get(), &ReadableMock::read));
-  ON_CALL(*this, dataType)
-      .WillByDefault(Invoke(readable_.get(), &ReadableMock::dataType));
+void WritableMock::setDefaultCalls() {
+  ON_CALL(*this, read).WillByDefault([this]() {
+    if (write_only_) {
+      throw NonReadable();
+    }
+    return readable_->read();
+  });
+  ON_CALL(*this, dataType).WillByDefault([this]() {
+    return readable_->dataType();
+  });
+  ON_CALL(*this, isWriteOnly).WillByDefault(
+      [this]() { return write_only_.load(); });
+  ON_CALL(*this, write).WillByDefault(
+      [this](const DataVariant& value) { writeValue(value); });
 }
 
-void WritableMock::setWriteOnly(bool write_only) const {
-  if (write_only) {
-    ON_CALL(*this, read).WillByDefault(Throw(NonReadable()));
+void WritableMock::writeValue(const DataVariant& value) const {
+  if (!write_set_) {
+    return;
   }
-  ON_CALL(*this, isWriteOnly).WillByDefault(Return(write_only));
+  if (!write_) {
+    throw WriteCallbackUnavailable();
+  }
+  write_(value);
+}
+
+void WritableMock::setWriteOnly(bool write_only) const {
+  write_only_ = write_only;
 }
 
 void WritableMock::updateType(DataType type) { readable_->updateType(type); }
@@ -59,19 +76,15 @@ void WritableMock::updateValue(const DataVariant& value) {
 void WritableMock::updateReadCallback(const ReadCallback& read_cb) {
   if (read_cb) {
     readable_->updateReadCallback(read_cb);
-    setReadableCalls();
+    setWriteOnly(false);
   } else {
     setWriteOnly(true);
   }
 }
 
 void WritableMock::updateWriteCallback(const WriteCallback& write_cb) {
-  // NOLINTNEXTLINE(bugprone-assignment-in-if-condition)
-  if ((write_ = write_cb)) { // we want to assign and check if it was unset
-    ON_CALL(*this, write).WillByDefault(write_);
-  } else {
-    ON_CALL(*this, write).WillByDefault(Throw(WriteCallbackUnavailable()));
-  }
+  write_ = write_cb;
+  write_set_ = true;
 }
 
 void WritableMock::updateCallbacks(
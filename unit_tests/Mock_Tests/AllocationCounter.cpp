@@ -0,0 +1,39 @@
+#include "AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<size_t> allocation_count{0};
+std::atomic<size_t> allocated_bytes{0};
+} // namespace
+
+// NOLINTBEGIN(cppcoreguidelines-no-malloc)
+void* operator new(size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (auto* memory = std::malloc(size == 0 ? 1 : size)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+// NOLINTEND(cppcoreguidelines-no-malloc)
+
+namespace Information_Model::testing {
+
+AllocationCounter::AllocationCounter()
+    : allocations_(allocation_count.load()), bytes_(allocated_bytes.load()) {}
+
+size_t AllocationCounter::allocations() const {
+  return allocation_count.load() - allocations_;
+}
+
+size_t AllocationCounter::bytes() const {
+  return allocated_bytes.load() - bytes_;
+}
+} // namespace Information_Model::testing
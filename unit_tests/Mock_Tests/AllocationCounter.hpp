@@ -0,0 +1,29 @@
+#ifndef __STAG_INFORMATION_MODEL_MOCKS_UNIT_TESTS_ALLOCATION_COUNTER_HPP
+#define __STAG_INFORMATION_MODEL_MOCKS_UNIT_TESTS_ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+
+namespace Information_Model::testing {
+
+/**
+ * @brief Counts the heap allocations made by the test runner, through a
+ * replaced global operator new
+ *
+ */
+struct AllocationCounter {
+  /**
+   * @brief Starts counting from the current allocation totals
+   *
+   */
+  AllocationCounter();
+
+  size_t allocations() const;
+
+  size_t bytes() const;
+
+private:
+  size_t allocations_;
+  size_t bytes_;
+};
+} // namespace Information_Model::testing
+#endif //__STAG_INFORMATION_MODEL_MOCKS_UNIT_TESTS_ALLOCATION_COUNTER_HPP
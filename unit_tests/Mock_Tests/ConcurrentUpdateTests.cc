@@ -0,0 +1,81 @@
+#include "ObservableFake.hpp"
+#include "WritableFake.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+constexpr size_t PAYLOAD_SIZE = 256;
+
+DataVariant makeUniformPayload(size_t fill) {
+  return vector<uint8_t>(PAYLOAD_SIZE, static_cast<uint8_t>(fill));
+}
+
+bool isUniformPayload(const DataVariant& value) {
+  const auto* bytes = get_if<vector<uint8_t>>(&value);
+  if (bytes == nullptr || bytes->size() != PAYLOAD_SIZE) {
+    return false;
+  }
+  for (auto byte : *bytes) {
+    if (byte != bytes->front()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <class ReadableType> struct ConcurrentUpdateTests : public Test {
+  ConcurrentUpdateTests()
+      : tested(make_shared<ReadableType>(makeUniformPayload(0))) {}
+
+  shared_ptr<ReadableType> tested;
+};
+
+using ConcurrentlyUpdated = Types<NiceMock<ReadableMock>,
+    NiceMock<WritableMock>,
+    NiceMock<ObservableMock>,
+    ReadableFake,
+    WritableFake,
+    ObservableFake>;
+TYPED_TEST_SUITE(ConcurrentUpdateTests, ConcurrentlyUpdated);
+
+TYPED_TEST(ConcurrentUpdateTests, readsWhileUpdating) {
+  constexpr size_t READER_COUNT = 4;
+  constexpr size_t UPDATE_COUNT = 100000;
+  auto tested = this->tested;
+  atomic<bool> updating = true;
+  atomic<size_t> torn_reads = 0;
+  atomic<size_t> reads = 0;
+
+  vector<thread> readers;
+  for (size_t i = 0; i < READER_COUNT; ++i) {
+    readers.emplace_back([&tested, &updating, &torn_reads, &reads]() {
+      while (updating) {
+        if (!isUniformPayload(tested->read()) ||
+            tested->dataType() != DataType::Opaque) {
+          ++torn_reads;
+        }
+        ++reads;
+      }
+    });
+  }
+  for (size_t fill = 1; fill <= UPDATE_COUNT; ++fill) {
+    tested->updateValue(makeUniformPayload(fill));
+  }
+  updating = false;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  EXPECT_EQ(torn_reads, 0);
+  EXPECT_GT(reads, 0);
+  EXPECT_EQ(tested->read(), makeUniformPayload(UPDATE_COUNT));
+}
+} // namespace Information_Model::testing
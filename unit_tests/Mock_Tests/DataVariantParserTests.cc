@@ -0,0 +1,40 @@
+#include "DataVariantParser.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+TEST(DataVariantParserTests, parsesEachDataType) {
+  EXPECT_EQ(parseDataVariant("true", DataType::Boolean), DataVariant(true));
+  EXPECT_EQ(parseDataVariant("0", DataType::Boolean), DataVariant(false));
+  EXPECT_EQ(
+      parseDataVariant("-42", DataType::Integer), DataVariant(intmax_t{-42}));
+  EXPECT_EQ(parseDataVariant("42", DataType::Unsigned_Integer),
+      DataVariant(uintmax_t{42}));
+  EXPECT_EQ(parseDataVariant("-2.5e1", DataType::Double), DataVariant(-25.0));
+  EXPECT_EQ(parseDataVariant("2025-09-23T12:30:45.000123", DataType::Timestamp),
+      DataVariant(Timestamp{2025, 9, 23, 12, 30, 45, 123}));
+  EXPECT_EQ(parseDataVariant("00ff1A", DataType::Opaque),
+      DataVariant(vector<uint8_t>{0x00, 0xFF, 0x1A}));
+  EXPECT_EQ(
+      parseDataVariant("text", DataType::String), DataVariant(string("text")));
+}
+
+TEST(DataVariantParserTests, throwsOnInvalidText) {
+  EXPECT_THAT([]() { parseDataVariant("yes", DataType::Boolean); },
+      ThrowsMessage<invalid_argument>(HasSubstr("Invalid boolean yes")));
+  EXPECT_THAT([]() { parseDataVariant("1.5", DataType::Integer); },
+      ThrowsMessage<invalid_argument>(HasSubstr("Invalid number 1.5")));
+  EXPECT_THAT([]() { parseDataVariant("-1", DataType::Unsigned_Integer); },
+      ThrowsMessage<invalid_argument>(HasSubstr("Invalid number -1")));
+  EXPECT_THAT([]() { parseDataVariant("abc", DataType::Opaque); },
+      ThrowsMessage<invalid_argument>(HasSubstr("Odd number of hex digits")));
+  EXPECT_THAT([]() { parseDataVariant("2025", DataType::Timestamp); },
+      ThrowsMessage<invalid_argument>(HasSubstr("Invalid timestamp 2025")));
+  EXPECT_THAT([]() { parseDataVariant("", DataType::None); },
+      ThrowsMessage<invalid_argument>(HasSubstr("Can not parse None values")));
+}
+} // namespace Information_Model::testing
@@ -0,0 +1,152 @@
+#include "MockBuilder.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+DevicePrototypePtr recordPrototype(MockBuilder& builder,
+    const ReadableMock::ReadCallback& read_cb = nullptr) {
+  builder.enablePrototypeRecording();
+  builder.setDeviceInfo("base_id", BuildInfo{"device_name", "device_desc"});
+  builder.addWritable(BuildInfo{"writable"}, DataVariant(true));
+  auto group_id = builder.addGroup(BuildInfo{"group_name"});
+  if (read_cb) {
+    builder.addReadable(group_id, BuildInfo{"readable"}, DataType::Integer,
+        read_cb);
+  } else {
+    builder.addReadable(group_id, BuildInfo{"readable"}, DataVariant(42));
+  }
+  auto subgroup_id = builder.addGroup(group_id, BuildInfo{"subgroup_name"});
+  builder.addElements(subgroup_id,
+      vector<MockBuilder::ElementDescriptor>(3,
+          {ElementType::Observable, BuildInfo{"observable"}, DataType::Double}));
+  builder.addCallable(BuildInfo{"callable"}, DataType::String);
+  return builder.resultPrototype();
+}
+
+TEST(DevicePrototypeTests, canCloneDevice) {
+  MockBuilder builder;
+  auto prototype = recordPrototype(builder);
+
+  EXPECT_EQ(prototype->id(), "base_id");
+  EXPECT_EQ(prototype->size(), 8);
+
+  auto device = prototype->clone("clone_id");
+
+  EXPECT_EQ(device->id(), "clone_id");
+  EXPECT_EQ(device->name(), "device_name");
+  EXPECT_EQ(device->description(), "device_desc");
+  EXPECT_EQ(device->size(), 3);
+  auto writable = device->element("clone_id:0");
+  EXPECT_EQ(writable->name(), "writable");
+  EXPECT_EQ(get<WritablePtr>(writable->function())->read(), DataVariant(true));
+  auto group = device->element("clone_id:1");
+  EXPECT_EQ(group->name(), "group_name");
+  EXPECT_EQ(get<GroupPtr>(group->function())->size(), 2);
+  auto readable = device->element("clone_id:1.0");
+  EXPECT_EQ(get<ReadablePtr>(readable->function())->read(), DataVariant(42));
+  auto observable = device->element("clone_id:1.1.2");
+  EXPECT_EQ(observable->id(), "clone_id:1.1.2");
+  EXPECT_EQ(observable->name(), "observable");
+  EXPECT_EQ(get<ObservablePtr>(observable->function())->dataType(),
+      DataType::Double);
+  auto callable = get<CallablePtr>(device->element("clone_id:2")->function());
+  EXPECT_EQ(callable->resultType(), DataType::String);
+}
+
+TEST(DevicePrototypeTests, clonesAreIndependent) {
+  MockBuilder builder;
+  auto prototype = recordPrototype(builder);
+
+  auto first = prototype->clone("first_id");
+  auto second = prototype->clone("second_id");
+  auto first_writable = first->element("first_id:0");
+  auto second_writable = second->element("second_id:0");
+
+  EXPECT_NE(first_writable, second_writable);
+  EXPECT_NE(get<WritablePtr>(first_writable->function()),
+      get<WritablePtr>(second_writable->function()));
+  EXPECT_EQ(first_writable->id(), "first_id:0");
+  EXPECT_EQ(second_writable->id(), "second_id:0");
+  EXPECT_NE(first->group(), second->group());
+}
+
+TEST(DevicePrototypeTests, sharesCallbacksWithClones) {
+  size_t reads = 0;
+  MockBuilder builder;
+  auto prototype = recordPrototype(builder, [&reads]() {
+    ++reads;
+    return DataVariant((intmax_t)7);
+  });
+
+  auto first = prototype->clone("first_id");
+  auto second = prototype->clone("second_id");
+
+  EXPECT_EQ(get<ReadablePtr>(first->element("first_id:1.0")->function())->read(),
+      DataVariant((intmax_t)7));
+  EXPECT_EQ(
+      get<ReadablePtr>(second->element("second_id:1.0")->function())->read(),
+      DataVariant((intmax_t)7));
+  EXPECT_EQ(reads, 2);
+}
+
+TEST(DevicePrototypeTests, canCloneLazyPrototypeWithinArena) {
+  MockBuilder builder;
+  builder.enableArena();
+  builder.enableLazyElements();
+  auto prototype = recordPrototype(builder);
+
+  auto device = prototype->clone("clone_id");
+  size_t visited = 0;
+  device->visit([&visited](const ElementPtr&) { ++visited; });
+
+  EXPECT_EQ(visited, 3);
+  EXPECT_EQ(device->element("clone_id:1.1.0")->name(), "observable");
+}
+
+TEST(DevicePrototypeTests, builderKeepsBuildingAfterPrototype) {
+  MockBuilder builder;
+  recordPrototype(builder);
+  builder.setDeviceInfo("other_id", BuildInfo{"other_name"});
+  builder.addReadable(BuildInfo{"readable"}, DataType::Boolean);
+  auto other = builder.resultPrototype();
+
+  EXPECT_EQ(other->id(), "other_id");
+  EXPECT_EQ(other->size(), 1);
+}
+
+TEST(DevicePrototypeTests, resultPrototypeThrowsLogicError) {
+  MockBuilder builder;
+  builder.setDeviceInfo("base_id", BuildInfo{"device_name"});
+  builder.addReadable(BuildInfo{"readable"}, DataType::Boolean);
+
+  EXPECT_THROW(builder.resultPrototype(), logic_error);
+}
+
+TEST(DevicePrototypeTests, resultPrototypeThrowsGroupEmpty) {
+  MockBuilder builder;
+  builder.enablePrototypeRecording();
+  builder.setDeviceInfo("base_id", BuildInfo{"device_name"});
+  builder.addGroup(BuildInfo{"group_name"});
+
+  EXPECT_THROW(builder.resultPrototype(), GroupEmpty);
+}
+
+TEST(DevicePrototypeTests, resultPrototypeThrowsDeviceInfoNotSet) {
+  MockBuilder builder;
+  builder.enablePrototypeRecording();
+
+  EXPECT_THROW(builder.resultPrototype(), DeviceInfoNotSet);
+}
+
+TEST(DevicePrototypeTests,
+    enablePrototypeRecordingThrowsDeviceBuildInProgress) {
+  MockBuilder builder;
+  builder.setDeviceInfo("base_id", BuildInfo{"device_name"});
+
+  EXPECT_THROW(builder.enablePrototypeRecording(), DeviceBuildInProgress);
+}
+} // namespace Information_Model::testing
@@ -0,0 +1,103 @@
+#include "DeviceSchema.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+constexpr auto SENSOR = schema::device("device_name",
+    "device_desc",
+    schema::writable<DataType::Boolean>("writable", "", true),
+    schema::group("group_name",
+        "group_desc",
+        schema::readable<DataType::Integer>("readable", "readable_desc", 42),
+        schema::group("subgroup_name",
+            "",
+            schema::observable<DataType::Double>("observable"),
+            schema::observable<DataType::String>("labeled", "", "label"))),
+    schema::callable<DataType::String>("callable"));
+
+using SensorSchema = decay_t<decltype(SENSOR)>;
+
+static_assert(SensorSchema::size == 7);
+static_assert(SensorSchema::position<0>() == 0);
+static_assert(SensorSchema::position<1, 0>() == 2);
+static_assert(SensorSchema::position<1, 1, 1>() == 5);
+static_assert(SensorSchema::position<2>() == 6);
+static_assert(SensorSchema::localId<1, 1, 0>() == "1.1.0");
+static_assert(SensorSchema::localId<10, 205>() == "10.205");
+static_assert(is_same_v<SensorSchema::SpecAt<1, 1>::Mock, GroupMock>);
+static_assert(SensorSchema::SpecAt<1, 1, 0>::data_type == DataType::Double);
+static_assert(*get<0>(SENSOR.children).default_value);
+
+static_assert(schema::isValueOf<DataType::Integer, int>());
+static_assert(schema::isValueOf<DataType::Unsigned_Integer, unsigned>());
+static_assert(schema::isValueOf<DataType::String, const char*>());
+static_assert(!schema::isValueOf<DataType::String, double>());
+static_assert(!schema::isValueOf<DataType::Boolean, int>());
+static_assert(!schema::isValueOf<DataType::Double, int>());
+static_assert(!schema::isValueOf<DataType::Timestamp, double>());
+
+TEST(DeviceSchemaTests, canBuildDevice) {
+  auto built = SENSOR.build("base_id");
+  const auto& device = built.device();
+
+  EXPECT_EQ(device->id(), "base_id");
+  EXPECT_EQ(device->name(), "device_name");
+  EXPECT_EQ(device->description(), "device_desc");
+  EXPECT_EQ(device->size(), 3);
+  auto writable = device->element("base_id:0");
+  EXPECT_EQ(writable->name(), "writable");
+  EXPECT_EQ(get<WritablePtr>(writable->function())->read(), DataVariant(true));
+  auto group = device->element("base_id:1");
+  EXPECT_EQ(group->name(), "group_name");
+  EXPECT_EQ(group->description(), "group_desc");
+  EXPECT_EQ(get<GroupPtr>(group->function())->size(), 2);
+  auto readable = device->element("base_id:1.0");
+  EXPECT_EQ(readable->description(), "readable_desc");
+  EXPECT_EQ(get<ReadablePtr>(readable->function())->read(), DataVariant(42));
+  auto observable = device->element("base_id:1.1.0");
+  EXPECT_EQ(get<ObservablePtr>(observable->function())->dataType(),
+      DataType::Double);
+  auto labeled = device->element("base_id:1.1.1");
+  EXPECT_EQ(get<ObservablePtr>(labeled->function())->read(),
+      DataVariant(string("label")));
+  auto callable = get<CallablePtr>(device->element("base_id:2")->function());
+  EXPECT_EQ(callable->resultType(), DataType::String);
+}
+
+TEST(DeviceSchemaTests, returnsElementsByPath) {
+  auto built = SENSOR.build("base_id");
+
+  // template argument lists contain commas, so they are kept out of macros
+  auto nested_id = built.id<1, 1, 0>();
+  EXPECT_EQ(nested_id, "base_id:1.1.0");
+  auto nested = built.element<1, 1, 0>();
+  EXPECT_EQ(nested, built.device()->element("base_id:1.1.0"));
+  EXPECT_EQ(built.element<2>()->id(), "base_id:2");
+
+  const WritableMockPtr& writable = built.function<0>();
+  EXPECT_EQ(get<WritablePtr>(built.element<0>()->function()), writable);
+  const GroupMockPtr& subgroup = built.function<1, 1>();
+  EXPECT_EQ(subgroup->size(), 2);
+  const ObservableMockPtr& observable = built.function<1, 1, 0>();
+  EXPECT_EQ(observable->dataType(), DataType::Double);
+}
+
+TEST(DeviceSchemaTests, builtDevicesAreIndependent) {
+  auto first = SENSOR.build("first_id");
+  auto second = SENSOR.build("second_id");
+
+  EXPECT_NE(first.function<0>(), second.function<0>());
+  EXPECT_EQ(first.element<0>()->id(), "first_id:0");
+  EXPECT_EQ(second.element<0>()->id(), "second_id:0");
+}
+
+TEST(DeviceSchemaTests, throwsOnNegativeUnsignedValue) {
+  EXPECT_THROW(
+      schema::readable<DataType::Unsigned_Integer>("readable", "", -1),
+      invalid_argument);
+}
+} // namespace Information_Model::testing
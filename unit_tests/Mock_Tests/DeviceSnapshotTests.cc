@@ -0,0 +1,205 @@
+#include "DeviceSnapshot.hpp"
+#include "ElementMock.hpp"
+#include "MockBuilder.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+struct DeviceSnapshotTests : public Test {
+  ~DeviceSnapshotTests() override { filesystem::remove(snapshot_path); }
+
+  DevicePtr buildDevice() {
+    MockBuilder builder;
+    builder.setDeviceInfo("base_id", BuildInfo{"device_name", "device_desc"});
+    builder.addWritable(BuildInfo{"writable", "writable_desc"},
+        DataVariant(string("text")));
+    auto group_id = builder.addGroup(BuildInfo{"group_name", "group_desc"});
+    builder.addReadable(group_id, BuildInfo{"readable"}, DataVariant(-42));
+    auto subgroup_id = builder.addGroup(group_id, BuildInfo{"subgroup_name"});
+    builder.addElements(subgroup_id,
+        vector<MockBuilder::ElementDescriptor>(3,
+            {ElementType::Observable, BuildInfo{"observable"},
+                DataType::Double, DataVariant(2.5)}));
+    builder.addReadable(
+        group_id, BuildInfo{"opaque"}, DataVariant(vector<uint8_t>{1, 2, 3}));
+    builder.addCallable(BuildInfo{"callable"},
+        DataType::Timestamp,
+        ParameterTypes{{0, {DataType::Integer, true}},
+            {3, {DataType::String, false}}});
+    return builder.result();
+  }
+
+  void writeFile(const string& content) {
+    ofstream snapshot(snapshot_path, ios::binary | ios::trunc);
+    snapshot << content;
+  }
+
+  string snapshot_path =
+      (filesystem::temp_directory_path() /
+          ("snapshot_" + to_string(reinterpret_cast<uintptr_t>(this)) +
+              ".snapshot"))
+          .string();
+};
+
+TEST_F(DeviceSnapshotTests, canLoadWrittenDevice) {
+  DeviceSnapshot::write(*buildDevice(), snapshot_path);
+  DeviceSnapshot snapshot(snapshot_path);
+
+  EXPECT_EQ(snapshot.id(), "base_id");
+  EXPECT_EQ(snapshot.size(), 9);
+
+  auto device = snapshot.load();
+
+  EXPECT_EQ(device->id(), "base_id");
+  EXPECT_EQ(device->name(), "device_name");
+  EXPECT_EQ(device->description(), "device_desc");
+  EXPECT_EQ(device->size(), 3);
+  auto writable = device->element("base_id:0");
+  EXPECT_EQ(writable->type(), ElementType::Writable);
+  EXPECT_EQ(writable->name(), "writable");
+  EXPECT_EQ(writable->description(), "writable_desc");
+  EXPECT_EQ(get<WritablePtr>(writable->function())->read(),
+      DataVariant(string("text")));
+  auto group = device->element("base_id:1");
+  EXPECT_EQ(group->description(), "group_desc");
+  EXPECT_EQ(get<GroupPtr>(group->function())->size(), 3);
+  EXPECT_EQ(get<ReadablePtr>(device->element("base_id:1.0")->function())
+                ->read(),
+      DataVariant(-42));
+  auto observable =
+      get<ObservablePtr>(device->element("base_id:1.1.2")->function());
+  EXPECT_EQ(observable->dataType(), DataType::Double);
+  EXPECT_EQ(observable->read(), DataVariant(2.5));
+  EXPECT_EQ(get<ReadablePtr>(device->element("base_id:1.2")->function())
+                ->read(),
+      DataVariant(vector<uint8_t>{1, 2, 3}));
+  auto callable = get<CallablePtr>(device->element("base_id:2")->function());
+  EXPECT_EQ(callable->resultType(), DataType::Timestamp);
+  EXPECT_THAT(callable->parameterTypes(),
+      ElementsAre(Pair(0, Pair(DataType::Integer, true)),
+          Pair(3, Pair(DataType::String, false))));
+}
+
+TEST_F(DeviceSnapshotTests, canLoadWithDifferentBaseId) {
+  DeviceSnapshot::write(*buildDevice(), snapshot_path);
+  DeviceSnapshot snapshot(snapshot_path);
+
+  auto first = snapshot.load("first_id");
+  auto second = snapshot.load("second_id");
+
+  EXPECT_EQ(first->id(), "first_id");
+  EXPECT_EQ(first->element("first_id:1.1.0")->id(), "first_id:1.1.0");
+  EXPECT_EQ(second->element("second_id:1.1.0")->name(), "observable");
+  EXPECT_NE(first->element("first_id:0"), second->element("second_id:0"));
+}
+
+TEST_F(DeviceSnapshotTests, loadedDevicesOutliveSnapshot) {
+  DeviceSnapshot::write(*buildDevice(), snapshot_path);
+  unique_ptr<Device> device;
+  {
+    DeviceSnapshot snapshot(snapshot_path);
+    device = snapshot.load();
+  }
+
+  EXPECT_EQ(device->element("base_id:1.1.1")->name(), "observable");
+}
+
+TEST_F(DeviceSnapshotTests, canLoadWriteOnlyWritable) {
+  DeviceMock device("base_id");
+  auto id = device.generateID();
+  device.addElement(make_shared<NiceMock<ElementMock>>(
+      make_shared<NiceMock<WritableMock>>(DataType::Integer,
+          WritableMock::WriteCallback([](const DataVariant&) {})),
+      id));
+  DeviceSnapshot::write(device, snapshot_path);
+
+  auto loaded = DeviceSnapshot(snapshot_path).load();
+  auto writable = get<WritablePtr>(loaded->element(id)->function());
+
+  EXPECT_TRUE(writable->isWriteOnly());
+  EXPECT_EQ(writable->dataType(), DataType::Integer);
+  EXPECT_THROW(writable->read(), NonReadable);
+}
+
+TEST_F(DeviceSnapshotTests, writeThrowsInvalidArgument) {
+  DeviceMock device("base_id");
+  device.addElement(make_shared<NiceMock<ElementMock>>(
+      make_shared<NiceMock<ReadableMock>>(DataType::Boolean), "base_id:1"));
+
+  EXPECT_THAT([&]() { DeviceSnapshot::write(device, snapshot_path); },
+      ThrowsMessage<invalid_argument>(HasSubstr("not at its ID position")));
+  EXPECT_THAT(
+      [&]() { DeviceSnapshot::write(*buildDevice(), "/missing/dir/file"); },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("Could not create snapshot file")));
+}
+
+TEST_F(DeviceSnapshotTests, throwsInvalidArgumentForMissingFile) {
+  EXPECT_THAT([]() { DeviceSnapshot("/missing/file.snapshot"); },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("Could not open snapshot file")));
+}
+
+TEST_F(DeviceSnapshotTests, throwsMalformedSnapshot) {
+  writeFile("STAGTRC1");
+  EXPECT_THAT([this]() { DeviceSnapshot tested(snapshot_path); },
+      ThrowsMessage<MalformedSnapshot>(HasSubstr("Missing snapshot magic")));
+
+  DeviceSnapshot::write(*buildDevice(), snapshot_path);
+  string content;
+  {
+    ifstream snapshot(snapshot_path, ios::binary);
+    content.assign(istreambuf_iterator<char>(snapshot), {});
+  }
+  writeFile(content.substr(0, content.size() - 4));
+  EXPECT_THAT([this]() { DeviceSnapshot tested(snapshot_path); },
+      ThrowsMessage<MalformedSnapshot>(
+          HasSubstr("Unexpected end of snapshot")));
+
+  writeFile(content + "x");
+  EXPECT_THAT([this]() { DeviceSnapshot tested(snapshot_path); },
+      ThrowsMessage<MalformedSnapshot>(
+          HasSubstr("Unexpected data after the root group")));
+}
+
+string snapshotHeader() {
+  // magic, empty id, name and description and the element count
+  return string("STAGSNP1") + string(16, '\0');
+}
+
+string snapshotNumber(uint32_t value) {
+  return string(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+TEST_F(DeviceSnapshotTests, throwsMalformedSnapshotForOversizedGroup) {
+  writeFile(snapshotHeader() + snapshotNumber(numeric_limits<uint32_t>::max()));
+
+  EXPECT_THAT([this]() { DeviceSnapshot tested(snapshot_path); },
+      ThrowsMessage<MalformedSnapshot>(
+          HasSubstr("Group declares 4294967295 elements")));
+}
+
+TEST_F(DeviceSnapshotTests, throwsMalformedSnapshotForDeepNesting) {
+  constexpr size_t DEPTH = 100000;
+  // each level is a group with a single nested group, without name and
+  // description
+  string nested_group = snapshotNumber(1) + string(1, '\0') + string(8, '\0');
+  string content = snapshotHeader();
+  content.reserve(content.size() + DEPTH * nested_group.size());
+  for (size_t level = 0; level < DEPTH; ++level) {
+    content += nested_group;
+  }
+  writeFile(content);
+
+  EXPECT_THAT([this]() { DeviceSnapshot tested(snapshot_path); },
+      ThrowsMessage<MalformedSnapshot>(HasSubstr("Groups are nested deeper")));
+}
+} // namespace Information_Model::testing
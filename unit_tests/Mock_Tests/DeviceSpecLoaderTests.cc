@@ -0,0 +1,188 @@
+#include "DeviceSpecLoader.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+unique_ptr<Device> loadSpec(const string& spec) {
+  istringstream stream(spec);
+  return DeviceSpecLoader().load(stream, "test_spec");
+}
+
+TEST(DeviceSpecLoaderTests, canLoadSpec) {
+  istringstream spec(R"({
+    "id": "gateway",
+    "name": "Gateway",
+    "description": "Field \"bus\" gateway \u00b5",
+    "latency_profiles": {"fieldbus": 0.5},
+    "unknown": [1, {"nested": null}],
+    "elements": [
+      {"type": "Readable", "name": "Temperature", "data_type": "Double",
+       "value": 21.5, "latency": "fieldbus"},
+      {"type": "Group", "name": "Points", "description": "Data points",
+       "elements": [
+        {"type": "Observable", "data_type": "Integer", "count": 3},
+        {"type": "Group", "name": "Nested", "elements": [
+          {"type": "Writable", "data_type": "String", "value": "on"}
+        ]},
+        {"type": "Callable", "data_type": "None"}
+      ]},
+      {"value": "00ff", "data_type": "Opaque", "type": "Readable"}
+    ]
+  })");
+  DeviceSpecLoader tested;
+
+  auto device = tested.load(spec);
+
+  EXPECT_EQ(device->id(), "gateway");
+  EXPECT_EQ(device->name(), "Gateway");
+  EXPECT_EQ(device->description(), "Field \"bus\" gateway \xC2\xB5");
+  EXPECT_EQ(device->group()->size(), 3);
+  auto temperature = device->element("gateway:0");
+  EXPECT_EQ(temperature->name(), "Temperature");
+  EXPECT_EQ(get<ReadablePtr>(temperature->function())->read(), DataVariant(21.5));
+  auto points = get<GroupPtr>(device->element("gateway:1")->function());
+  EXPECT_EQ(points->size(), 5);
+  EXPECT_EQ(device->element("gateway:1")->description(), "Data points");
+  EXPECT_EQ(device->element("gateway:1.2")->type(), ElementType::Observable);
+  auto writable =
+      get<WritablePtr>(device->element("gateway:1.3.0")->function());
+  EXPECT_EQ(writable->read(), DataVariant(string("on")));
+  EXPECT_EQ(device->element("gateway:1.4")->type(), ElementType::Callable);
+  auto opaque = get<ReadablePtr>(device->element("gateway:2")->function());
+  EXPECT_EQ(opaque->read(), DataVariant(vector<uint8_t>{0x00, 0xFF}));
+  EXPECT_EQ(tested.report().elements, 9);
+}
+
+TEST(DeviceSpecLoaderTests, appliesLatency) {
+  auto device = loadSpec(R"({"id": "device", "elements": [
+    {"type": "Readable", "data_type": "Integer", "latency_us": 2000}
+  ]})");
+  auto readable = get<ReadablePtr>(device->element("device:0")->function());
+
+  auto start = chrono::steady_clock::now();
+  EXPECT_EQ(readable->read(), DataVariant(intmax_t{0}));
+  EXPECT_GE(chrono::steady_clock::now() - start, chrono::milliseconds(2));
+}
+
+TEST(DeviceSpecLoaderTests, canLoadSpecFile) {
+  auto spec_path = (filesystem::temp_directory_path() /
+      ("spec_" + to_string(getpid()) + ".json"))
+                       .string();
+  {
+    ofstream spec(spec_path, ios::trunc);
+    spec << R"({"id": "device", "elements": [{"type": "Readable"}]})";
+  }
+  auto builder = make_shared<MockBuilder>();
+  builder->enableLazyElements();
+  DeviceSpecLoader tested(builder);
+
+  auto device = tested.loadFile(spec_path);
+  filesystem::remove(spec_path);
+
+  EXPECT_EQ(device->element("device:0")->type(), ElementType::Readable);
+  EXPECT_EQ(tested.report().elements, 1);
+  EXPECT_GT(tested.report().build_duration.count(), 0);
+  EXPECT_THAT([&]() { tested.loadFile(spec_path); },
+      ThrowsMessage<invalid_argument>(HasSubstr("Could not open spec file")));
+}
+
+TEST(DeviceSpecLoaderTests, throwsMalformedSpec) {
+  vector<pair<string, string>> malformed = {
+      {R"({"id": "device", "elements": [)", "at byte 30: Unexpected end"},
+      {R"({"id": "device" "elements": []})", "Expected ,"},
+      {R"({"name": "device", "elements": []})", "Device id is missing"},
+      {R"({"id": 1})", "Expected a string"},
+      {R"({"id": "device", "elements": [{}]})", "Element type is missing"},
+      {R"({"id": "device", "elements": [{"type": "Folder"}]})",
+          "Unknown element type Folder"},
+      {R"({"id": "device", "elements": [{"type": "Readable",
+          "data_type": "Float"}]})",
+          "Unknown data type Float"},
+      {R"({"id": "device", "elements": [{"type": "Readable",
+          "data_type": "Integer", "value": "warm"}]})",
+          "Invalid number warm"},
+      {R"({"id": "device", "elements": [{"type": "Readable",
+          "latency": "slow"}]})",
+          "Unknown latency profile slow"},
+      {R"({"id": "device", "elements": [{"type": "Readable",
+          "count": -1}]})",
+          "Invalid number -1"},
+      {R"({"id": "device", "elements": [{"type": "Readable",
+          "elements": []}]})",
+          "Only groups can have nested elements"},
+      {R"({"id": "device", "elements": [{"type": "Group",
+          "elements": [{"type": "Readable"}], "name": "late"}]})",
+          "Elements must be the last member of a group"},
+      {R"({"id": "device", "elements": [{"type": "Readable"}],
+          "name": "late"})",
+          "Elements must be the last member of the device"},
+      {R"({"id": "device", "elements": [{"type": "Readable"}]} [])",
+          "Unexpected content after the device"},
+      {R"({"id": "device", "elements": [{"type": "Readable",
+          "name": "\x"}]})",
+          "Invalid escape sequence \\x"},
+      {R"({"id": "device", "elements": [{"type": "Readable",
+          "value": nope}]})",
+          "Invalid literal nope"}};
+
+  for (const auto& [spec, reason] : malformed) {
+    EXPECT_THAT([&]() { loadSpec(spec); },
+        ThrowsMessage<MalformedSpec>(AllOf(
+            HasSubstr("Malformed device spec test_spec"), HasSubstr(reason))))
+        << spec;
+  }
+}
+
+TEST(DeviceSpecLoaderTests, canLoadAfterFailedLoad) {
+  istringstream malformed(R"({"id": "device", "elements": [{}]})");
+  istringstream empty(R"({"id": "device", "elements": []})");
+  istringstream valid(R"({"id": "device", "elements": [{"type": "Readable"}]})");
+  DeviceSpecLoader tested;
+
+  EXPECT_THROW(tested.load(malformed), MalformedSpec);
+  EXPECT_THROW(tested.load(empty), GroupEmpty);
+  auto device = tested.load(valid);
+
+  EXPECT_EQ(device->element("device:0")->type(), ElementType::Readable);
+}
+
+TEST(DeviceSpecLoaderTests, loadsLargeCountsInBatches) {
+  constexpr size_t COUNT = 10000;
+  istringstream spec(R"({"id": "device", "elements": [
+    {"type": "Readable"},
+    {"type": "Readable", "data_type": "Integer", "count": )" +
+      to_string(COUNT) + "}]}");
+  auto builder = make_shared<MockBuilder>();
+  builder->enableLazyElements();
+  DeviceSpecLoader tested(builder);
+
+  auto device = tested.load(spec);
+
+  EXPECT_EQ(device->group()->size(), COUNT + 1);
+  EXPECT_EQ(device->element("device:" + to_string(COUNT))->type(),
+      ElementType::Readable);
+  EXPECT_EQ(tested.report().elements, COUNT + 1);
+}
+
+TEST(DeviceSpecLoaderTests, throwsOnRejectedElements) {
+  EXPECT_THAT(
+      []() {
+        loadSpec(R"({"id": "device", "elements": [
+          {"type": "Callable", "data_type": "Integer", "value": 1}]})");
+      },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("Callable elements do not support default values")));
+  EXPECT_THROW(loadSpec(R"({"id": "device", "elements": []})"), GroupEmpty);
+  EXPECT_THAT([]() { DeviceSpecLoader(nullptr); },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("MockBuilder can not be nullptr")));
+}
+} // namespace Information_Model::testing
@@ -23,8 +23,8 @@ struct DeviceTests : public testing::Test {
     tested->addElement(writable_element);
     built.try_emplace(writable_id, writable_element);
 
-    auto observable = make_shared<NiceMock<ObservableMock>>(DataType::String);
-    auto observable_id = tested->generateID();
+    observable = make_shared<NiceMock<ObservableMock>>(DataType::String);
+    observable_id = tested->generateID();
     auto observable_element =
         make_shared<NiceMock<ElementMock>>(observable, observable_id);
     tested->addElement(observable_element);
@@ -50,6 +50,12 @@ struct DeviceTests : public testing::Test {
     auto sub_readable_element =
         make_shared<NiceMock<ElementMock>>(sub_readable, sub_readable_id);
     sub_group->addElement(sub_readable_element);
+
+    sub_observable = make_shared<NiceMock<ObservableMock>>(DataType::Boolean);
+    sub_observable_id = sub_group->generateID();
+    auto sub_observable_element =
+        make_shared<NiceMock<ElementMock>>(sub_observable, sub_observable_id);
+    sub_group->addElement(sub_observable_element);
   }
 
   string base_id = "based_id";
@@ -57,6 +63,10 @@ struct DeviceTests : public testing::Test {
       base_id, FullMetaInfo{"test_device", "test device description"});
   string sub_group_id;
   string sub_readable_id;
+  string observable_id;
+  ObservableMockPtr observable;
+  string sub_observable_id;
+  ObservableMockPtr sub_observable;
   unordered_map<string, ElementMockPtr> built;
 };
 
@@ -167,4 +177,72 @@ TEST_F(DeviceTests, canVisitEach) {
   EXPECT_NO_THROW(tested->visit(visitor));
 }
 
-} // namespace Information_Model::testing
\ No newline at end of file
+TEST_F(DeviceTests, exportsNotificationLatencies) {
+  auto ignore_value = [](const shared_ptr<DataVariant>&) {};
+  auto ignore_exception = [](const exception_ptr&) {};
+  observable->enableSubscribeFaking([](bool) {});
+  sub_observable->enableSubscribeFaking([](bool) {});
+  tested->enableLatencyTracking(true);
+  auto observer = observable->subscribe(ignore_value, ignore_exception);
+  auto sub_observer = sub_observable->subscribe(ignore_value, ignore_exception);
+
+  observable->notify(DataVariant(string("notified")));
+  sub_observable->notify(DataVariant(true));
+  sub_observable->notify(DataVariant(false));
+
+  auto latencies = tested->notificationLatencies();
+  ASSERT_EQ(latencies.size(), 2);
+  ASSERT_EQ(latencies[observable_id].size(), 1);
+  EXPECT_EQ(latencies[observable_id][0].notify_to_dispatch.count(), 1);
+  ASSERT_EQ(latencies[sub_observable_id].size(), 1);
+  EXPECT_EQ(latencies[sub_observable_id][0].dispatch_to_return.count(), 2);
+}
+
+TEST_F(DeviceTests, canTick) {
+  vector<DataVariant> received;
+  auto record = [&received](const shared_ptr<DataVariant>& value) {
+    received.push_back(*value);
+  };
+  auto ignore_exception = [](const exception_ptr&) {};
+  observable->enableSubscribeFaking([](bool) {});
+  sub_observable->enableSubscribeFaking([](bool) {});
+  auto observer = observable->subscribe(record, ignore_exception);
+  auto sub_observer = sub_observable->subscribe(record, ignore_exception);
+
+  tested->tick({{observable_id, DataVariant(string("first"))},
+      {sub_observable_id, DataVariant(true)}});
+  tested->tick({{sub_observable_id, DataVariant(false)},
+      {observable_id, DataVariant(string("second"))}});
+  vector<pair<string, DataVariant>> copied{
+      {observable_id, DataVariant(string("third"))}};
+  tested->tick(copied);
+
+  EXPECT_THAT(received,
+      ElementsAre(DataVariant(string("first")),
+          DataVariant(true),
+          DataVariant(false),
+          DataVariant(string("second")),
+          DataVariant(string("third"))));
+  EXPECT_EQ(copied[0].second, DataVariant(string("third")));
+}
+
+TEST_F(DeviceTests, tickPublishesNothingOnInvalidId) {
+  MockFunction<void(const shared_ptr<DataVariant>&)> mock_observer_cb;
+  observable->enableSubscribeFaking([](bool) {});
+  auto observer = observable->subscribe(
+      mock_observer_cb.AsStdFunction(), [](const exception_ptr&) {});
+
+  EXPECT_CALL(mock_observer_cb, Call(_)).Times(Exactly(0));
+
+  EXPECT_THROW(tested->tick({{observable_id, DataVariant(string("value"))},
+                   {base_id + ":99", DataVariant(true)}}),
+      ElementNotFound);
+  EXPECT_THAT(
+      [this]() {
+        tested->tick({{observable_id, DataVariant(string("value"))},
+            {sub_readable_id, DataVariant(true)}});
+      },
+      ThrowsMessage<invalid_argument>(HasSubstr("is not an ObservableMock")));
+}
+
+} // namespace Information_Model::testing
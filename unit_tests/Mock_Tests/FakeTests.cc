@@ -0,0 +1,300 @@
+#include "DeviceMock.hpp"
+#include "ElementFake.hpp"
+#include "MockBuilder.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+TEST(FakeTests, readableFakeReturnsValue) {
+  auto tested = make_shared<ReadableFake>(DataVariant(intmax_t{42}));
+
+  EXPECT_EQ(tested->dataType(), DataType::Integer);
+  EXPECT_EQ(tested->read(), DataVariant(intmax_t{42}));
+
+  tested->updateValue(DataVariant(string("changed")));
+
+  EXPECT_EQ(tested->dataType(), DataType::String);
+  EXPECT_EQ(tested->read(), DataVariant(string("changed")));
+}
+
+TEST(FakeTests, readableFakeUsesReadCallback) {
+  MockFunction<DataVariant()> mock_read;
+  EXPECT_CALL(mock_read, Call())
+      .Times(Exactly(1))
+      .WillOnce(Return(DataVariant(1.5)));
+  auto tested =
+      make_shared<ReadableFake>(DataType::Double, mock_read.AsStdFunction());
+
+  EXPECT_EQ(tested->read(), DataVariant(1.5));
+}
+
+TEST(FakeTests, readableFakeThrowsReadCallbackUnavailable) {
+  auto tested = make_shared<ReadableFake>(DataType::Double, nullptr);
+
+  EXPECT_THROW(tested->read(), ReadCallbackUnavailable);
+}
+
+TEST(FakeTests, writableFakeForwardsWrites) {
+  MockFunction<void(const DataVariant&)> mock_write;
+  EXPECT_CALL(mock_write, Call(DataVariant(true))).Times(Exactly(1));
+  auto tested =
+      make_shared<WritableFake>(DataType::Boolean, mock_write.AsStdFunction());
+
+  EXPECT_TRUE(tested->isWriteOnly());
+  EXPECT_THROW(tested->read(), NonReadable);
+  EXPECT_NO_THROW(tested->write(DataVariant(true)));
+}
+
+TEST(FakeTests, writableFakeThrowsWriteCallbackUnavailable) {
+  auto tested = make_shared<WritableFake>(DataVariant(false));
+  EXPECT_NO_THROW(tested->write(DataVariant(true)));
+
+  tested->updateWriteCallback(nullptr);
+
+  EXPECT_EQ(tested->read(), DataVariant(false));
+  EXPECT_THROW(tested->write(DataVariant(true)), WriteCallbackUnavailable);
+}
+
+TEST(FakeTests, observableFakeNotifiesObservers) {
+  MockFunction<void(bool)> mock_enable_observation;
+  MockFunction<void(const shared_ptr<DataVariant>&)> mock_observer_cb;
+  EXPECT_CALL(mock_enable_observation, Call(true)).Times(Exactly(1));
+  EXPECT_CALL(mock_enable_observation, Call(false)).Times(Exactly(1));
+  EXPECT_CALL(mock_observer_cb, Call(Pointee(DataVariant(2.5))))
+      .Times(Exactly(1));
+  auto tested = make_shared<ObservableFake>(DataVariant(0.5));
+  tested->enableSubscribeFaking(mock_enable_observation.AsStdFunction());
+
+  auto connection = tested->subscribe(
+      mock_observer_cb.AsStdFunction(), [](const exception_ptr&) {});
+  tested->notify(DataVariant(2.5));
+  connection.reset();
+  tested->notify(DataVariant(3.5));
+
+  EXPECT_EQ(tested->read(), DataVariant(0.5));
+}
+
+TEST(FakeTests, observableFakeCanSubscribeWhileTransitioning) {
+  vector<bool> transitions;
+  ObserverPtr resubscribed;
+  bool resubscribe = true;
+  auto tested = make_shared<ObservableFake>(DataType::Boolean);
+  auto ignore_value = [](const shared_ptr<DataVariant>&) {};
+  auto ignore_exception = [](const exception_ptr&) {};
+  tested->enableSubscribeFaking([&](bool observing) {
+    transitions.push_back(observing);
+    if (!observing && resubscribe) {
+      resubscribe = false;
+      resubscribed = tested->subscribe(ignore_value, ignore_exception);
+    }
+  });
+
+  auto connection = tested->subscribe(ignore_value, ignore_exception);
+  connection.reset();
+
+  EXPECT_THAT(transitions, ElementsAre(true, false, true));
+  resubscribed.reset();
+  EXPECT_THAT(transitions, ElementsAre(true, false, true, false));
+}
+
+TEST(FakeTests, observableFakeReleasesObserverOnThrowingObservingCallback) {
+  vector<bool> transitions;
+  bool fail_attach = false;
+  auto tested = make_shared<ObservableFake>(DataType::Boolean);
+  auto ignore_exception = [](const exception_ptr&) {};
+  tested->enableSubscribeFaking([&](bool observing) {
+    transitions.push_back(observing);
+    if (observing && fail_attach) {
+      throw runtime_error("Observing failed");
+    }
+  });
+  // leaves slot 1 on top of the free slots, so the failed observer does not
+  // use slot 0
+  auto first = tested->subscribe(
+      [](const shared_ptr<DataVariant>&) {}, ignore_exception);
+  auto second = tested->subscribe(
+      [](const shared_ptr<DataVariant>&) {}, ignore_exception);
+  first.reset();
+  second.reset();
+
+  fail_attach = true;
+  EXPECT_THAT(
+      [&]() {
+        tested->subscribe(
+            [](const shared_ptr<DataVariant>&) {}, ignore_exception);
+      },
+      ThrowsMessage<runtime_error>(HasSubstr("Observing failed")));
+  fail_attach = false;
+
+  size_t received = 0;
+  auto count = [&received](const shared_ptr<DataVariant>&) { ++received; };
+  auto third = tested->subscribe(count, ignore_exception);
+  auto fourth = tested->subscribe(count, ignore_exception);
+  tested->notify(DataVariant(true));
+
+  EXPECT_EQ(received, 2);
+  EXPECT_THAT(transitions, ElementsAre(true, false, true, false, true));
+}
+
+TEST(FakeTests, observableFakePayloadsOutliveObservable) {
+  shared_ptr<DataVariant> retained;
+  auto tested = make_shared<ObservableFake>(DataType::String);
+  tested->enableSubscribeFaking([](bool) {});
+  auto connection = tested->subscribe(
+      [&retained](const shared_ptr<DataVariant>& value) { retained = value; },
+      [](const exception_ptr&) {});
+
+  tested->notify(DataVariant(string("retained")));
+  connection.reset();
+  tested.reset();
+
+  ASSERT_NE(retained, nullptr);
+  EXPECT_EQ(*retained, DataVariant(string("retained")));
+  EXPECT_NO_THROW(retained.reset());
+}
+
+TEST(FakeTests, deviceTicksAndTracksObservableFakes) {
+  vector<DataVariant> received;
+  auto device = make_shared<NiceMock<DeviceMock>>("base_id");
+  auto observable = make_shared<ObservableFake>(DataType::Double);
+  auto observable_id = device->generateID();
+  device->addElement(
+      make_shared<ElementFake>(observable, observable_id, FullMetaInfo{}));
+  observable->enableSubscribeFaking([](bool) {});
+  device->enableLatencyTracking(true);
+  auto observer = observable->subscribe(
+      [&received](const shared_ptr<DataVariant>& value) {
+        received.push_back(*value);
+      },
+      [](const exception_ptr&) {});
+
+  device->tick({{observable_id, DataVariant(1.5)}});
+  observable->notify(DataVariant(2.5));
+
+  EXPECT_THAT(received, ElementsAre(DataVariant(1.5), DataVariant(2.5)));
+  auto latencies = device->notificationLatencies();
+  ASSERT_EQ(latencies[observable_id].size(), 1);
+  EXPECT_EQ(latencies[observable_id][0].notify_to_dispatch.count(), 2);
+}
+
+TEST(FakeTests, writableFakeUpdatesWriteCallbackWhileWriting) {
+  constexpr size_t UPDATE_COUNT = 10000;
+  atomic<size_t> writes = 0;
+  auto tested = make_shared<WritableFake>(
+      DataType::Boolean, [&writes](const DataVariant&) { ++writes; });
+  atomic<bool> updating = true;
+
+  thread writer([&tested, &updating]() {
+    while (updating) {
+      tested->write(DataVariant(true));
+    }
+  });
+  // keeps updating until the writer ran at least once, even on a busy machine
+  for (size_t i = 0; i < UPDATE_COUNT || writes == 0; ++i) {
+    tested->updateWriteCallback(
+        [&writes](const DataVariant&) { ++writes; });
+  }
+  updating = false;
+  writer.join();
+
+  EXPECT_GT(writes, 0);
+}
+
+TEST(FakeTests, callableFakeCallsExecutor) {
+  auto tested = make_shared<CallableFake>(
+      DataType::Integer, ParameterTypes{}, DataVariant(intmax_t{-11}));
+  auto executor = tested->getExecutor();
+  executor->start();
+
+  EXPECT_EQ(tested->resultType(), DataType::Integer);
+  EXPECT_EQ(tested->call(200), DataVariant(intmax_t{-11}));
+  executor->stop();
+}
+
+TEST(FakeTests, callableFakeThrowsResultReturningNotSupported) {
+  MockFunction<void(const Parameters&)> mock_execute;
+  EXPECT_CALL(mock_execute, Call(_)).Times(Exactly(1));
+  auto tested = make_shared<CallableFake>(mock_execute.AsStdFunction());
+
+  EXPECT_NO_THROW(tested->execute(Parameters{}));
+  EXPECT_THROW(tested->call(Parameters{}, 1), ResultReturningNotSupported);
+}
+
+TEST(FakeTests, elementFakeReturnsMetaInfo) {
+  auto function = make_shared<ReadableFake>(DataType::Boolean);
+  auto tested = make_shared<ElementFake>(
+      function, "base_id:0", FullMetaInfo{"element_name", "element_desc"});
+
+  EXPECT_EQ(tested->id(), "base_id:0");
+  EXPECT_EQ(tested->name(), "element_name");
+  EXPECT_EQ(tested->description(), "element_desc");
+  EXPECT_EQ(tested->type(), ElementType::Readable);
+  EXPECT_EQ(get<ReadablePtr>(tested->function()), function);
+}
+
+TEST(FakeTests, builderCanBuildFakes) {
+  auto builder = make_shared<MockBuilder>();
+  builder->enableFakes();
+  builder->setDeviceInfo("base_id", BuildInfo{"device_name"});
+  auto group_id = builder->addGroup(BuildInfo{"group_name"});
+  auto readable_id = builder->addReadable(
+      group_id, BuildInfo{"readable_name"}, DataVariant(intmax_t{7}));
+  auto writable_id =
+      builder->addWritable(BuildInfo{"writable_name"}, DataVariant(true));
+  auto [observable_id, notify] = builder->addObservable(
+      BuildInfo{"observable_name"}, DataType::Double, [](bool) {});
+  auto callable_id =
+      builder->addCallable(BuildInfo{"callable_name"}, DataType::String);
+  auto device = builder->result();
+
+  auto element = device->element(readable_id);
+  EXPECT_NE(dynamic_pointer_cast<ElementFake>(element), nullptr);
+  auto readable = get<ReadablePtr>(element->function());
+  EXPECT_NE(dynamic_pointer_cast<ReadableFake>(readable), nullptr);
+  EXPECT_EQ(readable->read(), DataVariant(intmax_t{7}));
+  auto writable = get<WritablePtr>(device->element(writable_id)->function());
+  EXPECT_NE(dynamic_pointer_cast<WritableFake>(writable), nullptr);
+  EXPECT_EQ(writable->read(), DataVariant(true));
+  auto observable =
+      get<ObservablePtr>(device->element(observable_id)->function());
+  EXPECT_NE(dynamic_pointer_cast<ObservableFake>(observable), nullptr);
+  auto callable = get<CallablePtr>(device->element(callable_id)->function());
+  EXPECT_NE(dynamic_pointer_cast<CallableFake>(callable), nullptr);
+  // groups keep the device-wide ID index, so they are still mocks
+  EXPECT_NE(dynamic_pointer_cast<GroupMock>(
+                get<GroupPtr>(device->element(group_id)->function())),
+      nullptr);
+}
+
+TEST(FakeTests, builderNotifiesObservableFakes) {
+  MockFunction<void(const shared_ptr<DataVariant>&)> mock_observer_cb;
+  EXPECT_CALL(mock_observer_cb, Call(Pointee(DataVariant(1.5))))
+      .Times(Exactly(1));
+  auto builder = make_shared<MockBuilder>();
+  builder->enableFakes();
+  builder->setDeviceInfo("base_id", BuildInfo{"device_name"});
+  auto [observable_id, notify] = builder->addObservable(
+      BuildInfo{"observable_name"}, DataType::Double, [](bool) {});
+  auto device = builder->result();
+  auto observable =
+      get<ObservablePtr>(device->element(observable_id)->function());
+
+  auto connection = observable->subscribe(
+      mock_observer_cb.AsStdFunction(), [](const exception_ptr&) {});
+  notify(DataVariant(1.5));
+}
+
+TEST(FakeTests, enableFakesThrowsDeviceBuildInProgress) {
+  auto builder = make_shared<MockBuilder>();
+  builder->setDeviceInfo("base_id", BuildInfo{"device_name"});
+
+  EXPECT_THROW(builder->enableFakes(), DeviceBuildInProgress);
+}
+} // namespace Information_Model::testing
@@ -0,0 +1,166 @@
+#include "FleetGenerator.hpp"
+
+#include <Variant_Visitor/Visitor.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+// Lists the type and data type of each element in depth-first order
+void describe(const GroupPtr& group, string& description) {
+  group->visit([&description](const ElementPtr& element) {
+    description += element->id() + "=" + toString(element->type());
+    Variant_Visitor::match(
+        element->function(),
+        [&description](const GroupPtr& subgroup) {
+          description += "{";
+          describe(subgroup, description);
+          description += "}";
+        },
+        [&description](const ReadablePtr& readable) {
+          description += toString(readable->dataType());
+        },
+        [&description](const WritablePtr& writable) {
+          description += toString(writable->dataType());
+        },
+        [&description](const ObservablePtr& observable) {
+          description += toString(observable->dataType());
+        },
+        [&description](const CallablePtr& callable) {
+          description += toString(callable->resultType());
+        });
+    description += ";";
+  });
+}
+
+string describe(const vector<DevicePtr>& devices) {
+  string description;
+  for (const auto& device : devices) {
+    description += device->id() + ":";
+    describe(device->group(), description);
+  }
+  return description;
+}
+
+FleetShape mixedShape(uint64_t seed) {
+  FleetShape shape;
+  shape.device_count = 4;
+  shape.elements_per_group = 8;
+  shape.group_fan_out = 2;
+  shape.depth = 2;
+  shape.element_mix = ElementMix{3, 2, 2, 1};
+  shape.data_type_mix = {{DataType::Boolean, 1},
+      {DataType::Integer, 1},
+      {DataType::Double, 2},
+      {DataType::String, 1}};
+  shape.seed = seed;
+  return shape;
+}
+
+TEST(FleetGeneratorTests, generatesShape) {
+  FleetShape shape;
+  shape.device_count = 2;
+  shape.elements_per_group = 3;
+  shape.group_fan_out = 2;
+  shape.depth = 2;
+  shape.id_prefix = "gateway_";
+  FleetGenerator tested(shape);
+
+  auto devices = tested.generate();
+
+  ASSERT_EQ(devices.size(), 2);
+  EXPECT_EQ(devices[1]->id(), "gateway_1");
+  EXPECT_EQ(devices[1]->group()->size(), 5);
+  EXPECT_EQ(devices[1]->element("gateway_1:0")->type(), ElementType::Readable);
+  auto nested = get<GroupPtr>(devices[1]->element("gateway_1:4")->function());
+  EXPECT_EQ(nested->size(), 5);
+  auto leaf = get<GroupPtr>(devices[1]->element("gateway_1:4.4")->function());
+  EXPECT_EQ(leaf->size(), 3);
+  EXPECT_EQ(tested.elementsPerDevice(), 27);
+  EXPECT_EQ(tested.report().devices, 2);
+  EXPECT_EQ(tested.report().elements, 54);
+  EXPECT_GT(tested.report().elementsPerSecond(), 0);
+}
+
+TEST(FleetGeneratorTests, isDeterministic) {
+  WorkerPool pool(2);
+  auto serial = describe(FleetGenerator(mixedShape(7)).generate());
+  auto parallel = describe(FleetGenerator(mixedShape(7)).generate(pool));
+  auto reseeded = describe(FleetGenerator(mixedShape(8)).generate(pool));
+
+  EXPECT_EQ(serial, parallel);
+  EXPECT_NE(serial, reseeded);
+  EXPECT_THAT(serial, HasSubstr("Callable"));
+  EXPECT_THAT(serial, HasSubstr("String"));
+}
+
+TEST(FleetGeneratorTests, followsMix) {
+  FleetShape shape;
+  shape.elements_per_group = 20;
+  shape.element_mix = ElementMix{0, 0, 1, 0};
+  shape.data_type_mix = {{DataType::Boolean, 0}, {DataType::Double, 1}};
+  auto devices = FleetGenerator(shape).generate();
+
+  size_t visited = 0;
+  devices[0]->group()->visit([&visited](const ElementPtr& element) {
+    ++visited;
+    ASSERT_EQ(element->type(), ElementType::Observable);
+    EXPECT_EQ(
+        get<ObservablePtr>(element->function())->dataType(), DataType::Double);
+  });
+  EXPECT_EQ(visited, 20);
+}
+
+TEST(FleetGeneratorTests, configuresEachBuilder) {
+  FleetShape shape;
+  shape.device_count = 3;
+  atomic<size_t> configured{0};
+  FleetGenerator tested(shape, [&configured](MockBuilder& builder) {
+    builder.enableLazyElements();
+    ++configured;
+  });
+  WorkerPool pool(2);
+
+  auto devices = tested.generate(pool);
+
+  EXPECT_EQ(configured, 3);
+  EXPECT_EQ(devices[2]->group()->size(), 10);
+}
+
+TEST(FleetGeneratorTests, throwsOnInvalidShape) {
+  FleetShape no_elements;
+  no_elements.element_mix = ElementMix{0, 0, 0, 0};
+  FleetShape no_data_types;
+  no_data_types.data_type_mix = {};
+  FleetShape unknown_type;
+  unknown_type.data_type_mix = {{DataType::Unknown, 1}};
+  FleetShape empty;
+  empty.elements_per_group = 0;
+  empty.depth = 1;
+  FleetShape empty_nested;
+  empty_nested.elements_per_group = 0;
+  empty_nested.group_fan_out = 2;
+  empty_nested.depth = 1;
+
+  EXPECT_THAT([&]() { FleetGenerator{no_elements}; },
+      ThrowsMessage<invalid_argument>(HasSubstr("Element mix has no weights")));
+  EXPECT_THAT([&]() { FleetGenerator{no_data_types}; },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("Data type mix has no weights")));
+  EXPECT_THAT([&]() { FleetGenerator{unknown_type}; },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("Data type mix can not contain Unknown")));
+  EXPECT_THAT([&]() { FleetGenerator{empty}; },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("describes devices without elements")));
+  EXPECT_THAT([&]() { FleetGenerator{empty_nested}; },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("describes empty nested groups")));
+  EXPECT_THAT([]() { FleetGenerator(FleetShape{}).generateDevice(1); },
+      ThrowsMessage<out_of_range>(HasSubstr("no device with index 1")));
+}
+} // namespace Information_Model::testing
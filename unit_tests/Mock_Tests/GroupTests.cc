@@ -1,7 +1,9 @@
+#include "AllocationCounter.hpp"
 #include "ElementMock.hpp"
 #include "GroupMock.hpp"
 
 #include <gtest/gtest.h>
+#include <mutex>
 #include <unordered_map>
 
 namespace Information_Model::testing {
@@ -103,6 +105,14 @@ TEST_F(GroupTests, addElementThrows) {
       },
       ThrowsMessage<logic_error>(HasSubstr(
           "Element with id " + base_id + ".0 is already in this group")));
+
+  EXPECT_THAT(
+      [&]() {
+        tested->addElement(make_shared<NiceMock<ElementMock>>(
+            make_shared<ReadableMock>(DataType::Opaque), base_id + ".x"));
+      },
+      ThrowsMessage<invalid_argument>(HasSubstr(
+          "Given element id " + base_id + ".x does not end with a number")));
 }
 
 TEST_F(GroupTests, throwsElementNotFound) {
@@ -189,6 +199,289 @@ TEST_F(GroupTests, canGetAsVector) {
   EXPECT_THAT(tested_vector, ContainerEq(built_as_vector));
 }
 
+TEST(GroupMockTests, keepsInsertionOrder) {
+  auto tested = make_shared<NiceMock<GroupMock>>("sparse:");
+  auto readable = make_shared<NiceMock<ReadableMock>>(DataType::Boolean);
+  auto first = make_shared<NiceMock<ElementMock>>(readable, "sparse:5");
+  auto second = make_shared<NiceMock<ElementMock>>(readable, "sparse:1");
+  auto third = make_shared<NiceMock<ElementMock>>(readable, "sparse:3");
+  tested->addElement(first);
+  tested->addElement(second);
+  tested->addElement(third);
+  vector<ElementPtr> visited;
+
+  tested->visit([&visited](const ElementPtr& element) {
+    visited.push_back(element);
+  });
+
+  EXPECT_EQ(tested->size(), 3);
+  EXPECT_THAT(tested->asVector(),
+      ElementsAre(ElementPtr(first), ElementPtr(second), ElementPtr(third)));
+  EXPECT_EQ(visited, tested->asVector());
+  EXPECT_EQ(tested->element("sparse:5"), first);
+  EXPECT_THAT([&]() { tested->addElement(first); },
+      ThrowsMessage<logic_error>(HasSubstr("is already in this group")));
+}
+
+TEST(GroupMockTests, acceptsOutlyingLocalIds) {
+  auto tested = make_shared<NiceMock<GroupMock>>("dev:");
+  auto readable = make_shared<NiceMock<ReadableMock>>(DataType::Boolean);
+  auto largest = make_shared<NiceMock<ElementMock>>(
+      readable, "dev:18446744073709551615");
+  auto far = make_shared<NiceMock<ElementMock>>(readable, "dev:4000000000");
+  auto near = make_shared<NiceMock<ElementMock>>(readable, "dev:0");
+
+  tested->addElement(largest);
+  tested->addElement(far);
+  tested->addElements({"dev:0"}, {near});
+
+  EXPECT_EQ(tested->size(), 3);
+  EXPECT_EQ(tested->element("dev:18446744073709551615"), largest);
+  EXPECT_EQ(tested->element("dev:4000000000"), far);
+  EXPECT_THAT([&]() { tested->addElement(far); },
+      ThrowsMessage<logic_error>(HasSubstr("is already in this group")));
+  EXPECT_THAT([&]() { tested->addElements({"dev:4000000000"}, {far}); },
+      ThrowsMessage<logic_error>(HasSubstr("is already in this group")));
+}
+
+TEST(GroupMockTests, canAddElementsInBulk) {
+  auto tested = make_shared<NiceMock<GroupMock>>("device:0");
+  auto readable = make_shared<NiceMock<ReadableMock>>(DataType::Boolean);
+  auto ids = tested->generateIDs(3);
+  vector<ElementPtr> elements;
+  for (const auto& id : ids) {
+    elements.push_back(make_shared<NiceMock<ElementMock>>(readable, id));
+  }
+
+  tested->addElements(ids, elements);
+
+  EXPECT_THAT(ids, ElementsAre("device:0.0", "device:0.1", "device:0.2"));
+  EXPECT_EQ(tested->size(), 3);
+  EXPECT_EQ(tested->asVector(), elements);
+  EXPECT_EQ(tested->element("device:0.2"), elements.back());
+  EXPECT_EQ(tested->generateID(), "device:0.3");
+}
+
+TEST(GroupMockTests, addElementsAddsNothingOnError) {
+  auto tested = make_shared<NiceMock<GroupMock>>("device:0");
+  auto readable = make_shared<NiceMock<ReadableMock>>(DataType::Boolean);
+  auto existing = make_shared<NiceMock<ElementMock>>(readable, "device:0.1");
+  tested->addElement(existing);
+  auto element = make_shared<NiceMock<ElementMock>>(readable, "device:0.0");
+
+  EXPECT_THAT([&]() { tested->addElements({"device:0.0"}, {}); },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("Given ID and element counts differ")));
+  EXPECT_THAT([&]() { tested->addElements({"device:0.0"}, {nullptr}); },
+      ThrowsMessage<invalid_argument>(HasSubstr("Given element is empty")));
+  EXPECT_THAT([&]() { tested->addElements({"device:0.0.1"}, {element}); },
+      ThrowsMessage<invalid_argument>(HasSubstr("is not a child")));
+  EXPECT_THAT([&]() { tested->addElements({"device:0.a"}, {element}); },
+      ThrowsMessage<invalid_argument>(HasSubstr("does not end with a number")));
+  auto group = make_shared<NiceMock<ElementMock>>(
+      make_shared<NiceMock<GroupMock>>("device:0.0"), "device:0.0");
+  EXPECT_THAT([&]() { tested->addElements({"device:0.0"}, {group}); },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("Groups can not be added in bulk")));
+  EXPECT_THAT(
+      [&]() {
+        tested->addElements({"device:0.0", "device:0.1"}, {element, element});
+      },
+      ThrowsMessage<logic_error>(HasSubstr("is already in this group")));
+  EXPECT_EQ(tested->size(), 1);
+
+  EXPECT_NO_THROW(tested->addElements({"device:0.0"}, {element}));
+  EXPECT_EQ(tested->size(), 2);
+}
+
+TEST(GroupMockTests, addsCreatedElementsInBulk) {
+  auto tested = make_shared<NiceMock<GroupMock>>("device:0");
+  auto readable = make_shared<NiceMock<ReadableMock>>(DataType::Boolean);
+  auto factory = [readable](size_t, const string& id) -> ElementPtr {
+    return make_shared<NiceMock<ElementMock>>(readable, id);
+  };
+
+  EXPECT_THAT(
+      [&]() {
+        tested->addElements(3, [&factory](size_t offset, const string& id) {
+          if (offset == 2) {
+            throw runtime_error("Factory failed");
+          }
+          return factory(offset, id);
+        });
+      },
+      ThrowsMessage<runtime_error>(HasSubstr("Factory failed")));
+  EXPECT_EQ(tested->size(), 0);
+
+  EXPECT_EQ(tested->addElements(2, factory), 0);
+  EXPECT_EQ(tested->size(), 2);
+  EXPECT_EQ(tested->element("device:0.1")->id(), "device:0.1");
+  EXPECT_EQ(tested->generateID(), "device:0.2");
+}
+
+TEST(GroupMockTests, createsLazyElementsOnFirstAccess) {
+  auto tested = make_shared<NiceMock<GroupMock>>("device:");
+  auto readable = make_shared<NiceMock<ReadableMock>>(DataType::Boolean);
+  vector<size_t> created;
+  auto first = tested->addLazyElements(
+      3, [&created, readable](size_t offset, const string& id) {
+        created.push_back(offset);
+        return make_shared<NiceMock<ElementMock>>(readable, id);
+      });
+
+  EXPECT_EQ(first, 0);
+  EXPECT_EQ(tested->size(), 3);
+  EXPECT_TRUE(created.empty());
+
+  auto element = tested->element("device:2");
+
+  EXPECT_EQ(element->id(), "device:2");
+  EXPECT_EQ(tested->element("device:2"), element);
+  EXPECT_THAT(created, ElementsAre(2));
+  EXPECT_EQ(tested->generateID(), "device:3");
+
+  EXPECT_EQ(tested->asVector().size(), 3);
+  EXPECT_THAT(created, UnorderedElementsAre(0, 1, 2));
+  EXPECT_EQ(tested->asVector()[2], element);
+}
+
+TEST(GroupMockTests, createsNestedLazyElements) {
+  auto tested = make_shared<NiceMock<GroupMock>>("device:");
+  auto readable = make_shared<NiceMock<ReadableMock>>(DataType::Boolean);
+  auto sub_group = make_shared<NiceMock<GroupMock>>("device:0");
+  tested->addElement(make_shared<NiceMock<ElementMock>>(sub_group, "device:0"));
+  size_t created = 0;
+  sub_group->addLazyElements(
+      2, [&created, readable](size_t, const string& id) {
+        ++created;
+        return make_shared<NiceMock<ElementMock>>(readable, id);
+      });
+
+  EXPECT_EQ(tested->element("device:0.1")->id(), "device:0.1");
+  EXPECT_EQ(created, 1);
+
+  size_t visited = 0;
+  sub_group->visit([&visited](const ElementPtr&) { ++visited; });
+
+  EXPECT_EQ(visited, 2);
+  EXPECT_EQ(created, 2);
+}
+
+TEST(GroupMockTests, keepsLazyElementIdsOfReleasedParents) {
+  constexpr size_t LAZY_COUNT = 100;
+  auto tested = make_shared<NiceMock<GroupMock>>("device:");
+  auto readable = make_shared<NiceMock<ReadableMock>>(DataType::Boolean);
+  GroupMock::ElementFactory factory = [readable](size_t, const string& id) {
+    return make_shared<NiceMock<ElementMock>>(readable, id);
+  };
+  tested->addLazyElements(LAZY_COUNT, factory);
+  auto sub_group = make_shared<NiceMock<GroupMock>>("device:100");
+  tested->addElement(
+      make_shared<NiceMock<ElementMock>>(sub_group, "device:100"));
+  EXPECT_EQ(tested->asVector().size(), LAZY_COUNT + 1);
+
+  // the shared element index outlives the parent with its nested group
+  tested.reset();
+  sub_group->addLazyElements(LAZY_COUNT, factory);
+
+  EXPECT_EQ(sub_group->asVector().size(), LAZY_COUNT);
+  EXPECT_EQ(sub_group->element("device:100.99")->id(), "device:100.99");
+}
+
+TEST(GroupMockTests, doesNotFindMissingLazyElements) {
+  auto tested = make_shared<NiceMock<GroupMock>>("device:");
+  auto readable = make_shared<NiceMock<ReadableMock>>(DataType::Boolean);
+  tested->addLazyElements(2, [readable](size_t, const string& id) {
+    return make_shared<NiceMock<ElementMock>>(readable, id);
+  });
+
+  EXPECT_THAT([&]() { tested->element("device:2"); },
+      ThrowsMessage<ElementNotFound>(HasSubstr("device:2 was not found")));
+  EXPECT_THAT([&]() { tested->element("device:01"); },
+      ThrowsMessage<ElementNotFound>(HasSubstr("device:01 was not found")));
+  EXPECT_THAT([&]() { tested->element("device:1.0"); },
+      ThrowsMessage<ElementNotFound>(HasSubstr("device:1.0 was not found")));
+  EXPECT_THAT([&]() { tested->addLazyElements(1, nullptr); },
+      ThrowsMessage<invalid_argument>(HasSubstr("ElementFactory can not be nullptr")));
+}
+
+TEST(GroupMockTests, keepsUntouchedLazyElementsSmall) {
+  constexpr size_t LAZY_COUNT = 100000;
+  constexpr size_t MAX_BYTES_PER_ELEMENT = 64;
+  auto tested = make_shared<NiceMock<GroupMock>>("device:");
+  auto readable = make_shared<NiceMock<ReadableMock>>(DataType::Boolean);
+  GroupMock::ElementFactory factory = [readable](size_t, const string& id) {
+    return make_shared<NiceMock<ElementMock>>(readable, id);
+  };
+
+  AllocationCounter counter;
+  tested->addLazyElements(LAZY_COUNT, factory);
+
+  EXPECT_LT(counter.bytes() / LAZY_COUNT, MAX_BYTES_PER_ELEMENT);
+  EXPECT_EQ(tested->size(), LAZY_COUNT);
+}
+
+TEST(GroupMockTests, indexesGroupsBuiltBeforeAttaching) {
+  auto tested = make_shared<NiceMock<GroupMock>>("device:");
+  auto readable = make_shared<NiceMock<ReadableMock>>(DataType::Boolean);
+  auto sub_group = make_shared<NiceMock<GroupMock>>("device:0");
+  auto sub_sub_group = make_shared<NiceMock<GroupMock>>("device:0.0");
+  auto sub_sub_element =
+      make_shared<NiceMock<ElementMock>>(readable, "device:0.0.0");
+  sub_sub_group->addElement(sub_sub_element);
+  sub_group->addElement(
+      make_shared<NiceMock<ElementMock>>(sub_sub_group, "device:0.0"));
+  tested->addElement(make_shared<NiceMock<ElementMock>>(sub_group, "device:0"));
+  auto late_element =
+      make_shared<NiceMock<ElementMock>>(readable, "device:0.0.1");
+  sub_sub_group->addElement(late_element);
+
+  EXPECT_EQ(tested->element("device:0.0.0"), sub_sub_element);
+  EXPECT_EQ(tested->element("device:0.0.1"), late_element);
+  EXPECT_EQ(sub_group->element("device:0.0.1"), late_element);
+}
+
+TEST(GroupMockTests, doesNotFindSiblingElements) {
+  auto tested = make_shared<NiceMock<GroupMock>>("device:");
+  auto readable = make_shared<NiceMock<ReadableMock>>(DataType::Boolean);
+  auto sub_group = make_shared<NiceMock<GroupMock>>("device:1");
+  tested->addElement(make_shared<NiceMock<ElementMock>>(sub_group, "device:1"));
+  tested->addElement(make_shared<NiceMock<ElementMock>>(readable, "device:10"));
+
+  EXPECT_THAT([&]() { sub_group->element("device:10"); },
+      ThrowsMessage<ElementNotFound>(
+          HasSubstr("Element with reference id device:10 was not found")));
+  EXPECT_NO_THROW(tested->element("device:10"));
+}
+
+TEST_F(GroupTests, cachesSnapshots) {
+  auto map = tested->mapSnapshot();
+  auto vector = tested->vectorSnapshot();
+
+  EXPECT_EQ(tested->mapSnapshot(), map);
+  EXPECT_EQ(tested->vectorSnapshot(), vector);
+  EXPECT_THAT(tested->asMap(), ContainerEq(*map));
+  EXPECT_THAT(tested->asVector(), ContainerEq(*vector));
+}
+
+TEST_F(GroupTests, invalidatesSnapshotsOnAddElement) {
+  auto map = tested->mapSnapshot();
+  auto vector = tested->vectorSnapshot();
+  auto size = built.size();
+
+  tested->addElement(make_shared<NiceMock<ElementMock>>(
+      make_shared<NiceMock<ReadableMock>>(DataType::Boolean),
+      tested->generateID()));
+
+  EXPECT_NE(tested->mapSnapshot(), map);
+  EXPECT_NE(tested->vectorSnapshot(), vector);
+  EXPECT_EQ(tested->mapSnapshot()->size(), size + 1);
+  EXPECT_EQ(tested->vectorSnapshot()->size(), size + 1);
+  // handed out snapshots stay unchanged
+  EXPECT_EQ(map->size(), size);
+  EXPECT_EQ(vector->size(), size);
+}
+
 TEST_F(GroupTests, canVisitEach) {
   auto visitor = [&](const ElementPtr& tested_element) {
     auto it = built.find(tested_element->id());
@@ -207,4 +500,61 @@ TEST_F(GroupTests, canVisitEach) {
   EXPECT_NO_THROW(tested->visit(visitor));
 }
 
+TEST_F(GroupTests, canVisitInParallel) {
+  WorkerPool pool(3);
+  mutex visited_mx;
+  vector<string> visited;
+
+  tested->parallelVisit(pool, [&](const ElementPtr& element) {
+    scoped_lock guard(visited_mx);
+    visited.push_back(element->id());
+  });
+
+  EXPECT_THAT(visited,
+      UnorderedElementsAre(base_id + ".0",
+          base_id + ".1",
+          base_id + ".2",
+          base_id + ".3",
+          base_id + ".4",
+          base_id + ".4.0",
+          base_id + ".4.1",
+          base_id + ".4.1.0"));
+}
+
+TEST_F(GroupTests, canVisitInParallelWithOrderedPaths) {
+  WorkerPool pool(3);
+  vector<string> visited;
+
+  tested->parallelVisit(
+      pool,
+      [&](const ElementPtr& element, const IdPath& path) {
+        EXPECT_EQ(element->id(), path.str());
+        visited.emplace_back(path.str());
+      },
+      VisitOrder::Ordered);
+
+  EXPECT_THAT(visited,
+      ElementsAre(base_id + ".0",
+          base_id + ".1",
+          base_id + ".2",
+          base_id + ".3",
+          base_id + ".4",
+          base_id + ".4.0",
+          base_id + ".4.1",
+          base_id + ".4.1.0"));
+}
+
+TEST_F(GroupTests, parallelVisitRethrowsVisitorException) {
+  WorkerPool pool(3);
+
+  EXPECT_THAT(
+      [&]() {
+        tested->parallelVisit(pool, [&](const ElementPtr& element) {
+          if (element == sub_sub_element) {
+            throw runtime_error("Visitor failure");
+          }
+        });
+      },
+      ThrowsMessage<runtime_error>(HasSubstr("Visitor failure")));
+}
 } // namespace Information_Model::testing
\ No newline at end of file
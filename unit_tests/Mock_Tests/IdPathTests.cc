@@ -0,0 +1,120 @@
+#include "AllocationCounter.hpp"
+#include "DeviceMock.hpp"
+#include "ElementMock.hpp"
+#include "IdPath.hpp"
+
+#include <gtest/gtest.h>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+TEST(IdPathTests, canSliceRootPath) {
+  IdPath tested("device:");
+
+  EXPECT_TRUE(tested.isRoot());
+  EXPECT_EQ(tested.name(), "device");
+  EXPECT_TRUE(tested.contains("device:3.1"));
+  EXPECT_FALSE(tested.contains("device:"));
+  EXPECT_FALSE(tested.contains("other:3"));
+  EXPECT_EQ(tested.child("device:3.1.4"), "device:3");
+  EXPECT_EQ(tested.localId("device:3.1.4"), "3");
+  EXPECT_EQ(tested.childId(12), "device:12");
+}
+
+TEST(IdPathTests, canSliceNestedPath) {
+  IdPath tested("device:3.1");
+
+  EXPECT_FALSE(tested.isRoot());
+  EXPECT_EQ(tested.name(), "device:3.1");
+  EXPECT_TRUE(tested.contains("device:3.1.4"));
+  EXPECT_FALSE(tested.contains("device:3.14"));
+  EXPECT_FALSE(tested.contains("device:3.1"));
+  EXPECT_EQ(tested.child("device:3.1.4.1"), "device:3.1.4");
+  EXPECT_EQ(tested.localId("device:3.1.4.1"), "4");
+  EXPECT_TRUE(tested.child("device:3.2.4").empty());
+  EXPECT_EQ(tested.index(), 1);
+  EXPECT_EQ(tested.childId(0), "device:3.1.0");
+}
+
+TEST(IdPathTests, returnsNoIndexForNonNumericSegment) {
+  EXPECT_EQ(IdPath("device:3.a").index(), nullopt);
+  EXPECT_EQ(IdPath("device:").index(), nullopt);
+  EXPECT_EQ(IdPath("device:-1").index(), nullopt);
+  EXPECT_EQ(IdPath("device:7").index(), 7);
+}
+
+TEST(IdPathTests, doesNotAllocateOnQueries) {
+  const string group_id = "device:3.1";
+  const string ref_id = "device:3.1.4.1";
+  AllocationCounter counter;
+
+  IdPath tested(group_id);
+  auto contained = tested.contains(ref_id);
+  auto child = tested.child(ref_id);
+  auto local_id = tested.localId(ref_id);
+  auto index = IdPath(child).index();
+
+  EXPECT_EQ(counter.allocations(), 0);
+  EXPECT_TRUE(contained);
+  EXPECT_EQ(local_id, "4");
+  EXPECT_EQ(index, 4);
+}
+
+struct IdPathAllocationTests : public Test {
+  IdPathAllocationTests() {
+    for (size_t group_count = 0; group_count < 10; ++group_count) {
+      auto group_id = device->generateID();
+      auto group = make_shared<NiceMock<GroupMock>>(group_id);
+      device->addElement(make_shared<NiceMock<ElementMock>>(group, group_id));
+      ids.push_back(group_id);
+      groups.push_back(group);
+      for (size_t element_count = 0; element_count < 100; ++element_count) {
+        auto element_id = group->generateID();
+        group->addElement(
+            make_shared<NiceMock<ElementMock>>(readable, element_id));
+        ids.push_back(element_id);
+      }
+    }
+  }
+
+  DeviceMockPtr device = make_shared<NiceMock<DeviceMock>>("device");
+  ReadableMockPtr readable =
+      make_shared<NiceMock<ReadableMock>>(DataType::Boolean);
+  vector<GroupMockPtr> groups;
+  vector<string> ids;
+};
+
+TEST_F(IdPathAllocationTests, generatesIdWithSingleAllocation) {
+  auto group = groups.back();
+  AllocationCounter counter;
+
+  auto id = group->generateID();
+
+  EXPECT_LE(counter.allocations(), 1);
+  EXPECT_EQ(id, "device:9.100");
+}
+
+TEST_F(IdPathAllocationTests, lookupsOnlyAllocateForMockDispatch) {
+  // gmock may allocate while dispatching element() calls, so the baseline is
+  // the same number of lookups of the first root element
+  AllocationCounter baseline_counter;
+  for (size_t count = 0; count < ids.size(); ++count) {
+    device->element(ids.front());
+  }
+  auto baseline = baseline_counter.allocations();
+
+  size_t found = 0;
+  AllocationCounter lookup_counter;
+  for (const auto& id : ids) {
+    if (device->element(id)) {
+      ++found;
+    }
+  }
+  auto lookup_allocations = lookup_counter.allocations();
+
+  EXPECT_EQ(found, ids.size());
+  ASSERT_GE(lookup_allocations, baseline);
+  EXPECT_EQ(lookup_allocations - baseline, 0);
+}
+} // namespace Information_Model::testing
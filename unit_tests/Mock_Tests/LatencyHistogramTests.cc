@@ -0,0 +1,93 @@
+#include "LatencyHistogram.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace std::chrono;
+using namespace ::testing;
+
+TEST(LatencyHistogramTests, isEmptyByDefault) {
+  LatencyHistogram tested;
+
+  EXPECT_EQ(tested.count(), 0);
+  EXPECT_EQ(tested.min(), nanoseconds(0));
+  EXPECT_EQ(tested.max(), nanoseconds(0));
+  EXPECT_EQ(tested.mean(), nanoseconds(0));
+  EXPECT_EQ(tested.percentile(99), nanoseconds(0));
+}
+
+TEST(LatencyHistogramTests, recordsSmallValuesExactly) {
+  LatencyHistogram tested;
+  for (int i = 1; i <= 100; ++i) {
+    tested.record(nanoseconds(i));
+  }
+
+  EXPECT_EQ(tested.count(), 100);
+  EXPECT_EQ(tested.min(), nanoseconds(1));
+  EXPECT_EQ(tested.max(), nanoseconds(100));
+  EXPECT_EQ(tested.mean(), nanoseconds(51)); // 50.5 rounded
+  EXPECT_EQ(tested.percentile(50), nanoseconds(50));
+  EXPECT_EQ(tested.percentile(99), nanoseconds(99));
+  EXPECT_EQ(tested.percentile(100), nanoseconds(100));
+}
+
+TEST(LatencyHistogramTests, recordsLargeValuesWithinPrecision) {
+  LatencyHistogram tested;
+  for (int i = 1; i <= 1000; ++i) {
+    tested.record(microseconds(i));
+  }
+
+  auto p50 = duration<double, micro>(tested.percentile(50)).count();
+  auto p99 = duration<double, micro>(tested.percentile(99)).count();
+  EXPECT_NEAR(p50, 500.0, 500.0 / 50);
+  EXPECT_NEAR(p99, 990.0, 990.0 / 50);
+  EXPECT_EQ(tested.max(), milliseconds(1));
+}
+
+TEST(LatencyHistogramTests, recordsNegativeValuesAsZero) {
+  LatencyHistogram tested;
+  tested.record(nanoseconds(-10));
+
+  EXPECT_EQ(tested.count(), 1);
+  EXPECT_EQ(tested.max(), nanoseconds(0));
+}
+
+TEST(LatencyHistogramTests, canMerge) {
+  LatencyHistogram tested;
+  tested.record(nanoseconds(10));
+  LatencyHistogram other;
+  other.record(nanoseconds(5));
+  other.record(seconds(1));
+
+  tested.merge(other);
+
+  EXPECT_EQ(tested.count(), 3);
+  EXPECT_EQ(tested.min(), nanoseconds(5));
+  EXPECT_EQ(tested.max(), seconds(1));
+}
+
+TEST(LatencyHistogramTests, canReset) {
+  LatencyHistogram tested;
+  tested.record(nanoseconds(10));
+
+  tested.reset();
+
+  EXPECT_EQ(tested.count(), 0);
+  EXPECT_EQ(tested.max(), nanoseconds(0));
+}
+
+TEST(LatencyHistogramTests, throwsOnInvalidPercentile) {
+  LatencyHistogram tested;
+
+  EXPECT_THAT([&tested]() { tested.percentile(-1); },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("Percentile must be within [0,100] range")));
+  EXPECT_THAT([&tested]() { tested.percentile(100.1); },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("Percentile must be within [0,100] range")));
+}
+} // namespace Information_Model::testing
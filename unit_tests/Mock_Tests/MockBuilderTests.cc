@@ -1,6 +1,7 @@
 #include "MockBuilder.hpp"
 
 #include <gtest/gtest.h>
+#include <thread>
 
 namespace Information_Model::testing {
 using namespace std;
@@ -82,6 +83,27 @@ TEST(MockBuilderTests, throwsGroupEmpty) {
           HasSubstr("Device base_id group " + group_id + " is empty")));
 }
 
+TEST(MockBuilderTests, tracksEmptyGroupsWhileBuilding) {
+  auto builder = make_shared<MockBuilder>();
+  builder->setDeviceInfo("base_id", BuildInfo{"device_name"});
+  auto group_id = builder->addGroup(BuildInfo{"group_name"});
+  auto nested_id = builder->addGroup(group_id, BuildInfo{"nested_name"});
+  auto bulk_id = builder->addGroup(BuildInfo{"bulk_name"});
+
+  EXPECT_THAT([&]() { builder->result(); },
+      ThrowsMessage<GroupEmpty>(HasSubstr(" is empty")));
+
+  builder->addReadable(nested_id, BuildInfo{"readable"}, DataType::Boolean);
+  builder->addElements(bulk_id, {});
+  EXPECT_THAT([&]() { builder->result(); },
+      ThrowsMessage<GroupEmpty>(
+          HasSubstr("Device base_id group " + bulk_id + " is empty")));
+
+  builder->addElements(bulk_id,
+      {{ElementType::Readable, BuildInfo{"readable"}, DataType::Boolean}});
+  EXPECT_NE(builder->result(), nullptr);
+}
+
 TEST(MockBuilderTests, throwsInvalidArgument) {
   DeviceBuilderPtr builder = make_shared<MockBuilder>();
 
@@ -305,4 +327,203 @@ TEST(MockBuilderTests, returnsCorrectID) {
   // NOLINTEND(modernize-use-nullptr)
   EXPECT_NO_THROW(builder->result());
 }
+
+TEST(MockBuilderTests, canBuildInArena) {
+  auto builder = make_shared<MockBuilder>();
+  // small initial size, so the arena has to grow
+  builder->enableArena(256);
+  builder->setDeviceInfo("base_id", BuildInfo{"device_name"});
+  auto group_id = builder->addGroup(BuildInfo{"group_name"});
+  vector<string> readable_ids;
+  for (intmax_t value = 0; value < 100; ++value) {
+    readable_ids.push_back(builder->addReadable(
+        group_id, BuildInfo{"readable_name"}, DataVariant(value)));
+  }
+  auto device = builder->result();
+
+  auto element = device->element(readable_ids.back());
+  device.reset();
+
+  auto readable = get<ReadablePtr>(element->function());
+  EXPECT_EQ(element->id(), "base_id:0.99");
+  EXPECT_EQ(readable->read(), DataVariant(intmax_t{99}));
+}
+
+TEST(MockBuilderTests, buildsEachDeviceInItsOwnArena) {
+  auto builder = make_shared<MockBuilder>();
+  builder->enableArena();
+  builder->setDeviceInfo("first_id", BuildInfo{"device_name"});
+  builder->addReadable(BuildInfo{"readable_name"}, DataType::Boolean);
+  auto first = builder->result();
+  builder->setDeviceInfo("second_id", BuildInfo{"device_name"});
+  builder->addReadable(BuildInfo{"readable_name"}, DataType::Double);
+  auto second = builder->result();
+
+  first.reset();
+
+  EXPECT_EQ(second->element("second_id:0")->id(), "second_id:0");
+}
+
+TEST(MockBuilderTests, enableArenaThrowsDeviceBuildInProgress) {
+  auto builder = make_shared<MockBuilder>();
+  builder->setDeviceInfo("base_id", BuildInfo{"device_name"});
+
+  EXPECT_THROW(builder->enableArena(), DeviceBuildInProgress);
+}
+
+TEST(MockBuilderTests, canAddElementsInBulk) {
+  auto builder = make_shared<MockBuilder>();
+  builder->setDeviceInfo("base_id", BuildInfo{"device_name"});
+  auto root_ids = builder->addElements("",
+      {{ElementType::Readable, BuildInfo{"readable"}, DataType::Double},
+          {ElementType::Writable, BuildInfo{"writable"}, DataType::Boolean,
+              DataVariant(true)}});
+  auto group_id = builder->addGroup(BuildInfo{"group_name"});
+  auto nested_ids = builder->addElements(group_id,
+      {{ElementType::Observable, BuildInfo{"observable"}, DataType::String},
+          {ElementType::Callable, BuildInfo{"callable"}, DataType::Integer}});
+  auto device = builder->result();
+
+  EXPECT_THAT(root_ids, ElementsAre("base_id:0", "base_id:1"));
+  EXPECT_THAT(nested_ids, ElementsAre("base_id:2.0", "base_id:2.1"));
+  EXPECT_EQ(device->size(), 3);
+  auto readable = device->element("base_id:0");
+  EXPECT_EQ(readable->name(), "readable");
+  EXPECT_EQ(readable->type(), ElementType::Readable);
+  EXPECT_EQ(
+      get<ReadablePtr>(readable->function())->dataType(), DataType::Double);
+  auto writable = get<WritablePtr>(device->element("base_id:1")->function());
+  EXPECT_EQ(writable->read(), DataVariant(true));
+  EXPECT_EQ(device->element("base_id:2.0")->type(), ElementType::Observable);
+  auto callable = get<CallablePtr>(device->element("base_id:2.1")->function());
+  EXPECT_EQ(callable->resultType(), DataType::Integer);
+}
+
+TEST(MockBuilderTests, addElementsThrowsInvalidArgument) {
+  auto builder = make_shared<MockBuilder>();
+  EXPECT_THROW(builder->addElements("", {{}}), DeviceInfoNotSet);
+  builder->setDeviceInfo("base_id", BuildInfo{"device_name"});
+
+  EXPECT_THAT(
+      [&]() {
+        builder->addElements(
+            "", {{}, {ElementType::Group, BuildInfo{"group_name"}}});
+      },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("Groups can not be added in bulk")));
+  EXPECT_THAT(
+      [&]() {
+        builder->addElements("",
+            {{ElementType::Callable, BuildInfo{"callable"}, DataType::Boolean,
+                DataVariant(true)}});
+      },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("Callable elements do not support default values")));
+  EXPECT_THAT([&]() { builder->addElements("base_id:7", {{}}); },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("No parent group with ID base_id:7 exists")));
+  EXPECT_THROW(builder->result(), GroupEmpty);
+}
+
+TEST(MockBuilderTests, canAddLazyElements) {
+  auto builder = make_shared<MockBuilder>();
+  builder->enableLazyElements();
+  builder->setDeviceInfo("base_id", BuildInfo{"device_name"});
+  vector<MockBuilder::ElementDescriptor> descriptors(3,
+      {ElementType::Writable, BuildInfo{"writable"}, DataType::Boolean,
+          DataVariant(true)});
+  descriptors.push_back(
+      {ElementType::Readable, BuildInfo{"readable"}, DataType::Double});
+  auto root_ids = builder->addElements("", descriptors);
+  auto group_id = builder->addGroup(BuildInfo{"group_name"});
+  auto nested_ids = builder->addElements(group_id,
+      {{ElementType::Callable, BuildInfo{"callable"}, DataType::Integer}});
+  auto device = builder->result();
+
+  EXPECT_THAT(root_ids,
+      ElementsAre("base_id:0", "base_id:1", "base_id:2", "base_id:3"));
+  EXPECT_THAT(nested_ids, ElementsAre("base_id:4.0"));
+  EXPECT_EQ(device->size(), 5);
+  auto writable = device->element("base_id:1");
+  EXPECT_EQ(writable->id(), "base_id:1");
+  EXPECT_EQ(writable->name(), "writable");
+  EXPECT_EQ(get<WritablePtr>(writable->function())->read(), DataVariant(true));
+  auto readable = device->element("base_id:3");
+  EXPECT_EQ(readable->name(), "readable");
+  EXPECT_EQ(
+      get<ReadablePtr>(readable->function())->dataType(), DataType::Double);
+  auto callable = get<CallablePtr>(device->element("base_id:4.0")->function());
+  EXPECT_EQ(callable->resultType(), DataType::Integer);
+
+  size_t visited = 0;
+  device->visit([&visited](const ElementPtr&) { ++visited; });
+  EXPECT_EQ(visited, 5);
+}
+
+TEST(MockBuilderTests, materializesLazyElementsConcurrentlyInArena) {
+  constexpr size_t GROUP_COUNT = 4;
+  constexpr size_t ELEMENT_COUNT = 1000;
+  auto builder = make_shared<MockBuilder>();
+  builder->enableArena(256);
+  builder->enableLazyElements();
+  builder->setDeviceInfo("base_id", BuildInfo{"device_name"});
+  vector<vector<string>> ids;
+  for (size_t group = 0; group < GROUP_COUNT; ++group) {
+    auto group_id = builder->addGroup(BuildInfo{"group_name"});
+    ids.push_back(builder->addElements(group_id,
+        vector<MockBuilder::ElementDescriptor>(ELEMENT_COUNT,
+            {ElementType::Readable, BuildInfo{"readable"}, DataType::Double})));
+  }
+  auto device = builder->result();
+
+  // each thread materializes the elements of a different group, so only the
+  // arena is shared between them
+  vector<thread> readers;
+  for (const auto& group_ids : ids) {
+    readers.emplace_back([&device, &group_ids]() {
+      for (const auto& id : group_ids) {
+        EXPECT_EQ(device->element(id)->id(), id);
+      }
+    });
+  }
+  for (auto& reader : readers) {
+    reader.join();
+  }
+}
+
+TEST(MockBuilderTests, enableLazyElementsThrowsDeviceBuildInProgress) {
+  auto builder = make_shared<MockBuilder>();
+  builder->setDeviceInfo("base_id", BuildInfo{"device_name"});
+
+  EXPECT_THROW(builder->enableLazyElements(), DeviceBuildInProgress);
+}
+
+TEST(MockBuilderTests, canAddElementsWithLatency) {
+  auto builder = make_shared<MockBuilder>();
+  builder->setDeviceInfo("base_id", BuildInfo{"device_name"});
+  auto ids = builder->addElements("",
+      {{ElementType::Writable, BuildInfo{"writable"}, DataType::Boolean,
+           DataVariant(true), chrono::milliseconds(1)},
+          {ElementType::Observable, BuildInfo{"observable"}, DataType::Double,
+              nullopt, chrono::milliseconds(1)}});
+  auto device = builder->result();
+  auto writable = get<WritablePtr>(device->element(ids[0])->function());
+  auto observable = get<ObservablePtr>(device->element(ids[1])->function());
+
+  auto start = chrono::steady_clock::now();
+  EXPECT_EQ(writable->read(), DataVariant(true));
+  EXPECT_NO_THROW(writable->write(DataVariant(false)));
+  EXPECT_EQ(observable->read(), DataVariant(0.0));
+  EXPECT_EQ(observable->dataType(), DataType::Double);
+  EXPECT_GE(chrono::steady_clock::now() - start, chrono::milliseconds(3));
+  EXPECT_THAT(
+      [&]() {
+        builder->setDeviceInfo("other_id", BuildInfo{"device_name"});
+        builder->addElements("",
+            {{ElementType::Callable, BuildInfo{"callable"}, DataType::Boolean,
+                nullopt, chrono::milliseconds(1)}});
+      },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("Callable elements do not support latency")));
+}
 } // namespace Information_Model::testing
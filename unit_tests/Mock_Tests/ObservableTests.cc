@@ -3,6 +3,8 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+
 namespace Information_Model::testing {
 using namespace std;
 using namespace ::testing;
@@ -146,9 +148,35 @@ TEST_P(ObservableTests, canSubAndUnsub) {
         mock_exception_handler.AsStdFunction());
 
     connection.reset();
+  });
+}
 
-    // we must dispatch a notification for the mock to cleanup connections
-    tested->notify(true);
+TEST_P(ObservableTests, canResubscribe) {
+  MockFunction<void(const shared_ptr<DataVariant>&)> mock_observer_1_cb;
+  MockFunction<void(const shared_ptr<DataVariant>&)> mock_observer_2_cb;
+  MockFunction<void(const exception_ptr&)> mock_exception_handler;
+
+  EXPECT_CALL(mock_enable_observation, Call(false)).Times(Exactly(2));
+  EXPECT_CALL(mock_enable_observation, Call(true)).Times(Exactly(2));
+  EXPECT_CALL(*tested, subscribe).Times(Exactly(2));
+  EXPECT_CALL(mock_observer_1_cb, Call(_)).Times(Exactly(0));
+  EXPECT_CALL(mock_observer_2_cb, Call(_)).Times(Exactly(0));
+  EXPECT_CALL(mock_observer_2_cb, Call(Pointee(expected_variant)))
+      .Times(Exactly(1));
+  EXPECT_CALL(mock_exception_handler, Call(_)).Times(Exactly(0));
+
+  EXPECT_NO_THROW({
+    auto connection_1 = tested->subscribe(mock_observer_1_cb.AsStdFunction(),
+        mock_exception_handler.AsStdFunction());
+    connection_1.reset();
+
+    auto connection_2 = tested->subscribe(mock_observer_2_cb.AsStdFunction(),
+        mock_exception_handler.AsStdFunction());
+    tested->notify(expected_variant);
+    connection_2.reset();
+
+    // no observers are left, so nothing is dispatched
+    tested->notify(expected_variant);
   });
 }
 
@@ -156,6 +184,7 @@ TEST_P(ObservableTests, canNotifyOne) {
   MockFunction<void(const shared_ptr<DataVariant>&)> mock_observer_cb;
   MockFunction<void(const exception_ptr&)> mock_exception_handler;
 
+  EXPECT_CALL(mock_enable_observation, Call(false)).Times(Exactly(1));
   EXPECT_CALL(mock_enable_observation, Call(true)).Times(Exactly(1));
   EXPECT_CALL(*tested, subscribe).Times(Exactly(1));
   EXPECT_CALL(mock_observer_cb, Call(_)).Times(Exactly(0));
@@ -179,6 +208,7 @@ TEST_P(ObservableTests, canNotifyTwo) {
   MockFunction<void(const shared_ptr<DataVariant>&)> mock_observer_2_cb;
   MockFunction<void(const exception_ptr&)> mock_exception_handler;
 
+  EXPECT_CALL(mock_enable_observation, Call(false)).Times(Exactly(1));
   EXPECT_CALL(mock_enable_observation, Call(true)).Times(Exactly(1));
   EXPECT_CALL(*tested, subscribe).Times(Exactly(2));
   EXPECT_CALL(mock_observer_1_cb, Call(_)).Times(Exactly(0));
@@ -208,11 +238,117 @@ TEST_P(ObservableTests, canNotifyTwo) {
   });
 }
 
+TEST_P(ObservableTests, canNotifyByMove) {
+  MockFunction<void(const shared_ptr<DataVariant>&)> mock_observer_cb;
+  MockFunction<void(const exception_ptr&)> mock_exception_handler;
+
+  EXPECT_CALL(mock_enable_observation, Call(true)).Times(Exactly(1));
+  EXPECT_CALL(mock_enable_observation, Call(false)).Times(Exactly(1));
+  EXPECT_CALL(*tested, subscribe).Times(Exactly(1));
+  EXPECT_CALL(mock_observer_cb, Call(_)).Times(Exactly(0));
+  EXPECT_CALL(mock_observer_cb, Call(Pointee(expected_variant)))
+      .Times(Exactly(2));
+  EXPECT_CALL(mock_exception_handler, Call(_)).Times(Exactly(0));
+
+  EXPECT_NO_THROW({
+    auto connection = tested->subscribe(mock_observer_cb.AsStdFunction(),
+        mock_exception_handler.AsStdFunction());
+
+    auto value = expected_variant;
+    tested->notify(move(value));
+    tested->notify(DataVariant(expected_variant));
+  });
+}
+
+TEST_P(ObservableTests, tracksLatencies) {
+  MockFunction<void(const shared_ptr<DataVariant>&)> mock_observer_cb;
+  MockFunction<void(const exception_ptr&)> mock_exception_handler;
+
+  EXPECT_CALL(mock_enable_observation, Call(true)).Times(Exactly(1));
+  EXPECT_CALL(mock_enable_observation, Call(false)).Times(Exactly(1));
+  EXPECT_CALL(mock_observer_cb, Call(Pointee(expected_variant)))
+      .Times(Exactly(5));
+  EXPECT_CALL(mock_exception_handler, Call(_)).Times(Exactly(0));
+
+  EXPECT_NO_THROW({
+    auto untracked = tested->subscribe(mock_observer_cb.AsStdFunction(),
+        mock_exception_handler.AsStdFunction());
+    tested->notify(expected_variant);
+    EXPECT_THAT(tested->latencies(), IsEmpty());
+
+    tested->enableLatencyTracking(true);
+    auto tracked = tested->subscribe(mock_observer_cb.AsStdFunction(),
+        mock_exception_handler.AsStdFunction());
+    tested->notify(expected_variant);
+    tested->enableLatencyTracking(false);
+    tested->notify(expected_variant);
+
+    auto latencies = tested->latencies();
+    ASSERT_EQ(latencies.size(), 2);
+    for (const auto& latency : latencies) {
+      EXPECT_EQ(latency.notify_to_dispatch.count(), 1);
+      EXPECT_EQ(latency.dispatch_to_return.count(), 1);
+    }
+  });
+}
+
+TEST_P(ObservableTests, mergesLatenciesOfReleasedObservers) {
+  constexpr size_t RELEASED_COUNT = 1000;
+  EXPECT_CALL(mock_enable_observation, Call(_)).Times(Exactly(2));
+
+  tested->enableLatencyTracking(true);
+  auto kept = tested->subscribe(
+      [](const shared_ptr<DataVariant>&) {}, [](const exception_ptr&) {});
+  for (size_t i = 0; i < RELEASED_COUNT; ++i) {
+    auto released = tested->subscribe(
+        [](const shared_ptr<DataVariant>&) {}, [](const exception_ptr&) {});
+    tested->notify(expected_variant);
+  }
+
+  auto latencies = tested->latencies();
+  EXPECT_LE(latencies.size(), 258);
+  ASSERT_FALSE(latencies.empty());
+  EXPECT_EQ(latencies[0].notify_to_dispatch.count(), RELEASED_COUNT);
+  size_t released_count = 0;
+  for (size_t i = 1; i < latencies.size(); ++i) {
+    released_count += latencies[i].notify_to_dispatch.count();
+  }
+  EXPECT_EQ(released_count, RELEASED_COUNT);
+}
+
+TEST_P(ObservableTests, reusesReleasedPayloads) {
+  vector<const DataVariant*> received;
+  shared_ptr<DataVariant> retained;
+
+  EXPECT_CALL(mock_enable_observation, Call(_)).Times(Exactly(2));
+
+  auto connection = tested->subscribe(
+      [&received, &retained](const shared_ptr<DataVariant>& value) {
+        received.push_back(value.get());
+        if (received.size() == 2) {
+          retained = value;
+        }
+      },
+      [](const exception_ptr&) {});
+
+  tested->notify(expected_variant);
+  tested->notify(otherThan(expected_variant));
+  tested->notify(expected_variant);
+
+  ASSERT_EQ(received.size(), 3);
+  // released payload buffers are reused for the next notification
+  EXPECT_EQ(received[0], received[1]);
+  // retained payload buffers are not overwritten
+  EXPECT_NE(received[1], received[2]);
+  EXPECT_EQ(*retained, otherThan(expected_variant));
+}
+
 TEST_P(ObservableTests, canHandleSharedExceptions) {
   MockFunction<void(const shared_ptr<DataVariant>&)> mock_observer_cb;
   MockFunction<void(const exception_ptr&)> mock_exception_handler;
   runtime_error test_exception{"Test thrown exceptions in shared handler"};
 
+  EXPECT_CALL(mock_enable_observation, Call(false)).Times(Exactly(1));
   EXPECT_CALL(mock_enable_observation, Call(true)).Times(Exactly(1));
   EXPECT_CALL(*tested, subscribe).Times(Exactly(1));
   EXPECT_CALL(mock_observer_cb, Call(_)).Times(Exactly(0));
@@ -241,6 +377,7 @@ TEST_P(ObservableTests, canHandleSeparateExceptions) {
   MockFunction<void(const exception_ptr&)> mock_exception_handler_2;
   runtime_error test_exception{"Test thrown exceptions in separate handler"};
 
+  EXPECT_CALL(mock_enable_observation, Call(false)).Times(Exactly(1));
   EXPECT_CALL(mock_enable_observation, Call(true)).Times(Exactly(1));
   EXPECT_CALL(*tested, subscribe).Times(Exactly(2));
   EXPECT_CALL(mock_observer_1_cb, Call(_)).Times(Exactly(0));
@@ -274,6 +411,157 @@ TEST_P(ObservableTests, canHandleSeparateExceptions) {
   });
 }
 
+TEST_P(ObservableTests, canDispatchInParallel) {
+  constexpr size_t OBSERVER_COUNT = 64;
+  runtime_error test_exception{"Test thrown exceptions in parallel dispatch"};
+  MockFunction<void(const exception_ptr&)> mock_exception_handler;
+  atomic<size_t> received = 0;
+
+  EXPECT_CALL(mock_enable_observation, Call(true)).Times(Exactly(1));
+  EXPECT_CALL(mock_enable_observation, Call(false)).Times(Exactly(1));
+  EXPECT_CALL(mock_exception_handler, Call(_)).Times(Exactly(0));
+  EXPECT_CALL(mock_exception_handler, Call(ExceptionPointee(test_exception)))
+      .Times(Exactly(OBSERVER_COUNT / 2));
+
+  tested->enableParallelDispatch(make_shared<WorkerPool>(4));
+  {
+    vector<ObserverPtr> connections;
+    for (size_t i = 0; i < OBSERVER_COUNT; ++i) {
+      connections.push_back(tested->subscribe(
+          [&, throws = i % 2 == 0](const shared_ptr<DataVariant>& value) {
+            EXPECT_EQ(*value, expected_variant);
+            received++;
+            if (throws) {
+              throw test_exception;
+            }
+          },
+          mock_exception_handler.AsStdFunction()));
+    }
+
+    EXPECT_NO_THROW(tested->notify(expected_variant));
+  }
+
+  EXPECT_EQ(received, OBSERVER_COUNT);
+}
+
+struct ObservableFilterTests : public Test {
+  ObserverPtr subscribe(const NotificationFilter& filter) {
+    return tested->subscribe(
+        [this](const shared_ptr<DataVariant>& value) {
+          received.push_back(*value);
+        },
+        [](const exception_ptr&) {},
+        filter);
+  }
+
+  void notifyAll(const vector<DataVariant>& values) {
+    for (const auto& value : values) {
+      tested->notify(value);
+    }
+  }
+
+  ObservableMockPtr tested =
+      make_shared<NiceMock<ObservableMock>>(DataType::Double);
+  vector<DataVariant> received;
+};
+
+TEST_F(ObservableFilterTests, dispatchesEverythingWithoutConditions) {
+  auto observer = subscribe(NotificationFilter{});
+
+  notifyAll({1.0, 1.0, 1.0});
+
+  EXPECT_EQ(received.size(), 3);
+}
+
+TEST_F(ObservableFilterTests, dispatchesOnChange) {
+  NotificationFilter filter;
+  filter.on_change = true;
+  auto observer = subscribe(filter);
+
+  notifyAll({1.0, 1.0, 2.0, 2.0, 1.0});
+
+  EXPECT_THAT(received,
+      ElementsAre(DataVariant(1.0), DataVariant(2.0), DataVariant(1.0)));
+}
+
+TEST_F(ObservableFilterTests, dispatchesOutsideAbsoluteDeadband) {
+  NotificationFilter filter;
+  filter.absolute_deadband = 1.0;
+  auto observer = subscribe(filter);
+
+  notifyAll({0.0, 0.5, 1.0, 1.5, 0.6, -2.0});
+
+  EXPECT_THAT(received,
+      ElementsAre(DataVariant(0.0), DataVariant(1.5), DataVariant(-2.0)));
+}
+
+TEST_F(ObservableFilterTests, dispatchesOutsidePercentDeadband) {
+  NotificationFilter filter;
+  filter.percent_deadband = 10.0;
+  auto observer = subscribe(filter);
+
+  notifyAll({100.0, 109.0, 111.0, 100.0, 99.0});
+
+  EXPECT_THAT(received,
+      ElementsAre(DataVariant(100.0), DataVariant(111.0), DataVariant(99.0)));
+}
+
+TEST_F(ObservableFilterTests, dispatchesAfterMinInterval) {
+  NotificationFilter filter;
+  filter.min_interval = chrono::hours(1);
+  auto observer = subscribe(filter);
+
+  notifyAll({1.0, 2.0, 3.0});
+
+  EXPECT_THAT(received, ElementsAre(DataVariant(1.0)));
+}
+
+TEST_F(ObservableFilterTests, filtersEachObserverSeparately) {
+  NotificationFilter filter;
+  filter.on_change = true;
+  auto filtered = subscribe(filter);
+  auto unfiltered = subscribe(NotificationFilter{});
+
+  notifyAll({1.0, 1.0});
+
+  EXPECT_EQ(received.size(), 3);
+}
+
+TEST_F(ObservableFilterTests, throwsOnInvalidFilter) {
+  NotificationFilter negative_deadband;
+  negative_deadband.absolute_deadband = -1.0;
+  NotificationFilter negative_interval;
+  negative_interval.min_interval = chrono::nanoseconds(-1);
+  NotificationFilter non_numeric;
+  non_numeric.percent_deadband = 1.0;
+
+  EXPECT_THAT([&]() { subscribe(negative_deadband); },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("Deadband can not be negative")));
+  EXPECT_THAT([&]() { subscribe(negative_interval); },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("Minimum interval can not be negative")));
+
+  tested->updateType(DataType::String);
+  EXPECT_THAT([&]() { subscribe(non_numeric); },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("Deadband can not be used for String data type")));
+}
+
+TEST_F(ObservableFilterTests, defaultConstructedChecksDeadband) {
+  tested = make_shared<NiceMock<ObservableMock>>();
+  tested->updateValue(DataVariant(0.0));
+  NotificationFilter filter;
+  filter.absolute_deadband = 1.0;
+  auto observer = subscribe(filter);
+
+  notifyAll({0.5, 1.5});
+
+  EXPECT_EQ(tested->dataType(), DataType::Double);
+  EXPECT_EQ(tested->read(), DataVariant(0.0));
+  EXPECT_THAT(received, ElementsAre(DataVariant(0.5)));
+}
+
 // NOLINTBEGIN(readability-magic-numbers)
 INSTANTIATE_TEST_SUITE_P(ObservableTestsValues,
     ObservableTests,
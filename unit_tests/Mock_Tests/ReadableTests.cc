@@ -1,3 +1,4 @@
+#include "AllocationCounter.hpp"
 #include "ReadableMock.hpp"
 #include "TestResources.hpp"
 
@@ -136,4 +137,20 @@ INSTANTIATE_TEST_SUITE_P(ReadableTestsValues,
       return name + toSanitizedString(info.param.readResult());
     });
 // NOLINTEND(readability-magic-numbers)
+
+TEST(ReadableMockTests, updatesWithoutGrowing) {
+  constexpr intmax_t UPDATE_COUNT = 10000000;
+  auto tested = make_shared<NiceMock<ReadableMock>>(DataType::Integer);
+
+  AllocationCounter counter;
+  for (intmax_t value = 0; value < UPDATE_COUNT; ++value) {
+    tested->updateValue(DataVariant(value));
+    tested->updateType(DataType::Integer);
+  }
+
+  // trivially copyable values are published in place, without snapshots
+  EXPECT_EQ(counter.allocations(), 0);
+  EXPECT_EQ(tested->read(), DataVariant(UPDATE_COUNT - 1));
+  EXPECT_EQ(tested->dataType(), DataType::Integer);
+}
 } // namespace Information_Model::testing
\ No newline at end of file
@@ -0,0 +1,231 @@
+#include "DeviceMock.hpp"
+#include "ElementMock.hpp"
+#include "TraceReplayer.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <thread>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+struct TraceReplayerTests : public Test {
+  TraceReplayerTests() {
+    temperature_id = addObservable(DataType::Double);
+    state_id = addObservable(DataType::String);
+    readable_id = device->generateID();
+    device->addElement(make_shared<NiceMock<ElementMock>>(
+        make_shared<NiceMock<ReadableMock>>(DataType::Boolean), readable_id));
+  }
+
+  ~TraceReplayerTests() override { filesystem::remove(trace_path); }
+
+  string addObservable(DataType type) {
+    auto observable = make_shared<NiceMock<ObservableMock>>(type);
+    auto id = device->generateID();
+    device->addElement(make_shared<NiceMock<ElementMock>>(observable, id));
+    observable->enableSubscribeFaking([](bool) {});
+    observers.push_back(observable->subscribe(
+        [this, id](const shared_ptr<DataVariant>& value) {
+          received.emplace_back(id, *value);
+        },
+        [](const exception_ptr&) {}));
+    return id;
+  }
+
+  void writeCSV(const string& content) {
+    ofstream trace(trace_path, ios::trunc);
+    trace << content;
+  }
+
+  TraceReplayer::ColumnMapping mapping() const {
+    return {{"temperature", temperature_id}, {"state", state_id}};
+  }
+
+  TraceReplayer::ColumnMapping temperatureMapping() const {
+    return {{"temperature", temperature_id}};
+  }
+
+  string trace_path =
+      (filesystem::temp_directory_path() /
+          ("trace_" + to_string(reinterpret_cast<uintptr_t>(this)) + ".trace"))
+          .string();
+  DeviceMockPtr device = make_shared<NiceMock<DeviceMock>>("device");
+  string temperature_id;
+  string state_id;
+  string readable_id;
+  vector<ObserverPtr> observers;
+  vector<pair<string, DataVariant>> received;
+};
+
+TEST_F(TraceReplayerTests, replaysCSVTrace) {
+  writeCSV("time,temperature,unmapped,state\n"
+           "0,21.5,1,idle\n"
+           "10,,2,\"busy, \"\"really\"\"\"\r\n"
+           "\n"
+           "20,22.25,3,\n");
+  TraceReplayer tested(trace_path, *device, mapping());
+
+  auto report = tested.replay(TraceReplayer::MAX_SPEED);
+
+  EXPECT_EQ(report.dispatched, 4);
+  EXPECT_EQ(report.skipped, 3);
+  EXPECT_EQ(report.lag.count(), 0);
+  EXPECT_THAT(received,
+      ElementsAre(Pair(temperature_id, DataVariant(21.5)),
+          Pair(state_id, DataVariant(string("idle"))),
+          Pair(state_id, DataVariant(string("busy, \"really\""))),
+          Pair(temperature_id, DataVariant(22.25))));
+}
+
+TEST_F(TraceReplayerTests, replaysBinaryTrace) {
+  {
+    BinaryTraceWriter writer(trace_path, {"state", "unmapped", "temperature"});
+    writer.write(chrono::nanoseconds(0), 0, DataVariant(string("idle")));
+    writer.write(chrono::nanoseconds(5), 1, DataVariant(vector<uint8_t>{1, 2}));
+    writer.write(chrono::nanoseconds(10), 2, DataVariant(-4.5));
+  }
+  TraceReplayer tested(trace_path, *device, mapping());
+
+  auto report = tested.replay(TraceReplayer::MAX_SPEED);
+
+  EXPECT_EQ(report.dispatched, 2);
+  EXPECT_EQ(report.skipped, 1);
+  EXPECT_THAT(received,
+      ElementsAre(Pair(state_id, DataVariant(string("idle"))),
+          Pair(temperature_id, DataVariant(-4.5))));
+}
+
+TEST_F(TraceReplayerTests, canReplayTwice) {
+  writeCSV("time,temperature\n0,1.0\n1,2.0\n");
+  TraceReplayer tested(trace_path, *device, temperatureMapping());
+
+  EXPECT_EQ(tested.replay(TraceReplayer::MAX_SPEED).dispatched, 2);
+  EXPECT_EQ(tested.replay(TraceReplayer::MAX_SPEED).dispatched, 2);
+  EXPECT_EQ(received.size(), 4);
+}
+
+TEST_F(TraceReplayerTests, replaysToObservableFakes) {
+  auto observable = make_shared<ObservableFake>(DataType::Integer);
+  auto fake_id = device->generateID();
+  device->addElement(make_shared<NiceMock<ElementMock>>(observable, fake_id));
+  observable->enableSubscribeFaking([](bool) {});
+  observers.push_back(observable->subscribe(
+      [this, fake_id](const shared_ptr<DataVariant>& value) {
+        received.emplace_back(fake_id, *value);
+      },
+      [](const exception_ptr&) {}));
+  writeCSV("time,counter,temperature\n0,-3,1.0\n1,4,\n");
+  TraceReplayer tested(trace_path,
+      *device,
+      {{"counter", fake_id}, {"temperature", temperature_id}});
+
+  EXPECT_EQ(tested.replay(TraceReplayer::MAX_SPEED).dispatched, 3);
+  EXPECT_THAT(received,
+      ElementsAre(Pair(fake_id, DataVariant(intmax_t{-3})),
+          Pair(temperature_id, DataVariant(1.0)),
+          Pair(fake_id, DataVariant(intmax_t{4}))));
+}
+
+TEST_F(TraceReplayerTests, keepsOriginalPace) {
+  writeCSV("time,temperature\n0,1.0\n20000000,2.0\n");
+  TraceReplayer tested(trace_path, *device, temperatureMapping());
+
+  auto original = tested.replay(1.0);
+  auto scaled = tested.replay(10.0);
+
+  EXPECT_GE(original.duration, chrono::milliseconds(20));
+  EXPECT_GE(scaled.duration, chrono::milliseconds(2));
+  EXPECT_LT(scaled.duration, original.duration);
+  EXPECT_EQ(original.lag.count(), 2);
+}
+
+TEST_F(TraceReplayerTests, canStop) {
+  writeCSV("time,temperature\n0,1.0\n3600000000000,2.0\n");
+  TraceReplayer tested(trace_path, *device, temperatureMapping());
+
+  thread stopper([&tested]() {
+    this_thread::sleep_for(chrono::milliseconds(10));
+    tested.stop();
+  });
+  auto report = tested.replay(1.0);
+  stopper.join();
+
+  EXPECT_EQ(report.dispatched, 1);
+}
+
+TEST_F(TraceReplayerTests, stopsReplayStartedAfterStop) {
+  writeCSV("time,temperature\n0,1.0\n3600000000000,2.0\n");
+  TraceReplayer tested(trace_path, *device, temperatureMapping());
+
+  tested.stop();
+  auto stopped = tested.replay(1.0);
+  auto replayed = tested.replay(TraceReplayer::MAX_SPEED);
+
+  EXPECT_EQ(stopped.dispatched, 0);
+  EXPECT_EQ(replayed.dispatched, 2);
+}
+
+TEST_F(TraceReplayerTests, throwsOnInvalidMapping) {
+  writeCSV("time,temperature\n0,1.0\n");
+
+  EXPECT_THAT(
+      [&]() {
+        TraceReplayer(trace_path, *device, {{"missing", temperature_id}});
+      },
+      ThrowsMessage<invalid_argument>(HasSubstr("Column missing does not")));
+  EXPECT_THAT(
+      [&]() {
+        TraceReplayer(trace_path, *device, {{"temperature", readable_id}});
+      },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("is not an ObservableMock or ObservableFake")));
+  EXPECT_THAT(
+      [&]() {
+        TraceReplayer("/nonexistent/trace.csv", *device, mapping());
+      },
+      ThrowsMessage<invalid_argument>(HasSubstr("Could not open trace file")));
+}
+
+TEST_F(TraceReplayerTests, throwsOnMalformedTrace) {
+  writeCSV("time,temperature\n10,1.0\n5,2.0\n");
+  TraceReplayer decreasing(trace_path, *device, temperatureMapping());
+
+  EXPECT_THAT([&]() { decreasing.replay(TraceReplayer::MAX_SPEED); },
+      ThrowsMessage<MalformedTrace>(
+          HasSubstr("Timestamps must not decrease")));
+
+  writeCSV("time,temperature\n0,warm\n");
+  TraceReplayer invalid_value(
+      trace_path, *device, temperatureMapping());
+
+  EXPECT_THAT([&]() { invalid_value.replay(TraceReplayer::MAX_SPEED); },
+      ThrowsMessage<MalformedTrace>(HasSubstr("Invalid number warm")));
+
+  {
+    ofstream trace(trace_path, ios::binary | ios::trunc);
+    auto column_count = numeric_limits<uint32_t>::max();
+    trace << "STAGTRC1";
+    trace.write(
+        reinterpret_cast<const char*>(&column_count), sizeof(column_count));
+  }
+  EXPECT_THAT(
+      [&]() { TraceReplayer(trace_path, *device, temperatureMapping()); },
+      ThrowsMessage<MalformedTrace>(
+          HasSubstr("Trace declares 4294967295 columns")));
+}
+
+TEST_F(TraceReplayerTests, throwsOnInvalidSpeed) {
+  writeCSV("time,temperature\n0,1.0\n");
+  TraceReplayer tested(trace_path, *device, temperatureMapping());
+
+  EXPECT_THAT([&]() { tested.replay(0); },
+      ThrowsMessage<invalid_argument>(
+          HasSubstr("Replay speed must be positive")));
+}
+} // namespace Information_Model::testing
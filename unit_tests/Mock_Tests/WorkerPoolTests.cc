@@ -0,0 +1,75 @@
+#include "WorkerPool.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+struct WorkerPoolTests : public TestWithParam<size_t> {
+  WorkerPool tested{GetParam()};
+};
+
+TEST_P(WorkerPoolTests, hasWorkers) { EXPECT_EQ(tested.size(), GetParam()); }
+
+TEST_P(WorkerPoolTests, doesNothingForEmptyRange) {
+  EXPECT_NO_THROW(tested.parallelFor(
+      0, [](size_t) { FAIL() << "Task called for an empty range"; }));
+}
+
+TEST_P(WorkerPoolTests, callsEachIndexOnce) {
+  constexpr size_t COUNT = 10000;
+  vector<atomic<size_t>> calls(COUNT);
+
+  tested.parallelFor(COUNT, [&calls](size_t i) { calls[i]++; });
+
+  for (size_t i = 0; i < COUNT; ++i) {
+    EXPECT_EQ(calls[i], 1) << "Index " << i << " called " << calls[i]
+                           << " times";
+  }
+}
+
+TEST_P(WorkerPoolTests, canNestParallelFor) {
+  constexpr size_t OUTER = 16;
+  constexpr size_t INNER = 100;
+  atomic<size_t> calls = 0;
+
+  tested.parallelFor(OUTER, [this, &calls](size_t) {
+    tested.parallelFor(INNER, [&calls](size_t) { calls++; });
+  });
+
+  EXPECT_EQ(calls, OUTER * INNER);
+}
+
+TEST_P(WorkerPoolTests, rethrowsTaskExceptions) {
+  static constexpr size_t COUNT = 100;
+  atomic<size_t> calls = 0;
+
+  EXPECT_THAT(
+      [&]() {
+        tested.parallelFor(COUNT, [&calls](size_t i) {
+          calls++;
+          if (i == COUNT / 2) {
+            throw runtime_error("Task failed");
+          }
+        });
+      },
+      ThrowsMessage<runtime_error>(HasSubstr("Task failed")));
+  EXPECT_GT(calls, 0);
+}
+
+// NOLINTBEGIN(readability-magic-numbers)
+INSTANTIATE_TEST_SUITE_P(WorkerPoolTestsValues,
+    WorkerPoolTests,
+    Values(0, 1, 2, 4, 8),
+    [](const TestParamInfo<WorkerPoolTests::ParamType>& info) {
+      return to_string(info.param) + "Workers";
+    });
+// NOLINTEND(readability-magic-numbers)
+} // namespace Information_Model::testing